@@ -35,8 +35,10 @@
 // Needed for checking for B-spline for faster implementation
 #include "itkAdvancedBSplineDeformableTransform.h"
 #include "itkAdvancedCombinationTransform.h"
+#include "itkStackTransform.h"
 
 #include "itkMultiThreader.h"
+#include "itkCommand.h"
 
 namespace itk
 {
@@ -167,6 +169,10 @@ public:
   typedef typename BSplineOrder1TransformType::Pointer                             BSplineOrder1TransformPointer;
   typedef typename BSplineOrder2TransformType::Pointer                             BSplineOrder2TransformPointer;
   typedef typename BSplineOrder3TransformType::Pointer                             BSplineOrder3TransformPointer;
+  typedef AdvancedBSplineDeformableTransformBase< ScalarType, FixedImageDimension > BSplineTransformBaseType;
+
+  /** Typedef for the stack transform, used by the groupwise metrics. */
+  typedef StackTransform< ScalarType, FixedImageDimension, MovingImageDimension > StackTransformType;
 
   /** Hessian type; for SelfHessian (experimental feature) */
   typedef typename DerivativeType::ValueType    HessianValueType;
@@ -358,6 +364,16 @@ protected:
   typename AdvancedTransformType::Pointer m_AdvancedTransform;
   mutable bool m_TransformIsBSpline;
 
+  /** The image sampler, and the modified time of its sample container, for
+   * which the B-spline weights were cached, see UpdateTransformWeightsCache().
+   * The sampler is observed, so that the key is reset when it is deleted.
+   */
+  typedef MemberCommand< Self > WeightsCacheSamplerCommandType;
+  mutable const ImageSamplerType *                 m_WeightsCacheSampler;
+  mutable unsigned long                            m_WeightsCacheSamplesMTime;
+  mutable unsigned long                            m_WeightsCacheSamplerObserverTag;
+  typename WeightsCacheSamplerCommandType::Pointer m_WeightsCacheSamplerCommand;
+
   /** Variables for the Limiters. */
   FixedImageLimiterPointer     m_FixedImageLimiter;
   MovingImageLimiterPointer    m_MovingImageLimiter;
@@ -513,6 +529,23 @@ protected:
   /** Check if the transform is a B-spline. Called by Initialize. */
   virtual void CheckForBSplineTransform( void ) const;
 
+  /** Let a B-spline transform precompute its interpolation weights at the
+   * fixed image samples, when the image sampler samples on a fixed grid.
+   * The weights are keyed on the sampler and its sample container, and only
+   * recomputed when either changed. For a sampler without a fixed grid the
+   * transform stops using the cache, but keeps the weights while the grid
+   * sampler exists, so that ASGD can alternate between the two samplers
+   * during its parameter estimation. Once the grid sampler is deleted, the
+   * weights are released. Called by BeforeThreadedGetValueAndDerivative.
+   */
+  virtual void UpdateTransformWeightsCache( void ) const;
+
+  /** Make sampler the key of the weights cache, observing its deletion. */
+  void SetWeightsCacheSampler( const ImageSamplerType * sampler ) const;
+
+  /** Called when the sampler of the weights cache is deleted. */
+  void WeightsCacheSamplerDeleted( const Object * caller, const EventObject & event );
+
   /** Transform a point from FixedImage domain to MovingImage domain.
    * This function also checks if mapped point is within support region of
    * the transform. It returns true if so, and false otherwise.
@@ -521,6 +554,16 @@ protected:
     const FixedImagePointType & fixedImagePoint,
     MovingImagePointType & mappedPoint ) const;
 
+  /** Transform a number of points from FixedImage domain to MovingImage domain.
+   * Equivalent to calling TransformPoint() for each point, but a stack
+   * transform (without initial transform) gets all points at once, so that
+   * it can share the work between sub transforms. Used by the groupwise
+   * metrics, which map each sample to all positions along the last dimension.
+   */
+  virtual bool TransformPoints(
+    const std::vector< FixedImagePointType > & fixedImagePoints,
+    std::vector< MovingImagePointType > & mappedPoints ) const;
+
   /** This function returns a reference to the transform Jacobians.
    * This is either a reference to the full TransformJacobian or
    * a reference to a sparse Jacobians.
@@ -65,6 +65,9 @@ AdvancedImageToImageMetric< TFixedImage, TMovingImage >
   this->m_AdvancedTransform                                = 0;
   this->m_TransformIsAdvanced                              = false;
   this->m_TransformIsBSpline                               = false;
+  this->m_WeightsCacheSampler                              = NULL;
+  this->m_WeightsCacheSamplesMTime                         = 0;
+  this->m_WeightsCacheSamplerObserverTag                   = 0;
   this->m_UseMovingImageDerivativeScales                   = false;
   this->m_ScaleGradientWithRespectToMovingImageOrientation = false;
   this->m_MovingImageDerivativeScales.Fill( 1.0 );
@@ -109,6 +112,11 @@ AdvancedImageToImageMetric< TFixedImage, TMovingImage >
   this->m_GetValueAndDerivativePerThreadVariables     = NULL;
   this->m_GetValueAndDerivativePerThreadVariablesSize = 0;
 
+  /** Observe the deletion of the sampler of the weights cache. */
+  this->m_WeightsCacheSamplerCommand = WeightsCacheSamplerCommandType::New();
+  this->m_WeightsCacheSamplerCommand->SetCallbackFunction(
+    this, &Self::WeightsCacheSamplerDeleted );
+
 } // end Constructor
 
 
@@ -122,6 +130,7 @@ AdvancedImageToImageMetric< TFixedImage, TMovingImage >
 {
   delete[] this->m_GetValuePerThreadVariables;
   delete[] this->m_GetValueAndDerivativePerThreadVariables;
+  this->SetWeightsCacheSampler( NULL );
 } // end Destructor
 
 
@@ -169,6 +178,8 @@ AdvancedImageToImageMetric< TFixedImage, TMovingImage >
 
   /** Check if the transform is a B-spline transform. */
   this->CheckForBSplineTransform();
+  this->SetWeightsCacheSampler( NULL );
+  this->m_WeightsCacheSamplesMTime = 0;
 
   /** Initialize some threading related parameters. */
   if( this->m_UseMultiThread )
@@ -572,6 +583,132 @@ AdvancedImageToImageMetric< TFixedImage, TMovingImage >
 } // end CheckForBSplineTransform()
 
 
+/**
+ * ****************** UpdateTransformWeightsCache **********************
+ */
+
+template< class TFixedImage, class TMovingImage >
+void
+AdvancedImageToImageMetric< TFixedImage, TMovingImage >
+::UpdateTransformWeightsCache( void ) const
+{
+  if( !this->m_TransformIsBSpline || !this->m_UseImageSampler )
+  {
+    return;
+  }
+
+  /** Get the B-spline transform. When it is composed with an initial
+   * transform it is not evaluated at the fixed image samples.
+   */
+  BSplineTransformBaseType * bsplineTransform
+    = dynamic_cast< BSplineTransformBaseType * >( this->m_AdvancedTransform.GetPointer() );
+  CombinationTransformType * comboTransform
+    = dynamic_cast< CombinationTransformType * >( this->m_AdvancedTransform.GetPointer() );
+  if( comboTransform )
+  {
+    bsplineTransform = dynamic_cast< BSplineTransformBaseType * >(
+      comboTransform->GetCurrentTransform() );
+    if( bsplineTransform && comboTransform->GetInitialTransform()
+      && comboTransform->GetUseComposition() )
+    {
+      bsplineTransform->ClearWeightsCache();
+      this->SetWeightsCacheSampler( NULL );
+      return;
+    }
+  }
+  if( !bsplineTransform )
+  {
+    return;
+  }
+
+  /** Precompute the weights if the samples lie on a fixed grid, unless they
+   * were already computed for this sampler and its current samples.
+   */
+  const ImageSamplerType * sampler = this->GetImageSampler();
+  typename ImageSamplerType::InputImageRegionType sampleGridRegion;
+  typename ImageSamplerType::InputImageSizeType   sampleGridSpacing;
+  if( sampler->GetSampleGrid( sampleGridRegion, sampleGridSpacing ) )
+  {
+    const unsigned long samplesMTime = sampler->GetOutput()->GetMTime();
+    if( sampler != this->m_WeightsCacheSampler
+      || samplesMTime != this->m_WeightsCacheSamplesMTime )
+    {
+      bsplineTransform->PrecomputeWeightsOnSampleGrid(
+        this->GetFixedImage(), sampleGridRegion, sampleGridSpacing );
+      this->SetWeightsCacheSampler( sampler );
+      this->m_WeightsCacheSamplesMTime = samplesMTime;
+    }
+    bsplineTransform->SetUseWeightsCache( true );
+    return;
+  }
+
+  /** Samplers without a fixed grid, such as the random sampler that ASGD
+   * alternates with a grid sampler while it estimates its parameters, would
+   * miss the cache for every sample, so lookups are skipped. The weights are
+   * kept as long as the grid sampler they belong to exists; once it is
+   * deleted, for example after the estimation, they are released.
+   */
+  bsplineTransform->SetUseWeightsCache( false );
+  if( this->m_WeightsCacheSampler == NULL )
+  {
+    bsplineTransform->ClearWeightsCache();
+  }
+
+} // end UpdateTransformWeightsCache()
+
+
+/**
+ * ****************** SetWeightsCacheSampler **********************
+ */
+
+template< class TFixedImage, class TMovingImage >
+void
+AdvancedImageToImageMetric< TFixedImage, TMovingImage >
+::SetWeightsCacheSampler( const ImageSamplerType * sampler ) const
+{
+  if( sampler == this->m_WeightsCacheSampler )
+  {
+    return;
+  }
+
+  if( this->m_WeightsCacheSampler )
+  {
+    const_cast< ImageSamplerType * >( this->m_WeightsCacheSampler )
+      ->RemoveObserver( this->m_WeightsCacheSamplerObserverTag );
+  }
+
+  this->m_WeightsCacheSampler            = sampler;
+  this->m_WeightsCacheSamplesMTime       = 0;
+  this->m_WeightsCacheSamplerObserverTag = 0;
+  if( sampler )
+  {
+    this->m_WeightsCacheSamplerObserverTag = sampler->AddObserver(
+      DeleteEvent(), this->m_WeightsCacheSamplerCommand );
+  }
+
+} // end SetWeightsCacheSampler()
+
+
+/**
+ * ****************** WeightsCacheSamplerDeleted **********************
+ */
+
+template< class TFixedImage, class TMovingImage >
+void
+AdvancedImageToImageMetric< TFixedImage, TMovingImage >
+::WeightsCacheSamplerDeleted( const Object * caller, const EventObject & )
+{
+  /** The sampler is being deleted, so its observers need not be removed. */
+  if( caller == this->m_WeightsCacheSampler )
+  {
+    this->m_WeightsCacheSampler            = NULL;
+    this->m_WeightsCacheSamplesMTime       = 0;
+    this->m_WeightsCacheSamplerObserverTag = 0;
+  }
+
+} // end WeightsCacheSamplerDeleted()
+
+
 /**
  * ******************* EvaluateMovingImageValueAndDerivative ******************
  */
@@ -767,6 +904,47 @@ AdvancedImageToImageMetric< TFixedImage, TMovingImage >
 } // end TransformPoint()
 
 
+/**
+ * ********************** TransformPoints ************************
+ */
+
+template< class TFixedImage, class TMovingImage >
+bool
+AdvancedImageToImageMetric< TFixedImage, TMovingImage >
+::TransformPoints(
+  const std::vector< FixedImagePointType > & fixedImagePoints,
+  std::vector< MovingImagePointType > & mappedPoints ) const
+{
+  /** Find a stack transform, possibly wrapped in a combination transform. */
+  const StackTransformType * stackTransform
+    = dynamic_cast< const StackTransformType * >( this->m_AdvancedTransform.GetPointer() );
+  const CombinationTransformType * combinationTransform
+    = dynamic_cast< const CombinationTransformType * >( this->m_AdvancedTransform.GetPointer() );
+  if( stackTransform == 0 && combinationTransform != 0
+    && combinationTransform->GetInitialTransform() == 0 )
+  {
+    stackTransform = dynamic_cast< const StackTransformType * >(
+      combinationTransform->GetCurrentTransform() );
+  }
+
+  if( stackTransform != 0 )
+  {
+    stackTransform->TransformPoints( fixedImagePoints, mappedPoints );
+    return true;
+  }
+
+  /** Otherwise map the points one by one. */
+  bool valid = true;
+  mappedPoints.resize( fixedImagePoints.size() );
+  for( std::size_t i = 0; i < fixedImagePoints.size(); ++i )
+  {
+    valid &= this->TransformPoint( fixedImagePoints[ i ], mappedPoints[ i ] );
+  }
+  return valid;
+
+} // end TransformPoints()
+
+
 /**
  * *************** EvaluateTransformJacobian ****************
  */
@@ -854,6 +1032,9 @@ AdvancedImageToImageMetric< TFixedImage, TMovingImage >
     {
       this->GetImageSampler()->Update();
     }
+
+    /** Cache the B-spline weights at the samples, if possible. */
+    this->UpdateTransformWeightsCache();
   }
 
 } // end BeforeThreadedGetValueAndDerivative()
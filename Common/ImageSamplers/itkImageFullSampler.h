@@ -72,6 +72,7 @@ public:
   /** Other typdefs. */
   typedef typename InputImageType::IndexType InputImageIndexType;
   typedef typename InputImageType::PointType InputImagePointType;
+  typedef typename InputImageType::SizeType  InputImageSizeType;
 
   /** Selecting new samples makes no sense if nothing changed.
    * The same samples would be selected anyway.
@@ -89,6 +90,16 @@ public:
   }
 
 
+  /** All voxels of the cropped input image region are sampled. */
+  virtual bool GetSampleGrid( InputImageRegionType & sampleGridRegion,
+    InputImageSizeType & sampleGridSpacing ) const
+  {
+    sampleGridRegion = this->GetCroppedInputImageRegion();
+    sampleGridSpacing.Fill( 1 );
+    return true;
+  }
+
+
 protected:
 
   /** The constructor. */
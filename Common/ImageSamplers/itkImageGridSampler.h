@@ -131,6 +131,11 @@ public:
   }
 
 
+  /** The samples lie on a grid with spacing SampleGridSpacing. */
+  virtual bool GetSampleGrid( InputImageRegionType & sampleGridRegion,
+    InputImageSizeType & sampleGridSpacing ) const;
+
+
 protected:
 
   /** The constructor. */
@@ -151,6 +156,9 @@ protected:
   /** The number of samples entered in the SetNumberOfSamples method */
   unsigned long m_RequestedNumberOfSamples;
 
+  /** The grid of the last generated sample set. */
+  InputImageRegionType m_SampleGridRegion;
+
 private:
 
   /** The private constructor. */
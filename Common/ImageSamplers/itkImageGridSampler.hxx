@@ -57,6 +57,27 @@ ImageGridSampler< TInputImage >
 } // end SetSampleGridSpacing()
 
 
+/**
+ * ******************* GetSampleGrid *******************
+ */
+
+template< class TInputImage >
+bool
+ImageGridSampler< TInputImage >
+::GetSampleGrid( InputImageRegionType & sampleGridRegion,
+  InputImageSizeType & sampleGridSpacing ) const
+{
+  sampleGridRegion = this->m_SampleGridRegion;
+  for( unsigned int dim = 0; dim < InputImageDimension; dim++ )
+  {
+    sampleGridSpacing[ dim ] = static_cast< typename InputImageSizeType::SizeValueType >(
+      this->m_SampleGridSpacing[ dim ] );
+  }
+  return this->m_SampleGridRegion.GetNumberOfPixels() > 0;
+
+} // end GetSampleGrid()
+
+
 /**
  * ******************* GenerateData *******************
  */
@@ -104,6 +125,8 @@ ImageGridSampler< TInputImage >
     /** Update the number of samples on the grid. */
     numberOfSamplesOnGrid *= sampleGridSize[ dim ];
   }
+  this->m_SampleGridRegion.SetIndex( sampleGridIndex );
+  this->m_SampleGridRegion.SetSize( sampleGridSize );
 
   /** Prepare for looping over the grid. */
   unsigned int dim_z = 1;
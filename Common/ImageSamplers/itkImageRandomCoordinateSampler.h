@@ -22,6 +22,7 @@
 #include "itkInterpolateImageFunction.h"
 #include "itkBSplineInterpolateImageFunction.h"
 #include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkMultiThreader.h"
 
 namespace itk
 {
@@ -33,6 +34,14 @@ namespace itk
  * This image sampler generates not only samples that correspond with
  * pixel locations, but selects points in physical space.
  *
+ * When UsePrefetching is set, every Update() immediately starts generating
+ * the samples of the next Update() in a background thread. These are used
+ * if the only change in between is a call to SelectNewSamplesOnUpdate(),
+ * which is the case when new samples are selected every iteration. The sample
+ * generation then overlaps with the metric evaluation of the current
+ * iteration. The prefetching sampler draws from its own random generator,
+ * seeded from the global one.
+ *
  * \ingroup ImageSamplers
  */
 
@@ -105,14 +114,22 @@ public:
   itkGetConstMacro( UseRandomSampleRegion, bool );
   itkSetMacro( UseRandomSampleRegion, bool );
 
+  /** Set/Get whether the samples of the next Update() are generated in a
+   * background thread. Default: false. */
+  itkGetConstMacro( UsePrefetching, bool );
+  itkSetMacro( UsePrefetching, bool );
+
+  /** Set the Modified flag, while keeping prefetched samples valid. */
+  virtual bool SelectNewSamplesOnUpdate( void );
+
 protected:
 
   typedef typename InterpolatorType::ContinuousIndexType InputImageContinuousIndexType;
 
   /** The constructor. */
   ImageRandomCoordinateSampler();
-  /** The destructor. */
-  virtual ~ImageRandomCoordinateSampler() {}
+  /** The destructor; waits for a running prefetch thread. */
+  virtual ~ImageRandomCoordinateSampler();
 
   /** PrintSelf. */
   void PrintSelf( std::ostream & os, Indent indent ) const;
@@ -127,6 +144,19 @@ protected:
     const InputImageRegionType & inputRegionForThread,
     ThreadIdType threadId );
 
+  /** Fill the sample container with samples inside the bounding box,
+   * the input image buffer and the mask, if any. Not multi-threaded;
+   * used by GenerateData and by the prefetch thread.
+   */
+  virtual void GenerateSamples(
+    const InputImageType * inputImage,
+    InterpolatorType * interpolator,
+    const MaskType * mask,
+    const unsigned long numberOfSamples,
+    const InputImageContinuousIndexType & smallestContIndex,
+    const InputImageContinuousIndexType & largestContIndex,
+    ImageSampleContainerType * sampleContainer );
+
   /** Generate a point randomly in a bounding box. */
   virtual void GenerateRandomCoordinate(
     const InputImageContinuousIndexType & smallestContIndex,
@@ -157,6 +187,42 @@ private:
 
   bool m_UseRandomSampleRegion;
 
+  /** Prefetching. The prefetch thread only touches the members of
+   * m_Prefetch and the random generator, and holds its own references to
+   * the input image, interpolator and mask.
+   */
+  typedef MultiThreader::ThreadInfoStruct ThreadInfoType;
+  struct PrefetchType
+  {
+    InputImageConstPointer          InputImage;
+    InterpolatorPointer             Interpolator;
+    typename MaskType::ConstPointer Mask;
+    unsigned long                   NumberOfSamples;
+    InputImageContinuousIndexType   SmallestContIndex;
+    InputImageContinuousIndexType   LargestContIndex;
+    ImageSampleContainerPointer     SampleContainer;
+    bool                            Failed;
+  };
+
+  /** Start generating the next samples in the background. */
+  void StartPrefetch( void );
+
+  /** Wait for the prefetch thread, if it is running. */
+  void WaitForPrefetch( void );
+
+  /** The function that runs in the prefetch thread. */
+  static ITK_THREAD_RETURN_TYPE PrefetchThreaderCallback( void * arg );
+
+  bool                   m_UsePrefetching;
+  PrefetchType           m_Prefetch;
+  MultiThreader::Pointer m_PrefetchThreader;
+  ThreadIdType           m_PrefetchThreadId;
+  bool                   m_PrefetchRunning;
+  bool                   m_PrefetchAvailable;
+  unsigned long          m_PrefetchMTime;
+  unsigned long          m_PrefetchInputMTime;
+  RandomGeneratorPointer m_PrefetchRandomGenerator;
+
 };
 
 } // end namespace itk
@@ -44,9 +44,32 @@ ImageRandomCoordinateSampler< TInputImage >
   this->m_UseRandomSampleRegion = false;
   this->m_SampleRegionSize.Fill( 1.0 );
 
+  this->m_UsePrefetching     = false;
+  this->m_PrefetchThreader   = MultiThreader::New();
+  this->m_PrefetchThreadId   = 0;
+  this->m_PrefetchRunning    = false;
+  this->m_PrefetchAvailable  = false;
+  this->m_PrefetchMTime      = 0;
+  this->m_PrefetchInputMTime = 0;
+  this->m_Prefetch.NumberOfSamples = 0;
+  this->m_Prefetch.Failed          = false;
+
 } // end Constructor
 
 
+/**
+ * ******************* Destructor ********************
+ */
+
+template< class TInputImage >
+ImageRandomCoordinateSampler< TInputImage >
+::~ImageRandomCoordinateSampler()
+{
+  this->WaitForPrefetch();
+
+} // end Destructor
+
+
 /**
  * ******************* GenerateData *******************
  */
@@ -56,9 +79,12 @@ void
 ImageRandomCoordinateSampler< TInputImage >
 ::GenerateData( void )
 {
+  /** The previous prefetch, if any, must be finished before anything else. */
+  this->WaitForPrefetch();
+
   /** Get a handle to the mask. If there was no mask supplied we exercise a multi-threaded version. */
   typename MaskType::ConstPointer mask = this->GetMask();
-  if( mask.IsNull() && this->m_UseMultiThread )
+  if( mask.IsNull() && this->m_UseMultiThread && !this->m_UsePrefetching )
   {
     /** Calls ThreadedGenerateData(). */
     return Superclass::GenerateData();
@@ -69,6 +95,19 @@ ImageRandomCoordinateSampler< TInputImage >
   typename ImageSampleContainerType::Pointer sampleContainer = this->GetOutput();
   typename InterpolatorType::Pointer interpolator            = this->GetInterpolator();
 
+  /** Use the prefetched samples if nothing but the sample selection changed. */
+  if( this->m_UsePrefetching && this->m_PrefetchAvailable
+    && !this->m_Prefetch.Failed
+    && this->m_PrefetchMTime == this->GetMTime()
+    && this->m_PrefetchInputMTime == inputImage->GetMTime() )
+  {
+    sampleContainer->swap( *this->m_Prefetch.SampleContainer );
+    this->m_PrefetchAvailable = false;
+    this->StartPrefetch();
+    return;
+  }
+  this->m_PrefetchAvailable = false;
+
   /** Set up the interpolator. */
   interpolator->SetInputImage( inputImage ); // only once?
 
@@ -86,8 +125,43 @@ ImageRandomCoordinateSampler< TInputImage >
   this->GenerateSampleRegion( smallestImageContIndex, largestImageContIndex,
     smallestContIndex, largestContIndex );
 
+  /** Update the mask. */
+  if( mask.IsNotNull() && mask->GetSource() )
+  {
+    mask->GetSource()->Update();
+  }
+
+  /** Fill the sample container. */
+  this->GenerateSamples( inputImage, interpolator, mask,
+    this->GetNumberOfSamples(), smallestContIndex, largestContIndex,
+    sampleContainer );
+
+  if( this->m_UsePrefetching )
+  {
+    this->StartPrefetch();
+  }
+
+} // end GenerateData()
+
+
+/**
+ * ******************* GenerateSamples *******************
+ */
+
+template< class TInputImage >
+void
+ImageRandomCoordinateSampler< TInputImage >
+::GenerateSamples(
+  const InputImageType * inputImage,
+  InterpolatorType * interpolator,
+  const MaskType * mask,
+  const unsigned long numberOfSamples,
+  const InputImageContinuousIndexType & smallestContIndex,
+  const InputImageContinuousIndexType & largestContIndex,
+  ImageSampleContainerType * sampleContainer )
+{
   /** Reserve memory for the output. */
-  sampleContainer->Reserve( this->GetNumberOfSamples() );
+  sampleContainer->Reserve( numberOfSamples );
 
   /** Setup an iterator over the output, which is of ImageSampleContainerType. */
   typename ImageSampleContainerType::Iterator iter;
@@ -95,7 +169,7 @@ ImageRandomCoordinateSampler< TInputImage >
 
   InputImageContinuousIndexType sampleContIndex;
   /** Fill the sample container. */
-  if( mask.IsNull() )
+  if( mask == 0 )
   {
     /** Start looping over the sample container. */
     for( iter = sampleContainer->Begin(); iter != end; ++iter )
@@ -112,21 +186,16 @@ ImageRandomCoordinateSampler< TInputImage >
 
       /** Compute the value at the continuous index. */
       sampleValue = static_cast< ImageSampleValueType >(
-        this->m_Interpolator->EvaluateAtContinuousIndex( sampleContIndex ) );
+        interpolator->EvaluateAtContinuousIndex( sampleContIndex ) );
 
     } // end for loop
   } // end if no mask
   else
   {
-    /** Update the mask. */
-    if( mask->GetSource() )
-    {
-      mask->GetSource()->Update();
-    }
     /** Set up some variable that are used to make sure we are not forever
      * walking around on this image, trying to look for valid samples. */
     unsigned long numberOfSamplesTried        = 0;
-    unsigned long maximumNumberOfSamplesToTry = 10 * this->GetNumberOfSamples();
+    unsigned long maximumNumberOfSamplesToTry = 10 * numberOfSamples;
 
     /** Start looping over the sample container */
     for( iter = sampleContainer->Begin(); iter != end; ++iter )
@@ -161,12 +230,139 @@ ImageRandomCoordinateSampler< TInputImage >
 
       /** Compute the value at the point. */
       sampleValue = static_cast< ImageSampleValueType >(
-        this->m_Interpolator->EvaluateAtContinuousIndex( sampleContIndex ) );
+        interpolator->EvaluateAtContinuousIndex( sampleContIndex ) );
 
     } // end for loop
   } // end if mask
 
-} // end GenerateData()
+} // end GenerateSamples()
+
+
+/**
+ * ******************* SelectNewSamplesOnUpdate *******************
+ */
+
+template< class TInputImage >
+bool
+ImageRandomCoordinateSampler< TInputImage >
+::SelectNewSamplesOnUpdate( void )
+{
+  /** Only the sample selection changes, so prefetched samples remain valid. */
+  const bool prefetchUpToDate = this->m_PrefetchMTime == this->GetMTime();
+  this->Modified();
+  if( prefetchUpToDate )
+  {
+    this->m_PrefetchMTime = this->GetMTime();
+  }
+  return true;
+
+} // end SelectNewSamplesOnUpdate()
+
+
+/**
+ * ******************* StartPrefetch *******************
+ */
+
+template< class TInputImage >
+void
+ImageRandomCoordinateSampler< TInputImage >
+::StartPrefetch( void )
+{
+  /** The prefetch thread gets its own random generator, so that it
+   * does not interfere with other users of the global one.
+   */
+  if( this->m_PrefetchRandomGenerator.IsNull() )
+  {
+    this->m_PrefetchRandomGenerator = RandomGeneratorType::New();
+    this->m_PrefetchRandomGenerator->Initialize(
+      RandomGeneratorType::GetInstance()->GetIntegerVariate() );
+    this->m_RandomGenerator = this->m_PrefetchRandomGenerator;
+  }
+
+  /** Copy everything the prefetch thread needs. */
+  this->m_Prefetch.InputImage      = this->GetInput();
+  this->m_Prefetch.Interpolator    = this->GetInterpolator();
+  this->m_Prefetch.Mask            = this->GetMask();
+  this->m_Prefetch.NumberOfSamples = this->GetNumberOfSamples();
+  this->m_Prefetch.Failed          = false;
+  if( this->m_Prefetch.SampleContainer.IsNull() )
+  {
+    this->m_Prefetch.SampleContainer = ImageSampleContainerType::New();
+  }
+
+  /** The sample region is drawn here, since it uses the sampler settings. */
+  InputImageSizeType unitSize;
+  unitSize.Fill( 1 );
+  InputImageIndexType smallestIndex
+    = this->GetCroppedInputImageRegion().GetIndex();
+  InputImageIndexType largestIndex
+    = smallestIndex + this->GetCroppedInputImageRegion().GetSize() - unitSize;
+  InputImageContinuousIndexType smallestImageContIndex( smallestIndex );
+  InputImageContinuousIndexType largestImageContIndex( largestIndex );
+  this->GenerateSampleRegion( smallestImageContIndex, largestImageContIndex,
+    this->m_Prefetch.SmallestContIndex, this->m_Prefetch.LargestContIndex );
+
+  /** Remember the state for which the samples are generated. */
+  this->m_PrefetchMTime      = this->GetMTime();
+  this->m_PrefetchInputMTime = this->GetInput()->GetMTime();
+
+  this->m_PrefetchThreadId = this->m_PrefetchThreader->SpawnThread(
+    this->PrefetchThreaderCallback, this );
+  this->m_PrefetchRunning = true;
+
+} // end StartPrefetch()
+
+
+/**
+ * ******************* WaitForPrefetch *******************
+ */
+
+template< class TInputImage >
+void
+ImageRandomCoordinateSampler< TInputImage >
+::WaitForPrefetch( void )
+{
+  if( this->m_PrefetchRunning )
+  {
+    this->m_PrefetchThreader->TerminateThread( this->m_PrefetchThreadId );
+    this->m_PrefetchRunning   = false;
+    this->m_PrefetchAvailable = true;
+  }
+
+} // end WaitForPrefetch()
+
+
+/**
+ * ******************* PrefetchThreaderCallback *******************
+ */
+
+template< class TInputImage >
+ITK_THREAD_RETURN_TYPE
+ImageRandomCoordinateSampler< TInputImage >
+::PrefetchThreaderCallback( void * arg )
+{
+  ThreadInfoType * infoStruct = static_cast< ThreadInfoType * >( arg );
+  Self *           self       = static_cast< Self * >( infoStruct->UserData );
+  PrefetchType &   prefetch   = self->m_Prefetch;
+
+  /** Exceptions cannot cross the thread boundary; on failure, GenerateData
+   * generates the samples again and throws in the calling thread.
+   */
+  try
+  {
+    self->GenerateSamples( prefetch.InputImage, prefetch.Interpolator,
+      prefetch.Mask, prefetch.NumberOfSamples,
+      prefetch.SmallestContIndex, prefetch.LargestContIndex,
+      prefetch.SampleContainer );
+  }
+  catch( ExceptionObject & )
+  {
+    prefetch.Failed = true;
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+
+} // end PrefetchThreaderCallback()
 
 
 /**
@@ -164,6 +164,18 @@ public:
   /** Get a handle to the cropped InputImageregion. */
   itkGetConstReferenceMacro( CroppedInputImageRegion, InputImageRegionType );
 
+  /** Get the regular grid on which all samples lie, for samplers that
+   * sample on a fixed grid. The region holds the image index of the first
+   * sample and the number of samples per dimension, sampleGridSpacing the
+   * integer step between samples. Returns false if the samples are not
+   * restricted to a fixed grid. Only valid after calling Update().
+   */
+  virtual bool GetSampleGrid( InputImageRegionType &, InputImageSizeType & ) const
+  {
+    return false;
+  }
+
+
   /** Get the number of samples. */
   itkGetConstMacro( NumberOfSamples, unsigned long );
 
@@ -203,6 +203,13 @@ public:
   /** This method specifies the region over which the grid resides. */
   virtual void SetGridRegion( const RegionType & region );
 
+  /** Set the grid geometry. These methods invalidate the weights cache. */
+  virtual void SetGridSpacing( const SpacingType & spacing );
+
+  virtual void SetGridDirection( const DirectionType & direction );
+
+  virtual void SetGridOrigin( const OriginType & origin );
+
   /** Transform points by a B-spline deformable transformation. */
   OutputPointType TransformPoint( const InputPointType & point ) const;
 
@@ -241,6 +248,58 @@ public:
     ParameterIndexArrayType & indices,
     bool & inside ) const;
 
+  /** Compute the interpolation weights and the support region start index. */
+  virtual bool ComputeInterpolationWeights(
+    const InputPointType & ipp,
+    WeightsType & weights,
+    IndexType & supportIndex ) const;
+
+  /** Transform a point using precomputed interpolation weights. */
+  virtual OutputPointType TransformPointUsingWeights(
+    const InputPointType & ipp,
+    const WeightsType & weights,
+    const IndexType & supportIndex ) const;
+
+  /** Typedefs for the weights cache. */
+  typedef typename WeightsFunctionType::OneDWeightsType OneDWeightsType;
+  typedef typename Superclass::ImageBaseType            ImageBaseType;
+
+  /** Precompute the interpolation weights for all points of a regular
+   * sample grid. See the superclass for a description.
+   *
+   * Only the 1D weights are stored. When the axes of the sample grid are
+   * aligned with the axes of the B-spline grid, which is the case when the
+   * B-spline grid was defined on the fixed image, the 1D weights in each
+   * dimension only depend on the sample grid index in that dimension.
+   * The cache then only stores a table per dimension, which is negligible
+   * in size. Otherwise, the 1D weights are stored for every sample, as
+   * long as this fits in MaximumWeightsCacheSize bytes.
+   */
+  virtual void PrecomputeWeightsOnSampleGrid(
+    const ImageBaseType * image,
+    const RegionType & sampleGridRegion,
+    const SizeType & sampleGridSpacing );
+
+  /** Release the memory of the weights cache. */
+  virtual void ClearWeightsCache( void );
+
+  /** Get whether a weights cache is present, and whether it is stored as
+   * a separate table per dimension.
+   */
+  bool GetHasWeightsCache( void ) const
+  {
+    return !this->m_WeightsCache.empty();
+  }
+
+
+  itkGetConstMacro( WeightsCacheIsSeparable, bool );
+
+  /** Set/Get the maximum memory in bytes of a non-separable weights cache.
+   * Default: 256 MB.
+   */
+  itkSetMacro( MaximumWeightsCacheSize, SizeValueType );
+  itkGetConstMacro( MaximumWeightsCacheSize, SizeValueType );
+
   /** Get number of weights. */
   unsigned long GetNumberOfWeights( void ) const
   {
@@ -327,6 +386,31 @@ protected:
     NonZeroJacobianIndicesType & nonZeroJacobianIndices,
     const RegionType & supportRegion ) const;
 
+  /** Correlate the interpolation weights with the coefficients in the support
+   * region starting at supportIndex. Stores the displacement in displacement,
+   * and the parameter offsets of the support region in indices. Shared by
+   * TransformPoint() and TransformPointUsingWeights().
+   */
+  void ComputeDisplacementFromWeights(
+    const WeightsType & weights,
+    const IndexType & supportIndex,
+    ParameterIndexArrayType & indices,
+    OutputPointType & displacement ) const;
+
+  /** Look up the cached 1D weights and support region start index of a
+   * point. Returns false if the point is not on the cached sample grid.
+   * Otherwise, inside is set to whether the support region lies in the
+   * valid region, and the weights are only filled in when it does.
+   * The derivative weights are only filled in when requested; row i then
+   * contains the derivative of the 1D weights in dimension i.
+   */
+  bool LookupCachedWeights(
+    const InputPointType & ipp,
+    OneDWeightsType & weights1D,
+    OneDWeightsType * derivativeWeights1D,
+    IndexType & supportIndex,
+    bool & inside ) const;
+
   typedef typename Superclass::JacobianImageType JacobianImageType;
   typedef typename Superclass::JacobianPixelType JacobianPixelType;
 
@@ -338,6 +422,28 @@ protected:
   std::vector< DerivativeWeightsFunctionPointer >                  m_DerivativeWeightsFunctions;
   std::vector< std::vector< SODerivativeWeightsFunctionPointer > > m_SODerivativeWeightsFunctions;
 
+  /** An entry of the weights cache. In the separable representation an
+   * entry holds the values of a single dimension only.
+   */
+  struct CachedWeightsType
+  {
+    OneDWeightsType m_Weights1D;
+    OneDWeightsType m_DerivativeWeights1D;
+    IndexType       m_SupportIndex;
+    bool            m_Inside;
+  };
+
+  /** Member variables of the weights cache. */
+  typedef Matrix< double,
+    itkGetStaticConstMacro( SpaceDimension ),
+    itkGetStaticConstMacro( SpaceDimension ) >  SampleGridMatrixType;
+  std::vector< CachedWeightsType > m_WeightsCache;
+  bool                             m_WeightsCacheIsSeparable;
+  SizeType                         m_WeightsCacheGridSize;
+  InputPointType                   m_WeightsCacheGridOrigin;
+  SampleGridMatrixType             m_WeightsCachePointToIndex;
+  SizeValueType                    m_MaximumWeightsCacheSize;
+
 private:
 
   AdvancedBSplineDeformableTransform( const Self & ); // purposely not implemented
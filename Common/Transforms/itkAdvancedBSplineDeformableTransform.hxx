@@ -139,6 +139,13 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
   this->m_HasNonZeroSpatialHessian           = true;
   this->m_HasNonZeroJacobianOfSpatialHessian = true;
 
+  /** Weights cache. */
+  this->m_WeightsCacheIsSeparable = false;
+  this->m_WeightsCacheGridSize.Fill( 0 );
+  this->m_WeightsCacheGridOrigin.Fill( 0.0 );
+  this->m_WeightsCachePointToIndex.SetIdentity();
+  this->m_MaximumWeightsCacheSize = 256 * 1024 * 1024;
+
 } // end Constructor
 
 
@@ -159,6 +166,9 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
 
     this->m_GridRegion = region;
 
+    // the cached weights refer to the old grid
+    this->ClearWeightsCache();
+
     // set regions for each coefficient and Jacobian image
     for( unsigned int j = 0; j < SpaceDimension; j++ )
     {
@@ -218,6 +228,318 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
 }
 
 
+/**
+ * ********************* SetGridSpacing ****************************
+ */
+
+template< class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder >
+void
+AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
+::SetGridSpacing( const SpacingType & spacing )
+{
+  this->ClearWeightsCache();
+  this->Superclass::SetGridSpacing( spacing );
+} // end SetGridSpacing()
+
+
+/**
+ * ********************* SetGridDirection ****************************
+ */
+
+template< class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder >
+void
+AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
+::SetGridDirection( const DirectionType & direction )
+{
+  this->ClearWeightsCache();
+  this->Superclass::SetGridDirection( direction );
+} // end SetGridDirection()
+
+
+/**
+ * ********************* SetGridOrigin ****************************
+ */
+
+template< class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder >
+void
+AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
+::SetGridOrigin( const OriginType & origin )
+{
+  this->ClearWeightsCache();
+  this->Superclass::SetGridOrigin( origin );
+} // end SetGridOrigin()
+
+
+/**
+ * ********************* PrecomputeWeightsOnSampleGrid ****************************
+ */
+
+template< class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder >
+void
+AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
+::PrecomputeWeightsOnSampleGrid(
+  const ImageBaseType * image,
+  const RegionType & sampleGridRegion,
+  const SizeType & sampleGridSpacing )
+{
+  this->ClearWeightsCache();
+  if( image == NULL || sampleGridRegion.GetNumberOfPixels() == 0 )
+  {
+    return;
+  }
+
+  /** Compute the mapping between sample grid indices and physical points:
+   *   p = origin + indexToPoint * n.
+   */
+  SampleGridMatrixType indexToPoint;
+  for( unsigned int i = 0; i < SpaceDimension; ++i )
+  {
+    for( unsigned int j = 0; j < SpaceDimension; ++j )
+    {
+      indexToPoint[ i ][ j ] = image->GetDirection()[ i ][ j ]
+        * image->GetSpacing()[ j ] * static_cast< double >( sampleGridSpacing[ j ] );
+    }
+  }
+  InputPointType origin;
+  image->TransformIndexToPhysicalPoint( sampleGridRegion.GetIndex(), origin );
+  const SizeType gridSize = sampleGridRegion.GetSize();
+
+  /** The 1D weights in dimension i only depend on the sample grid index in
+   * dimension i, if the sample grid axes map onto the B-spline grid axes.
+   */
+  const SampleGridMatrixType sampleToGridIndex = this->m_PointToIndexMatrix * indexToPoint;
+  bool                       separable         = true;
+  for( unsigned int i = 0; i < SpaceDimension; ++i )
+  {
+    for( unsigned int j = 0; j < SpaceDimension; ++j )
+    {
+      if( i != j && vcl_abs( sampleToGridIndex[ i ][ j ] )
+        > 1e-6 * vcl_abs( sampleToGridIndex[ i ][ i ] ) )
+      {
+        separable = false;
+      }
+    }
+  }
+
+  /** Check the memory needed for the non-separable case. */
+  const SizeValueType numberOfSamples = sampleGridRegion.GetNumberOfPixels();
+  if( !separable
+    && numberOfSamples * sizeof( CachedWeightsType ) > this->m_MaximumWeightsCacheSize )
+  {
+    itkDebugMacro( << "Weights cache not created: it exceeds MaximumWeightsCacheSize" );
+    return;
+  }
+
+  /** Compute the cache entries. */
+  SizeValueType numberOfEntries = numberOfSamples;
+  if( separable )
+  {
+    numberOfEntries = 0;
+    for( unsigned int i = 0; i < SpaceDimension; ++i )
+    {
+      numberOfEntries += gridSize[ i ];
+    }
+  }
+  std::vector< CachedWeightsType > cache( numberOfEntries );
+
+  const int numberOfEntriesInt = static_cast< int >( numberOfEntries );
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for
+#endif
+  for( int e = 0; e < numberOfEntriesInt; ++e )
+  {
+    /** Get the sample grid index of this entry. In the separable case it
+     * is an index along a single axis.
+     */
+    SizeValueType gridIndex[ SpaceDimension ];
+    unsigned int  entryDimension = 0;
+    SizeValueType rest           = static_cast< SizeValueType >( e );
+    for( unsigned int i = 0; i < SpaceDimension; ++i )
+    {
+      gridIndex[ i ] = 0;
+    }
+    if( separable )
+    {
+      while( rest >= gridSize[ entryDimension ] )
+      {
+        rest -= gridSize[ entryDimension ];
+        ++entryDimension;
+      }
+      gridIndex[ entryDimension ] = rest;
+    }
+    else
+    {
+      for( unsigned int i = 0; i < SpaceDimension; ++i )
+      {
+        gridIndex[ i ] = rest % gridSize[ i ];
+        rest          /= gridSize[ i ];
+      }
+    }
+
+    /** Compute the physical point and the B-spline grid index. */
+    InputPointType point = origin;
+    for( unsigned int i = 0; i < SpaceDimension; ++i )
+    {
+      for( unsigned int j = 0; j < SpaceDimension; ++j )
+      {
+        point[ i ] += indexToPoint[ i ][ j ] * static_cast< double >( gridIndex[ j ] );
+      }
+    }
+    ContinuousIndexType cindex;
+    this->TransformPointToContinuousGridIndex( point, cindex );
+
+    /** Check which part of the valid region test is relevant. */
+    CachedWeightsType & entry = cache[ e ];
+    entry.m_Inside = true;
+    for( unsigned int i = 0; i < SpaceDimension; ++i )
+    {
+      if( ( !separable || i == entryDimension )
+        && ( cindex[ i ] < this->m_ValidRegionBegin[ i ]
+        || cindex[ i ] >= this->m_ValidRegionEnd[ i ] ) )
+      {
+        entry.m_Inside = false;
+      }
+    }
+    if( !entry.m_Inside )
+    {
+      continue;
+    }
+
+    /** Compute the 1D weights and derivative weights. */
+    OneDWeightsType derivativeWeights1D;
+    this->m_WeightsFunction->ComputeStartIndex( cindex, entry.m_SupportIndex );
+    this->m_WeightsFunction->Evaluate1DWeights( cindex, entry.m_SupportIndex, entry.m_Weights1D );
+    for( unsigned int i = 0; i < SpaceDimension; ++i )
+    {
+      this->m_DerivativeWeightsFunctions[ i ]->Evaluate1DWeights(
+        cindex, entry.m_SupportIndex, derivativeWeights1D );
+      for( unsigned int k = 0; k <= SplineOrder; ++k )
+      {
+        entry.m_DerivativeWeights1D[ i ][ k ] = derivativeWeights1D[ i ][ k ];
+      }
+    }
+  }
+
+  /** Store the cache. */
+  this->m_WeightsCache.swap( cache );
+  this->m_WeightsCacheIsSeparable = separable;
+  this->m_WeightsCacheGridSize    = gridSize;
+  this->m_WeightsCacheGridOrigin  = origin;
+  this->m_WeightsCachePointToIndex
+    = SampleGridMatrixType( indexToPoint.GetInverse() );
+
+} // end PrecomputeWeightsOnSampleGrid()
+
+
+/**
+ * ********************* ClearWeightsCache ****************************
+ */
+
+template< class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder >
+void
+AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
+::ClearWeightsCache( void )
+{
+  std::vector< CachedWeightsType >().swap( this->m_WeightsCache );
+  this->m_WeightsCacheIsSeparable = false;
+  this->m_WeightsCacheGridSize.Fill( 0 );
+
+} // end ClearWeightsCache()
+
+
+/**
+ * ********************* LookupCachedWeights ****************************
+ */
+
+template< class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder >
+bool
+AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
+::LookupCachedWeights(
+  const InputPointType & ipp,
+  OneDWeightsType & weights1D,
+  OneDWeightsType * derivativeWeights1D,
+  IndexType & supportIndex,
+  bool & inside ) const
+{
+  if( !this->m_UseWeightsCache || this->m_WeightsCache.empty() )
+  {
+    return false;
+  }
+
+  /** Compute the sample grid index; it should be integer. */
+  SizeValueType gridIndex[ SpaceDimension ];
+  for( unsigned int i = 0; i < SpaceDimension; ++i )
+  {
+    double cindex = 0.0;
+    for( unsigned int j = 0; j < SpaceDimension; ++j )
+    {
+      cindex += this->m_WeightsCachePointToIndex[ i ][ j ]
+        * ( ipp[ j ] - this->m_WeightsCacheGridOrigin[ j ] );
+    }
+    const double rounded = vcl_floor( cindex + 0.5 );
+    if( vcl_abs( cindex - rounded ) > 1e-6 || rounded < 0.0
+      || rounded >= static_cast< double >( this->m_WeightsCacheGridSize[ i ] ) )
+    {
+      return false;
+    }
+    gridIndex[ i ] = static_cast< SizeValueType >( rounded );
+  }
+
+  /** Copy the dense entry. */
+  if( !this->m_WeightsCacheIsSeparable )
+  {
+    SizeValueType offset = 0;
+    SizeValueType stride = 1;
+    for( unsigned int i = 0; i < SpaceDimension; ++i )
+    {
+      offset += gridIndex[ i ] * stride;
+      stride *= this->m_WeightsCacheGridSize[ i ];
+    }
+    const CachedWeightsType & entry = this->m_WeightsCache[ offset ];
+    inside = entry.m_Inside;
+    if( inside )
+    {
+      weights1D    = entry.m_Weights1D;
+      supportIndex = entry.m_SupportIndex;
+      if( derivativeWeights1D )
+      {
+        *derivativeWeights1D = entry.m_DerivativeWeights1D;
+      }
+    }
+    return true;
+  }
+
+  /** Assemble the weights from the tables per dimension. */
+  inside = true;
+  SizeValueType offset = 0;
+  for( unsigned int i = 0; i < SpaceDimension; ++i )
+  {
+    const CachedWeightsType & entry = this->m_WeightsCache[ offset + gridIndex[ i ] ];
+    if( !entry.m_Inside )
+    {
+      inside = false;
+      return true;
+    }
+    for( unsigned int k = 0; k <= SplineOrder; ++k )
+    {
+      weights1D[ i ][ k ] = entry.m_Weights1D[ i ][ k ];
+    }
+    if( derivativeWeights1D )
+    {
+      for( unsigned int k = 0; k <= SplineOrder; ++k )
+      {
+        ( *derivativeWeights1D )[ i ][ k ] = entry.m_DerivativeWeights1D[ i ][ k ];
+      }
+    }
+    supportIndex[ i ] = entry.m_SupportIndex[ i ];
+    offset           += this->m_WeightsCacheGridSize[ i ];
+  }
+
+  return true;
+
+} // end LookupCachedWeights()
+
+
 // Transform a point
 template< class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder >
 void
@@ -243,98 +565,214 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
     return;
   }
 
-  /***/
-  ContinuousIndexType cindex;
-  this->TransformPointToContinuousGridIndex( point, cindex );
-
-  // NOTE: if the support region does not lie totally within the grid
-  // we assume zero displacement and return the input point
-  inside = this->InsideValidRegion( cindex );
-  if( !inside )
+  // Compute interpolation weights, from the cache if possible
+  IndexType       supportIndex;
+  OneDWeightsType weights1D;
+  if( this->LookupCachedWeights( point, weights1D, NULL, supportIndex, inside ) )
   {
-    outputPoint = transformedPoint;
-    return;
+    if( !inside )
+    {
+      outputPoint = transformedPoint;
+      return;
+    }
+    this->m_WeightsFunction->EvaluateFrom1DWeights( weights1D, weights );
   }
+  else
+  {
+    ContinuousIndexType cindex;
+    this->TransformPointToContinuousGridIndex( point, cindex );
 
-  // Compute interpolation weights
-  IndexType supportIndex;
-  this->m_WeightsFunction->ComputeStartIndex( cindex, supportIndex );
-  this->m_WeightsFunction->Evaluate( cindex, supportIndex, weights );
+    // NOTE: if the support region does not lie totally within the grid
+    // we assume zero displacement and return the input point
+    inside = this->InsideValidRegion( cindex );
+    if( !inside )
+    {
+      outputPoint = transformedPoint;
+      return;
+    }
+
+    this->m_WeightsFunction->ComputeStartIndex( cindex, supportIndex );
+    this->m_WeightsFunction->Evaluate( cindex, supportIndex, weights );
+  }
 
   // For each dimension, correlate coefficient with weights
+  this->ComputeDisplacementFromWeights( weights, supportIndex, indices, outputPoint );
+
+  // The output point is the start point + displacement.
+  for( unsigned int j = 0; j < SpaceDimension; j++ )
+  {
+    outputPoint[ j ] += transformedPoint[ j ];
+  }
+
+} // end TransformPoint()
+
+
+// Transform a point
+template< class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder >
+typename AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
+::OutputPointType
+AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
+::TransformPoint( const InputPointType & point ) const
+{
+  /** Allocate memory on the stack: */
+  const unsigned long numberOfWeights = WeightsFunctionType::NumberOfWeights;
+  typename WeightsType::ValueType weightsArray[ numberOfWeights ];
+  typename ParameterIndexArrayType::ValueType indicesArray[ numberOfWeights ];
+  WeightsType             weights( weightsArray, numberOfWeights, false );
+  ParameterIndexArrayType indices( indicesArray, numberOfWeights, false );
+
+  OutputPointType outputPoint;
+  bool            inside;
+
+  this->TransformPoint( point, outputPoint, weights, indices, inside );
+
+  return outputPoint;
+}
+
+
+/**
+ * ********************* ComputeDisplacementFromWeights ****************************
+ */
+
+template< class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder >
+void
+AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
+::ComputeDisplacementFromWeights(
+  const WeightsType & weights,
+  const IndexType & supportIndex,
+  ParameterIndexArrayType & indices,
+  OutputPointType & displacement ) const
+{
   RegionType supportRegion;
   supportRegion.SetSize( this->m_SupportSize );
   supportRegion.SetIndex( supportIndex );
 
-  outputPoint.Fill( NumericTraits< ScalarType >::ZeroValue() );
+  displacement.Fill( NumericTraits< ScalarType >::ZeroValue() );
 
-  /** Create iterators over the coefficient images. */
+  /** Create an iterator over the first coefficient image, to obtain the
+   * parameter offsets of the support region. All coefficient images share
+   * the same buffered region, so the offsets also hold for the others.
+   */
   typedef ImageScanlineConstIterator< ImageType > IteratorType;
-  IteratorType      iterator[ SpaceDimension ];
+  IteratorType      iterator( this->m_CoefficientImages[ 0 ], supportRegion );
   unsigned long     counter = 0;
   const PixelType * basePointer
     = this->m_CoefficientImages[ 0 ]->GetBufferPointer();
 
-  for( unsigned int j = 0; j < SpaceDimension; j++ )
+  while( !iterator.IsAtEnd() )
   {
-    iterator[ j ] = IteratorType( this->m_CoefficientImages[ j ], supportRegion );
+    while( !iterator.IsAtEndOfLine() )
+    {
+      indices[ counter ] = &( iterator.Value() ) - basePointer;
+      ++iterator;
+      ++counter;
+    }
+    iterator.NextLine();
   }
 
-  /** Loop over the support region. */
-  while( !iterator[ 0 ].IsAtEnd() )
+  /** Multiply weights with coefficients to compute the displacement. */
+  if( this->m_UseFloatCoefficients && this->m_FloatCoefficientImages[ 0 ] )
   {
-    while( !iterator[ 0 ].IsAtEndOfLine() )
+    for( unsigned int j = 0; j < SpaceDimension; j++ )
     {
-      // populate the indices array
-      indices[ counter ] = &( iterator[ 0 ].Value() ) - basePointer;
-
-      // multiply weight with coefficient to compute displacement
-      for( unsigned int j = 0; j < SpaceDimension; j++ )
+      const float * coefficients = this->m_FloatCoefficientImages[ j ]->GetBufferPointer();
+      float         value        = 0.0f;
+      for( unsigned long k = 0; k < counter; ++k )
       {
-        outputPoint[ j ] += static_cast< ScalarType >(
-          weights[ counter ] * iterator[ j ].Value() );
-        ++iterator[ j ];
+        value += static_cast< float >( weights[ k ] ) * coefficients[ indices[ k ] ];
       }
-      ++counter;
-    } // end of scanline
-
+      displacement[ j ] = static_cast< ScalarType >( value );
+    }
+  }
+  else
+  {
     for( unsigned int j = 0; j < SpaceDimension; j++ )
     {
-      iterator[ j ].NextLine();
+      const PixelType * coefficients = this->m_CoefficientImages[ j ]->GetBufferPointer();
+      for( unsigned long k = 0; k < counter; ++k )
+      {
+        displacement[ j ] += static_cast< ScalarType >(
+          weights[ k ] * coefficients[ indices[ k ] ] );
+      }
     }
+  }
 
-  } // end while
+} // end ComputeDisplacementFromWeights()
 
-  // The output point is the start point + displacement.
-  for( unsigned int j = 0; j < SpaceDimension; j++ )
+
+/**
+ * ********************* ComputeInterpolationWeights ****************************
+ */
+
+template< class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder >
+bool
+AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
+::ComputeInterpolationWeights(
+  const InputPointType & ipp,
+  WeightsType & weights,
+  IndexType & supportIndex ) const
+{
+  /** Convert the physical point to a continuous index. */
+  ContinuousIndexType cindex;
+  this->TransformPointToContinuousGridIndex( ipp, cindex );
+
+  /** NOTE: if the support region does not lie totally within the grid
+   * we assume zero displacement.
+   */
+  if( !this->InsideValidRegion( cindex ) )
   {
-    outputPoint[ j ] += transformedPoint[ j ];
+    return false;
   }
 
-} // end TransformPoint()
+  /** Compute the start index and the interpolation weights. */
+  this->m_WeightsFunction->ComputeStartIndex( cindex, supportIndex );
+  this->m_WeightsFunction->Evaluate( cindex, supportIndex, weights );
 
+  return true;
+
+} // end ComputeInterpolationWeights()
+
+
+/**
+ * ********************* TransformPointUsingWeights ****************************
+ */
 
-// Transform a point
 template< class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder >
 typename AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
 ::OutputPointType
 AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
-::TransformPoint( const InputPointType & point ) const
+::TransformPointUsingWeights(
+  const InputPointType & ipp,
+  const WeightsType & weights,
+  const IndexType & supportIndex ) const
 {
-  /** Allocate memory on the stack: */
+  /** Check if the coefficient image has been set. */
+  OutputPointType opp;
+  if( !this->m_CoefficientImages[ 0 ] )
+  {
+    itkWarningMacro( << "B-spline coefficients have not been set" );
+    for( unsigned int j = 0; j < SpaceDimension; ++j )
+    {
+      opp[ j ] = ipp[ j ];
+    }
+    return opp;
+  }
+
+  /** Correlate the shared weights with the coefficients. */
   const unsigned long numberOfWeights = WeightsFunctionType::NumberOfWeights;
-  typename WeightsType::ValueType weightsArray[ numberOfWeights ];
   typename ParameterIndexArrayType::ValueType indicesArray[ numberOfWeights ];
-  WeightsType             weights( weightsArray, numberOfWeights, false );
   ParameterIndexArrayType indices( indicesArray, numberOfWeights, false );
+  this->ComputeDisplacementFromWeights( weights, supportIndex, indices, opp );
 
-  OutputPointType outputPoint;
-  bool            inside;
+  /** The output point is the start point + displacement. */
+  for( unsigned int j = 0; j < SpaceDimension; ++j )
+  {
+    opp[ j ] += ipp[ j ];
+  }
 
-  this->TransformPoint( point, outputPoint, weights, indices, inside );
+  return opp;
 
-  return outputPoint;
-}
+} // end TransformPointUsingWeights()
 
 
 /**
@@ -383,11 +821,20 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
     itkExceptionMacro( << "Cannot compute Jacobian: parameters not set" );
   }
 
-  /** Convert the physical point to a continuous index, which
-   * is needed for the 'Evaluate()' functions below.
+  /** Look up the 1D weights in the cache, or convert the physical point
+   * to a continuous index, which is needed for the 'Evaluate()' functions below.
    */
+  OneDWeightsType     weights1D;
+  IndexType           supportIndex;
   ContinuousIndexType cindex;
-  this->TransformPointToContinuousGridIndex( ipp, cindex );
+  bool                inside = true;
+  const bool          cached = this->LookupCachedWeights(
+    ipp, weights1D, NULL, supportIndex, inside );
+  if( !cached )
+  {
+    this->TransformPointToContinuousGridIndex( ipp, cindex );
+    inside = this->InsideValidRegion( cindex );
+  }
 
   /** Initialize. */
   const NumberOfParametersType nnzji = this->GetNumberOfNonZeroJacobianIndices();
@@ -400,7 +847,7 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
   /** NOTE: if the support region does not lie totally within the grid
    * we assume zero displacement and zero Jacobian.
    */
-  if( !this->InsideValidRegion( cindex ) )
+  if( !inside )
   {
     nonZeroJacobianIndices.resize( this->GetNumberOfNonZeroJacobianIndices() );
     for( NumberOfParametersType i = 0; i < this->GetNumberOfNonZeroJacobianIndices(); ++i )
@@ -418,9 +865,15 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
   WeightsType weights( weightsArray, numberOfWeights, false );
 
   /** Compute the weights. */
-  IndexType supportIndex;
-  this->m_WeightsFunction->ComputeStartIndex( cindex, supportIndex );
-  this->m_WeightsFunction->Evaluate( cindex, supportIndex, weights );
+  if( cached )
+  {
+    this->m_WeightsFunction->EvaluateFrom1DWeights( weights1D, weights );
+  }
+  else
+  {
+    this->m_WeightsFunction->ComputeStartIndex( cindex, supportIndex );
+    this->m_WeightsFunction->Evaluate( cindex, supportIndex, weights );
+  }
 
   /** Setup support region */
   RegionType supportRegion;
@@ -456,11 +909,20 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
   DerivativeType & imageJacobian,
   NonZeroJacobianIndicesType & nonZeroJacobianIndices ) const
 {
-  /** Convert the physical point to a continuous index, which
-   * is needed for the 'Evaluate()' functions below.
+  /** Look up the 1D weights in the cache, or convert the physical point
+   * to a continuous index, which is needed for the 'Evaluate()' functions below.
    */
+  OneDWeightsType     weights1D;
+  IndexType           supportIndex;
   ContinuousIndexType cindex;
-  this->TransformPointToContinuousGridIndex( ipp, cindex );
+  bool                inside = true;
+  const bool          cached = this->LookupCachedWeights(
+    ipp, weights1D, NULL, supportIndex, inside );
+  if( !cached )
+  {
+    this->TransformPointToContinuousGridIndex( ipp, cindex );
+    inside = this->InsideValidRegion( cindex );
+  }
 
   /** Get sizes. */
   const NumberOfParametersType nnzji             = this->GetNumberOfNonZeroJacobianIndices();
@@ -469,7 +931,7 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
   /** NOTE: if the support region does not lie totally within the grid
    * we assume zero displacement and zero Jacobian.
    */
-  if( !this->InsideValidRegion( cindex ) )
+  if( !inside )
   {
     nonZeroJacobianIndices.resize( nnzji );
     for( NumberOfParametersType i = 0; i < nnzji; ++i )
@@ -487,10 +949,16 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
   typename WeightsType::ValueType weightsArray[ numberOfWeights ];
   WeightsType weights( weightsArray, numberOfWeights, false );
 
-  /** Compute the B-spline derivative weights. */
-  IndexType supportIndex;
-  this->m_WeightsFunction->ComputeStartIndex( cindex, supportIndex );
-  this->m_WeightsFunction->Evaluate( cindex, supportIndex, weights );
+  /** Compute the B-spline weights. */
+  if( cached )
+  {
+    this->m_WeightsFunction->EvaluateFrom1DWeights( weights1D, weights );
+  }
+  else
+  {
+    this->m_WeightsFunction->ComputeStartIndex( cindex, supportIndex );
+    this->m_WeightsFunction->Evaluate( cindex, supportIndex, weights );
+  }
 
   /** Compute the inner product. */
   NumberOfParametersType counter = 0;
@@ -528,15 +996,25 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
   const InputPointType & ipp,
   SpatialJacobianType & sj ) const
 {
-  /** Convert the physical point to a continuous index, which
-   * is needed for the 'Evaluate()' functions below.
+  /** Look up the 1D weights in the cache, or convert the physical point
+   * to a continuous index, which is needed for the 'Evaluate()' functions below.
    */
+  OneDWeightsType     weights1D;
+  OneDWeightsType     derivativeWeights1D;
+  IndexType           supportIndex;
   ContinuousIndexType cindex;
-  this->TransformPointToContinuousGridIndex( ipp, cindex );
+  bool                inside = true;
+  const bool          cached = this->LookupCachedWeights(
+    ipp, weights1D, &derivativeWeights1D, supportIndex, inside );
+  if( !cached )
+  {
+    this->TransformPointToContinuousGridIndex( ipp, cindex );
+    inside = this->InsideValidRegion( cindex );
+  }
 
   // NOTE: if the support region does not lie totally within the grid
   // we assume zero displacement and identity spatial Jacobian
-  if( !this->InsideValidRegion( cindex ) )
+  if( !inside )
   {
     sj.SetIdentity();
     return;
@@ -552,9 +1030,11 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
   typename WeightsType::ValueType coeffArray[ numberOfWeights * SpaceDimension ];
   WeightsType coeffs( coeffArray, numberOfWeights * SpaceDimension, false );
 
-  IndexType supportIndex;
-  this->m_DerivativeWeightsFunctions[ 0 ]->ComputeStartIndex(
-    cindex, supportIndex );
+  if( !cached )
+  {
+    this->m_DerivativeWeightsFunctions[ 0 ]->ComputeStartIndex(
+      cindex, supportIndex );
+  }
   RegionType supportRegion;
   supportRegion.SetSize( this->m_SupportSize );
   supportRegion.SetIndex( supportIndex );
@@ -586,7 +1066,19 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
   for( unsigned int i = 0; i < SpaceDimension; ++i )
   {
     /** Compute the derivative weights. */
-    this->m_DerivativeWeightsFunctions[ i ]->Evaluate( cindex, supportIndex, weights );
+    if( cached )
+    {
+      OneDWeightsType tmp1D = weights1D;
+      for( unsigned int k = 0; k <= SplineOrder; ++k )
+      {
+        tmp1D[ i ][ k ] = derivativeWeights1D[ i ][ k ];
+      }
+      this->m_WeightsFunction->EvaluateFrom1DWeights( tmp1D, weights );
+    }
+    else
+    {
+      this->m_DerivativeWeightsFunctions[ i ]->Evaluate( cindex, supportIndex, weights );
+    }
 
     /** Create an iterator over the coeffs vector.  */
     typename WeightsType::const_iterator itCoeffs = coeffs.begin();
@@ -1468,6 +1960,9 @@ AdvancedBSplineDeformableTransform< TScalarType, NDimensions, VSplineOrder >
 
   os << indent << "WeightsFunction: ";
   os << this->m_WeightsFunction.GetPointer() << std::endl;
+  os << indent << "WeightsCacheSize: " << this->m_WeightsCache.size() << std::endl;
+  os << indent << "WeightsCacheIsSeparable: " << this->m_WeightsCacheIsSeparable << std::endl;
+  os << indent << "MaximumWeightsCacheSize: " << this->m_MaximumWeightsCacheSize << std::endl;
 }
 
 
@@ -220,6 +220,11 @@ public:
   /** Parameter index array type. */
   typedef Array< unsigned long > ParameterIndexArrayType;
 
+  /** Interpolation weights type. Equal to the WeightsType of the
+   * weights functions used in derived classes.
+   */
+  typedef Array< double > WeightsType;
+
   /** Method to transform a vector -
    *  not applicable for this type of transform.
    */
@@ -280,6 +285,78 @@ public:
 
   virtual NumberOfParametersType GetNumberOfNonZeroJacobianIndices( void ) const = 0;
 
+  /** Compute the B-spline interpolation weights and the start index of the
+   * support region for an input point. Returns false if the point lies outside
+   * the valid region, in which case the weights are not computed.
+   * The weights only depend on the grid, so transforms with an identical grid
+   * may share them, see TransformPointUsingWeights().
+   */
+  virtual bool ComputeInterpolationWeights(
+    const InputPointType & ipp,
+    WeightsType & weights,
+    IndexType & supportIndex ) const = 0;
+
+  /** Transform a point using precomputed interpolation weights and support
+   * region start index, as computed by ComputeInterpolationWeights().
+   */
+  virtual OutputPointType TransformPointUsingWeights(
+    const InputPointType & ipp,
+    const WeightsType & weights,
+    const IndexType & supportIndex ) const = 0;
+
+  /** Image type describing a regular grid of sample points. */
+  typedef ImageBase< itkGetStaticConstMacro( SpaceDimension ) > ImageBaseType;
+
+  /** Precompute the interpolation weights for all points of a regular
+   * sample grid, for example the grid of an ImageGridSampler. The sample
+   * grid consists of the indices sampleGridRegion.GetIndex() + n *
+   * sampleGridSpacing of the given image, with 0 <= n < sampleGridRegion.GetSize().
+   * When the transform is subsequently evaluated at a point of this
+   * grid, the cached weights are used instead of recomputing them.
+   * The cache is invalidated when the B-spline grid changes.
+   */
+  virtual void PrecomputeWeightsOnSampleGrid(
+    const ImageBaseType * image,
+    const RegionType & sampleGridRegion,
+    const SizeType & sampleGridSpacing ) = 0;
+
+  /** Release the memory of the weights cache. */
+  virtual void ClearWeightsCache( void ) = 0;
+
+  /** Whether the weights cache is consulted when the transform is evaluated.
+   * Switching it off keeps the cached weights in memory, so that a caller
+   * that alternates between a grid and a random set of points, does not
+   * have to recompute them. Does not call Modified(). Default: true.
+   */
+  void SetUseWeightsCache( const bool _arg )
+  {
+    this->m_UseWeightsCache = _arg;
+  }
+
+  bool GetUseWeightsCache( void ) const
+  {
+    return this->m_UseWeightsCache;
+  }
+
+  /** Single precision copy of the coefficient images. */
+  typedef Image< float,
+    itkGetStaticConstMacro( SpaceDimension ) >           FloatImageType;
+  typedef typename FloatImageType::Pointer FloatImagePointer;
+
+  /** Evaluate the displacement using a single precision copy of the
+   * B-spline coefficients. This halves the memory traffic of TransformPoint()
+   * on large grids, at the cost of a small loss of accuracy in the
+   * displacement. The copy is refreshed, in parallel, with every call to
+   * SetParameters(). Only TransformPoint() reads the copy: the Jacobian,
+   * the spatial derivatives and the parameters themselves remain double
+   * precision. The copy in every SetParameters() is usually more expensive
+   * than the saving in TransformPoint(), see the timings reported by
+   * BSplineTransformPointPerformanceTest. Default: false.
+   */
+  virtual void SetUseFloatCoefficients( const bool _arg );
+
+  itkGetConstMacro( UseFloatCoefficients, bool );
+
   /** This typedef should be equal to the typedef used
    * in derived classes based on the weights function.
    */
@@ -296,6 +373,11 @@ protected:
   /** Wrap flat array into images of coefficients. */
   void WrapAsImages( void );
 
+  /** Copy the coefficient images to m_FloatCoefficientImages,
+   * if m_UseFloatCoefficients is true.
+   */
+  void UpdateFloatCoefficientImages( void );
+
   /** Convert an input point to a continuous index inside the B-spline grid. */
   void TransformPointToContinuousGridIndex(
     const InputPointType & point, ContinuousIndexType & index ) const;
@@ -314,6 +396,13 @@ protected:
    */
   ImagePointer m_CoefficientImages[ NDimensions ];
 
+  /** Whether the weights cache of derived classes is used. */
+  bool m_UseWeightsCache;
+
+  /** Single precision copy of m_CoefficientImages. */
+  bool              m_UseFloatCoefficients;
+  FloatImagePointer m_FloatCoefficientImages[ NDimensions ];
+
   /** Variables defining the coefficient grid extend. */
   RegionType     m_GridRegion;
   SpacingType    m_GridSpacing;
@@ -57,7 +57,10 @@ AdvancedBSplineDeformableTransformBase< TScalarType, NDimensions >
     this->m_WrappedImage[ j ]->SetSpacing( this->m_GridSpacing.GetDataPointer() );
     this->m_WrappedImage[ j ]->SetDirection( this->m_GridDirection );
     this->m_CoefficientImages[ j ] = NULL;
+    this->m_FloatCoefficientImages[ j ] = NULL;
   }
+  this->m_UseFloatCoefficients = false;
+  this->m_UseWeightsCache      = true;
 
   this->m_ValidRegion = this->m_GridRegion;
 
@@ -428,9 +431,70 @@ AdvancedBSplineDeformableTransformBase< TScalarType, NDimensions >
     dataPointer                   += numberOfPixels;
     this->m_CoefficientImages[ j ] = this->m_WrappedImage[ j ];
   }
+
+  this->UpdateFloatCoefficientImages();
 }
 
 
+// Set whether a single precision copy of the coefficients is used
+template< class TScalarType, unsigned int NDimensions >
+void
+AdvancedBSplineDeformableTransformBase< TScalarType, NDimensions >
+::SetUseFloatCoefficients( const bool _arg )
+{
+  if( this->m_UseFloatCoefficients != _arg )
+  {
+    this->m_UseFloatCoefficients = _arg;
+    this->UpdateFloatCoefficientImages();
+    this->Modified();
+  }
+}
+
+
+// Copy the coefficient images to single precision
+template< class TScalarType, unsigned int NDimensions >
+void
+AdvancedBSplineDeformableTransformBase< TScalarType, NDimensions >
+::UpdateFloatCoefficientImages( void )
+{
+  for( unsigned int j = 0; j < SpaceDimension; j++ )
+  {
+    if( !this->m_UseFloatCoefficients || this->m_CoefficientImages[ j ].IsNull() )
+    {
+      this->m_FloatCoefficientImages[ j ] = NULL;
+      continue;
+    }
+
+    const RegionType region = this->m_CoefficientImages[ j ]->GetBufferedRegion();
+    if( this->m_FloatCoefficientImages[ j ].IsNull() )
+    {
+      this->m_FloatCoefficientImages[ j ] = FloatImageType::New();
+    }
+    FloatImageType * floatImage = this->m_FloatCoefficientImages[ j ];
+    if( floatImage->GetBufferedRegion() != region )
+    {
+      floatImage->SetRegions( region );
+      floatImage->Allocate();
+    }
+    floatImage->SetOrigin( this->m_CoefficientImages[ j ]->GetOrigin() );
+    floatImage->SetSpacing( this->m_CoefficientImages[ j ]->GetSpacing() );
+    floatImage->SetDirection( this->m_CoefficientImages[ j ]->GetDirection() );
+
+    /** This copy is done on every SetParameters(), so do it in parallel. */
+    const PixelType * source         = this->m_CoefficientImages[ j ]->GetBufferPointer();
+    float *           target         = floatImage->GetBufferPointer();
+    const long        numberOfPixels = static_cast< long >( region.GetNumberOfPixels() );
+#ifdef ELASTIX_USE_OPENMP
+    #pragma omp parallel for
+#endif
+    for( long i = 0; i < numberOfPixels; ++i )
+    {
+      target[ i ] = static_cast< float >( source[ i ] );
+    }
+  }
+} // end UpdateFloatCoefficientImages()
+
+
 // Set the parameters by value
 template< class TScalarType, unsigned int NDimensions >
 void
@@ -532,6 +596,7 @@ AdvancedBSplineDeformableTransformBase< TScalarType, NDimensions >
     {
       this->m_CoefficientImages[ j ] = images[ j ];
     }
+    this->UpdateFloatCoefficientImages();
 
     // Clean up buffered parameters
     this->m_InternalParametersBuffer = ParametersType( 0 );
@@ -575,6 +640,10 @@ AdvancedBSplineDeformableTransformBase< TScalarType, NDimensions >
   }
   os << " ]" << std::endl;
 
+  os << indent << "UseFloatCoefficients: "
+     << ( this->m_UseFloatCoefficients ? "true" : "false" ) << std::endl;
+  os << indent << "UseWeightsCache: "
+     << ( this->m_UseWeightsCache ? "true" : "false" ) << std::endl;
   os << indent << "InputParametersPointer: "
      << this->m_InputParametersPointer << std::endl;
   os << indent << "ValidRegion: " << this->m_ValidRegion << std::endl;
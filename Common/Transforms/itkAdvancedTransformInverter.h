@@ -0,0 +1,148 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkAdvancedTransformInverter_h
+#define __itkAdvancedTransformInverter_h
+
+#include "itkAdvancedTransform.h"
+#include "itkImage.h"
+#include "itkVector.h"
+
+namespace itk
+{
+
+/** \class AdvancedTransformInverter
+ * \brief Computes the inverse mapping of an AdvancedTransform point by point.
+ *
+ * For a point \f$y\f$ the inverse \f$x = T^{-1}(y)\f$ is found by solving
+ * \f$T(x) = y\f$ with a damped Newton iteration, using the spatial Jacobian
+ * of the transform. When the spatial Jacobian is (nearly) singular, a
+ * fixed-point step \f$x \leftarrow x - (T(x) - y)\f$ is taken instead.
+ * This works for any transform that implements GetSpatialJacobian(), such as
+ * B-spline and combination transforms.
+ *
+ * To obtain good initial guesses, a coarse seed grid can be precomputed with
+ * ComputeSeedGrid(). It stores the inverse displacement at the nodes of a
+ * shrunken version of a given domain. The inverse of an arbitrary point
+ * then starts from the inverse displacement of its nearest seed node.
+ *
+ * Both TransformPoint() and GenerateInverseDisplacementField() are
+ * thread-safe and, when OpenMP is available, the seed grid and dense field
+ * are computed in parallel.
+ *
+ * \ingroup Transforms
+ */
+template< class TScalarType, unsigned int NDimensions = 3 >
+class AdvancedTransformInverter :
+  public Object
+{
+public:
+
+  /** Standard class typedefs. */
+  typedef AdvancedTransformInverter  Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro( Self );
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro( AdvancedTransformInverter, Object );
+
+  /** Dimension of the domain space. */
+  itkStaticConstMacro( SpaceDimension, unsigned int, NDimensions );
+
+  /** Typedefs for the transform. */
+  typedef AdvancedTransform< TScalarType, NDimensions, NDimensions > TransformType;
+  typedef typename TransformType::ConstPointer                       TransformConstPointer;
+  typedef typename TransformType::InputPointType                     InputPointType;
+  typedef typename TransformType::OutputPointType                    OutputPointType;
+  typedef typename TransformType::SpatialJacobianType                SpatialJacobianType;
+
+  /** Typedefs for the seed grid and the inverse displacement field. */
+  typedef Vector< TScalarType, NDimensions >                         DisplacementType;
+  typedef Image< DisplacementType, NDimensions >                     SeedGridImageType;
+  typedef typename SeedGridImageType::Pointer                        SeedGridImagePointer;
+  typedef ImageBase< NDimensions >                                   ImageBaseType;
+
+  /** Set/Get the transform to invert. */
+  itkSetConstObjectMacro( Transform, TransformType );
+  itkGetConstObjectMacro( Transform, TransformType );
+
+  /** Set/Get the maximum number of iterations per point. Default: 50. */
+  itkSetMacro( MaximumNumberOfIterations, unsigned int );
+  itkGetConstMacro( MaximumNumberOfIterations, unsigned int );
+
+  /** Set/Get the tolerance on the distance || T(x) - y ||, in physical
+   * units. Default: 1e-4.
+   */
+  itkSetMacro( Tolerance, double );
+  itkGetConstMacro( Tolerance, double );
+
+  /** Precompute the inverse displacement on a coarse grid over the domain
+   * of the given image, with the spacing multiplied by shrinkFactor.
+   */
+  virtual void ComputeSeedGrid( const ImageBaseType * domain,
+    const unsigned int shrinkFactor );
+
+  /** Get the seed grid. Returns NULL if no seed grid was computed. */
+  itkGetConstObjectMacro( SeedGrid, SeedGridImageType );
+
+  /** Compute x = T^{-1}( y ). Returns false if the iteration did not
+   * converge within the maximum number of iterations; x then contains
+   * the best estimate.
+   */
+  virtual bool TransformPoint( const OutputPointType & y, InputPointType & x ) const;
+
+  /** Fill the inverse displacement field x - y for all voxel positions y of
+   * the given image, which must have been allocated by the caller.
+   * Returns the number of voxels for which the iteration did not converge.
+   */
+  virtual SizeValueType GenerateInverseDisplacementField(
+    SeedGridImageType * field ) const;
+
+protected:
+
+  AdvancedTransformInverter();
+  virtual ~AdvancedTransformInverter() {}
+
+  /** Print information about this class. */
+  virtual void PrintSelf( std::ostream & os, Indent indent ) const;
+
+  /** Solve T(x) = y, starting from the initial guess in x. */
+  bool Invert( const OutputPointType & y, InputPointType & x ) const;
+
+private:
+
+  AdvancedTransformInverter( const Self & ); // purposely not implemented
+  void operator=( const Self & );            // purposely not implemented
+
+  TransformConstPointer m_Transform;
+  SeedGridImagePointer  m_SeedGrid;
+  unsigned int          m_MaximumNumberOfIterations;
+  double                m_Tolerance;
+
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkAdvancedTransformInverter.hxx"
+#endif
+
+#endif // end #ifndef __itkAdvancedTransformInverter_h
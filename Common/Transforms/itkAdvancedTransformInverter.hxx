@@ -0,0 +1,297 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkAdvancedTransformInverter_hxx
+#define __itkAdvancedTransformInverter_hxx
+
+#include "itkAdvancedTransformInverter.h"
+
+#include "vnl/vnl_math.h"
+#include "vnl/vnl_det.h"
+#include "vnl/vnl_inverse.h"
+#include "vnl/vnl_matrix_fixed.h"
+#include "vnl/vnl_vector_fixed.h"
+
+namespace itk
+{
+
+/**
+ * ************************* Constructor ************************
+ */
+
+template< class TScalarType, unsigned int NDimensions >
+AdvancedTransformInverter< TScalarType, NDimensions >
+::AdvancedTransformInverter()
+{
+  this->m_Transform                 = NULL;
+  this->m_SeedGrid                  = NULL;
+  this->m_MaximumNumberOfIterations = 50;
+  this->m_Tolerance                 = 1e-4;
+
+} // end Constructor
+
+
+/**
+ * ************************* ComputeSeedGrid ************************
+ */
+
+template< class TScalarType, unsigned int NDimensions >
+void
+AdvancedTransformInverter< TScalarType, NDimensions >
+::ComputeSeedGrid( const ImageBaseType * domain, const unsigned int shrinkFactor )
+{
+  if( domain == NULL )
+  {
+    itkExceptionMacro( << "Cannot compute a seed grid without a domain" );
+  }
+
+  /** Check the transform here: no exceptions may leave the parallel loop below. */
+  if( this->m_Transform.IsNull() )
+  {
+    itkExceptionMacro( << "Transform not set" );
+  }
+
+  /** Remove an existing seed grid, so that it is not used while
+   * computing the new one.
+   */
+  this->m_SeedGrid = NULL;
+
+  /** Define the coarse grid over the domain. */
+  const unsigned int factor = shrinkFactor > 0 ? shrinkFactor : 1;
+  const typename ImageBaseType::RegionType domainRegion
+    = domain->GetLargestPossibleRegion();
+
+  typename SeedGridImageType::SizeType    size;
+  typename SeedGridImageType::IndexType   index;
+  typename SeedGridImageType::SpacingType spacing;
+  typename SeedGridImageType::PointType   origin;
+  for( unsigned int i = 0; i < SpaceDimension; ++i )
+  {
+    size[ i ]    = ( domainRegion.GetSize()[ i ] + factor - 1 ) / factor;
+    size[ i ]    = size[ i ] > 0 ? size[ i ] : 1;
+    spacing[ i ] = domain->GetSpacing()[ i ] * factor;
+  }
+  index.Fill( 0 );
+  domain->TransformIndexToPhysicalPoint( domainRegion.GetIndex(), origin );
+
+  SeedGridImagePointer seedGrid = SeedGridImageType::New();
+  seedGrid->SetRegions( typename SeedGridImageType::RegionType( index, size ) );
+  seedGrid->SetSpacing( spacing );
+  seedGrid->SetOrigin( origin );
+  seedGrid->SetDirection( domain->GetDirection() );
+  seedGrid->Allocate();
+
+  /** Invert the transform at every node, starting from the identity. */
+  DisplacementType * buffer         = seedGrid->GetBufferPointer();
+  const long         numberOfPixels = static_cast< long >(
+    seedGrid->GetLargestPossibleRegion().GetNumberOfPixels() );
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for
+#endif
+  for( long i = 0; i < numberOfPixels; ++i )
+  {
+    OutputPointType y;
+    seedGrid->TransformIndexToPhysicalPoint( seedGrid->ComputeIndex( i ), y );
+    InputPointType x = y;
+    this->Invert( y, x );
+    buffer[ i ] = x - y;
+  }
+
+  this->m_SeedGrid = seedGrid;
+
+} // end ComputeSeedGrid()
+
+
+/**
+ * ************************* TransformPoint ************************
+ */
+
+template< class TScalarType, unsigned int NDimensions >
+bool
+AdvancedTransformInverter< TScalarType, NDimensions >
+::TransformPoint( const OutputPointType & y, InputPointType & x ) const
+{
+  /** Initial guess: the inverse displacement of the nearest seed node,
+   * or the identity if there is none.
+   */
+  x = y;
+  if( this->m_SeedGrid.IsNotNull() )
+  {
+    typename SeedGridImageType::IndexType index;
+    if( this->m_SeedGrid->TransformPhysicalPointToIndex( y, index ) )
+    {
+      x = y + this->m_SeedGrid->GetPixel( index );
+    }
+  }
+
+  return this->Invert( y, x );
+
+} // end TransformPoint()
+
+
+/**
+ * ************************* GenerateInverseDisplacementField ************************
+ */
+
+template< class TScalarType, unsigned int NDimensions >
+SizeValueType
+AdvancedTransformInverter< TScalarType, NDimensions >
+::GenerateInverseDisplacementField( SeedGridImageType * field ) const
+{
+  if( field == NULL || field->GetBufferPointer() == NULL )
+  {
+    itkExceptionMacro( << "The inverse displacement field must be allocated" );
+  }
+
+  /** Check the transform here: no exceptions may leave the parallel loop below. */
+  if( this->m_Transform.IsNull() )
+  {
+    itkExceptionMacro( << "Transform not set" );
+  }
+
+  DisplacementType * buffer         = field->GetBufferPointer();
+  const long         numberOfPixels = static_cast< long >(
+    field->GetBufferedRegion().GetNumberOfPixels() );
+  long numberOfFailures = 0;
+
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for reduction( + : numberOfFailures )
+#endif
+  for( long i = 0; i < numberOfPixels; ++i )
+  {
+    OutputPointType y;
+    field->TransformIndexToPhysicalPoint( field->ComputeIndex( i ), y );
+    InputPointType x;
+    if( !this->TransformPoint( y, x ) )
+    {
+      ++numberOfFailures;
+    }
+    buffer[ i ] = x - y;
+  }
+
+  return static_cast< SizeValueType >( numberOfFailures );
+
+} // end GenerateInverseDisplacementField()
+
+
+/**
+ * ************************* Invert ************************
+ */
+
+template< class TScalarType, unsigned int NDimensions >
+bool
+AdvancedTransformInverter< TScalarType, NDimensions >
+::Invert( const OutputPointType & y, InputPointType & x ) const
+{
+  if( this->m_Transform.IsNull() )
+  {
+    itkExceptionMacro( << "Transform not set" );
+  }
+
+  typedef vnl_matrix_fixed< double, NDimensions, NDimensions > MatrixType;
+  typedef vnl_vector_fixed< double, NDimensions >              VectorType;
+
+  /** The residual T(x) - y. */
+  DisplacementType residual = this->m_Transform->TransformPoint( x ) - y;
+  double           residualNorm = residual.GetNorm();
+
+  SpatialJacobianType sj;
+  for( unsigned int it = 0; it < this->m_MaximumNumberOfIterations; ++it )
+  {
+    if( residualNorm < this->m_Tolerance )
+    {
+      return true;
+    }
+
+    /** Newton step: solve J dx = T(x) - y. Fall back to a fixed-point
+     * step if the spatial Jacobian is (nearly) singular.
+     */
+    this->m_Transform->GetSpatialJacobian( x, sj );
+    MatrixType jacobian;
+    VectorType r;
+    for( unsigned int i = 0; i < SpaceDimension; ++i )
+    {
+      r[ i ] = residual[ i ];
+      for( unsigned int j = 0; j < SpaceDimension; ++j )
+      {
+        jacobian( i, j ) = sj( i, j );
+      }
+    }
+
+    VectorType step = r;
+    if( vcl_abs( vnl_det( jacobian ) ) > 1e-12 )
+    {
+      step = vnl_inverse( jacobian ) * r;
+    }
+
+    /** Backtracking: halve the step until the residual decreases. */
+    bool   improved = false;
+    double alpha    = 1.0;
+    for( unsigned int k = 0; k < 10; ++k, alpha *= 0.5 )
+    {
+      InputPointType xnew;
+      for( unsigned int i = 0; i < SpaceDimension; ++i )
+      {
+        xnew[ i ] = static_cast< TScalarType >( x[ i ] - alpha * step[ i ] );
+      }
+
+      const DisplacementType newResidual     = this->m_Transform->TransformPoint( xnew ) - y;
+      const double           newResidualNorm = newResidual.GetNorm();
+      if( newResidualNorm < residualNorm )
+      {
+        x            = xnew;
+        residual     = newResidual;
+        residualNorm = newResidualNorm;
+        improved     = true;
+        break;
+      }
+    }
+
+    /** Stagnation: no further progress is possible. */
+    if( !improved )
+    {
+      break;
+    }
+  }
+
+  return residualNorm < this->m_Tolerance;
+
+} // end Invert()
+
+
+/**
+ * ************************* PrintSelf ************************
+ */
+
+template< class TScalarType, unsigned int NDimensions >
+void
+AdvancedTransformInverter< TScalarType, NDimensions >
+::PrintSelf( std::ostream & os, Indent indent ) const
+{
+  Superclass::PrintSelf( os, indent );
+
+  os << indent << "Transform: " << this->m_Transform.GetPointer() << std::endl;
+  os << indent << "SeedGrid: " << this->m_SeedGrid.GetPointer() << std::endl;
+  os << indent << "MaximumNumberOfIterations: " << this->m_MaximumNumberOfIterations << std::endl;
+  os << indent << "Tolerance: " << this->m_Tolerance << std::endl;
+
+} // end PrintSelf()
+
+
+} // end namespace itk
+
+#endif // end #ifndef __itkAdvancedTransformInverter_hxx
@@ -74,6 +74,7 @@ public:
   typedef typename Superclass::IndexType           IndexType;
   typedef typename Superclass::SizeType            SizeType;
   typedef typename Superclass::ContinuousIndexType ContinuousIndexType;
+  typedef typename Superclass::OneDWeightsType     OneDWeightsType;
 
   /** Set the first order derivative direction. */
   virtual void SetDerivativeDirection( unsigned int dir );
@@ -89,7 +90,6 @@ protected:
   typedef typename Superclass
     ::SecondOrderDerivativeKernelType SecondOrderDerivativeKernelType;
   typedef typename Superclass::TableType       TableType;
-  typedef typename Superclass::OneDWeightsType OneDWeightsType;
 
   /** Compute the 1D weights, which are:
    * \f[ \beta( x[i] - startIndex[i] ), \beta( x[i] - startIndex[i] - 1 ),
@@ -75,6 +75,7 @@ public:
   typedef typename Superclass::IndexType           IndexType;
   typedef typename Superclass::SizeType            SizeType;
   typedef typename Superclass::ContinuousIndexType ContinuousIndexType;
+  typedef typename Superclass::OneDWeightsType     OneDWeightsType;
 
   /** Set the second order derivative directions. */
   virtual void SetDerivativeDirections( unsigned int dir0, unsigned int dir1 );
@@ -90,7 +91,6 @@ protected:
   typedef typename Superclass
     ::SecondOrderDerivativeKernelType SecondOrderDerivativeKernelType;
   typedef typename Superclass::TableType       TableType;
-  typedef typename Superclass::OneDWeightsType OneDWeightsType;
 
   /** Compute the 1D weights, which are:
    * \f[ \beta( x[i] - startIndex[i] ), \beta( x[i] - startIndex[i] - 1 ),
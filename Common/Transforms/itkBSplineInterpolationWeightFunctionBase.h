@@ -123,6 +123,29 @@ public:
   void ComputeStartIndex( const ContinuousIndexType & index,
     IndexType & startIndex ) const;
 
+  /** Typedef for intermediary 1D weights.
+   * The Matrix is at least twice as fast as std::vector< vnl_vector< double > >,
+   * probably because of the fixed size at compile time.
+   */
+  typedef Matrix< double,
+    itkGetStaticConstMacro( SpaceDimension ),
+    itkGetStaticConstMacro( SplineOrder ) + 1 > OneDWeightsType;
+
+  /** Evaluate only the 1D weights at the specified ContinuousIndex position.
+   * Together with EvaluateFrom1DWeights() this allows to store the 1D
+   * weights, which are much smaller than the full set of weights.
+   */
+  void Evaluate1DWeights( const ContinuousIndexType & cindex,
+    const IndexType & startIndex, OneDWeightsType & weights1D ) const
+  {
+    this->Compute1DWeights( cindex, startIndex, weights1D );
+  }
+
+
+  /** Compute the weights as the tensor product of the given 1D weights. */
+  void EvaluateFrom1DWeights( const OneDWeightsType & weights1D,
+    WeightsType & weights ) const;
+
   /** Get support region size. */
   itkGetConstReferenceMacro( SupportSize, SizeType );
 
@@ -146,14 +169,6 @@ protected:
   /** Lookup table type. */
   typedef Array2D< unsigned long > TableType;
 
-  /** Typedef for intermediary 1D weights.
-   * The Matrix is at least twice as fast as std::vector< vnl_vector< double > >,
-   * probably because of the fixed size at compile time.
-   */
-  typedef Matrix< double,
-    itkGetStaticConstMacro( SpaceDimension ),
-    itkGetStaticConstMacro( SplineOrder ) + 1 > OneDWeightsType;
-
   /** Compute the 1D weights. */
   virtual void Compute1DWeights(
     const ContinuousIndexType & index,
@@ -197,6 +197,23 @@ BSplineInterpolationWeightFunctionBase< TCoordRep, VSpaceDimension, VSplineOrder
   OneDWeightsType weights1D;
   this->Compute1DWeights( cindex, startIndex, weights1D );
 
+  /** Compute the vector of weights. */
+  this->EvaluateFrom1DWeights( weights1D, weights );
+
+} // end Evaluate()
+
+
+/**
+ * ******************* EvaluateFrom1DWeights *******************
+ */
+
+template< class TCoordRep, unsigned int VSpaceDimension, unsigned int VSplineOrder >
+void
+BSplineInterpolationWeightFunctionBase< TCoordRep, VSpaceDimension, VSplineOrder >
+::EvaluateFrom1DWeights(
+  const OneDWeightsType & weights1D,
+  WeightsType & weights ) const
+{
   /** Compute the vector of weights. */
   for( unsigned int k = 0; k < this->m_NumberOfWeights; k++ )
   {
@@ -209,7 +226,7 @@ BSplineInterpolationWeightFunctionBase< TCoordRep, VSpaceDimension, VSplineOrder
     weights[ k ] = tmp1;
   }
 
-} // end Evaluate()
+} // end EvaluateFrom1DWeights()
 
 
 } // end namespace itk
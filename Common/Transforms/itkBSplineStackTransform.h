@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkBSplineStackTransform_h
+#define __itkBSplineStackTransform_h
+
+#include "itkStackTransform.h"
+#include "itkAdvancedBSplineDeformableTransformBase.h"
+
+namespace itk
+{
+
+/** \class BSplineStackTransform
+ * \brief Stack transform with B-spline sub transforms that share one grid.
+ *
+ * All sub transforms of a B-spline stack transform are defined on the same
+ * control point grid, so the B-spline interpolation weights and the support
+ * region of a spatial point are identical for all of them. The batched
+ * TransformPoints() exploits this: when all points share their spatial part,
+ * the weights are computed once, and only the coefficient correlation is
+ * done per point. Otherwise, or when the sub transforms do not share one
+ * B-spline grid, it falls back to TransformPoint() per point.
+ *
+ * \ingroup Transforms
+ */
+template< class TScalarType,
+unsigned int NDimensions = 3 >
+class BSplineStackTransform :
+  public StackTransform< TScalarType, NDimensions, NDimensions >
+{
+public:
+
+  /** Standard class typedefs. */
+  typedef BSplineStackTransform Self;
+  typedef StackTransform< TScalarType,
+    NDimensions, NDimensions >       Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** New method for creating an object using a factory. */
+  itkNewMacro( Self );
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro( BSplineStackTransform, StackTransform );
+
+  /** Typedefs from the Superclass. */
+  typedef typename Superclass::InputPointType              InputPointType;
+  typedef typename Superclass::OutputPointType             OutputPointType;
+  typedef typename Superclass::InputPointContainerType     InputPointContainerType;
+  typedef typename Superclass::OutputPointContainerType    OutputPointContainerType;
+  typedef typename Superclass::SubTransformInputPointType  SubTransformInputPointType;
+  typedef typename Superclass::SubTransformOutputPointType SubTransformOutputPointType;
+
+  /** The B-spline sub transform type. */
+  typedef AdvancedBSplineDeformableTransformBase< TScalarType,
+    itkGetStaticConstMacro( ReducedInputSpaceDimension ) >  BSplineSubTransformType;
+  typedef typename BSplineSubTransformType::WeightsType WeightsType;
+  typedef typename BSplineSubTransformType::IndexType   SupportIndexType;
+
+  /** Batched stack evaluation, sharing the B-spline weights over all
+   * points with the same spatial part.
+   */
+  virtual void TransformPoints(
+    const InputPointContainerType & ipps,
+    OutputPointContainerType & opps ) const;
+
+protected:
+
+  BSplineStackTransform() {}
+  virtual ~BSplineStackTransform() {}
+
+  /** Check if two B-spline sub transforms are defined on the same grid. */
+  static bool HaveSameGrid(
+    const BSplineSubTransformType * a,
+    const BSplineSubTransformType * b );
+
+private:
+
+  BSplineStackTransform( const Self & ); // purposely not implemented
+  void operator=( const Self & );        // purposely not implemented
+
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBSplineStackTransform.hxx"
+#endif
+
+#endif
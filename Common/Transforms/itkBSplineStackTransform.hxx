@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef _itkBSplineStackTransform_hxx
+#define _itkBSplineStackTransform_hxx
+
+#include "itkBSplineStackTransform.h"
+
+namespace itk
+{
+
+/**
+ * ********************* HaveSameGrid ****************************
+ */
+
+template< class TScalarType, unsigned int NDimensions >
+bool
+BSplineStackTransform< TScalarType, NDimensions >
+::HaveSameGrid(
+  const BSplineSubTransformType * a,
+  const BSplineSubTransformType * b )
+{
+  return a == b
+         || ( a->GetGridRegion() == b->GetGridRegion()
+         && a->GetGridSpacing() == b->GetGridSpacing()
+         && a->GetGridOrigin() == b->GetGridOrigin()
+         && a->GetGridDirection() == b->GetGridDirection() );
+
+} // end HaveSameGrid()
+
+
+/**
+ * ********************* TransformPoints ****************************
+ */
+
+template< class TScalarType, unsigned int NDimensions >
+void
+BSplineStackTransform< TScalarType, NDimensions >
+::TransformPoints(
+  const InputPointContainerType & ipps,
+  OutputPointContainerType & opps ) const
+{
+  const std::size_t numberOfPoints = ipps.size();
+  if( numberOfPoints == 0 || this->m_NumberOfSubTransforms == 0 )
+  {
+    Superclass::TransformPoints( ipps, opps );
+    return;
+  }
+
+  /** Reduce dimension of the first input point. */
+  SubTransformInputPointType ippr;
+  Self::ReduceInputPoint( ipps[ 0 ], ippr );
+
+  /** The weights can only be shared if all points have the same spatial
+   * part, and all sub transforms involved are B-splines on the same grid.
+   */
+  bool                                           shareWeights = true;
+  std::vector< const BSplineSubTransformType * > subTransforms( numberOfPoints );
+  for( std::size_t i = 0; i < numberOfPoints && shareWeights; ++i )
+  {
+    for( unsigned int d = 0; d < Superclass::ReducedInputSpaceDimension; ++d )
+    {
+      if( ipps[ i ][ d ] != ippr[ d ] )
+      {
+        shareWeights = false;
+      }
+    }
+
+    const unsigned int subt = this->ComputeSubTransformIndex( ipps[ i ] );
+    subTransforms[ i ] = dynamic_cast< const BSplineSubTransformType * >(
+      this->m_SubTransformContainer[ subt ].GetPointer() );
+    if( subTransforms[ i ] == NULL
+      || !Self::HaveSameGrid( subTransforms[ 0 ], subTransforms[ i ] ) )
+    {
+      shareWeights = false;
+    }
+  }
+  if( !shareWeights )
+  {
+    Superclass::TransformPoints( ipps, opps );
+    return;
+  }
+
+  /** Compute the weights once, for all points. */
+  WeightsType      weights( subTransforms[ 0 ]->GetNumberOfAffectedWeights() );
+  SupportIndexType supportIndex;
+  const bool       inside
+    = subTransforms[ 0 ]->ComputeInterpolationWeights( ippr, weights, supportIndex );
+
+  /** Correlate the shared weights with the coefficients of each sub transform. */
+  opps.resize( numberOfPoints );
+  for( std::size_t i = 0; i < numberOfPoints; ++i )
+  {
+    SubTransformOutputPointType oppr;
+    if( inside )
+    {
+      oppr = subTransforms[ i ]->TransformPointUsingWeights( ippr, weights, supportIndex );
+    }
+    else
+    {
+      /** Outside the valid region the displacement is zero. */
+      for( unsigned int d = 0; d < Superclass::ReducedOutputSpaceDimension; ++d )
+      {
+        oppr[ d ] = ippr[ d ];
+      }
+    }
+
+    for( unsigned int d = 0; d < Superclass::ReducedOutputSpaceDimension; ++d )
+    {
+      opps[ i ][ d ] = oppr[ d ];
+    }
+    opps[ i ][ Superclass::ReducedOutputSpaceDimension ]
+      = ipps[ i ][ Superclass::ReducedInputSpaceDimension ];
+  }
+
+} // end TransformPoints()
+
+
+} // end namespace itk
+
+#endif
@@ -129,6 +129,28 @@ public:
     ParameterIndexArrayType & indices,
     bool & inside ) const;
 
+  /** The support region may wrap around the last dimension, so precomputed
+   * weights cannot be shared. This falls back to the normal TransformPoint().
+   */
+  virtual OutputPointType TransformPointUsingWeights(
+    const InputPointType & ipp,
+    const WeightsType &,
+    const IndexType & ) const
+  {
+    return Superclass::TransformPoint( ipp );
+  }
+
+
+  /** The support region may wrap around the last dimension, so the
+   * weights are not cached.
+   */
+  virtual void PrecomputeWeightsOnSampleGrid(
+    const ImageBaseType *, const RegionType &, const SizeType & )
+  {
+    this->ClearWeightsCache();
+  }
+
+
   /** Compute the Jacobian of the transformation. */
   virtual void GetJacobian(
     const InputPointType & ipp,
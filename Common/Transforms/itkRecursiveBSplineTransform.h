@@ -106,6 +106,7 @@ public:
   typedef typename Superclass::WeightsFunctionPointer             WeightsFunctionPointer;
   typedef typename Superclass::WeightsType                        WeightsType;
   typedef typename Superclass::ContinuousIndexType                ContinuousIndexType;
+  typedef typename Superclass::OneDWeightsType                    OneDWeightsType;
   typedef typename Superclass::DerivativeWeightsFunctionType      DerivativeWeightsFunctionType;
   typedef typename Superclass::DerivativeWeightsFunctionPointer   DerivativeWeightsFunctionPointer;
   typedef typename Superclass::SODerivativeWeightsFunctionType    SODerivativeWeightsFunctionType;
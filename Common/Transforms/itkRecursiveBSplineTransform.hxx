@@ -21,6 +21,7 @@
 #include "itkRecursiveBSplineTransform.h"
 
 #include "itkRecursiveBSplineTransformImplementation.h"
+#include <algorithm> // std::copy
 
 
 namespace itk
@@ -69,13 +70,21 @@ RecursiveBSplineTransform< TScalar, NDimensions, VSplineOrder >
     return outputPoint;
   }
 
-  /** Convert to continuous index. */
+  /** Look up the 1D weights in the cache, or convert to continuous index. */
+  IndexType           supportIndex;
+  OneDWeightsType     cachedWeights1D;
   ContinuousIndexType cindex;
-  this->TransformPointToContinuousGridIndex( point, cindex );
+  bool                inside = true;
+  const bool          cached = this->LookupCachedWeights(
+    point, cachedWeights1D, NULL, supportIndex, inside );
+  if( !cached )
+  {
+    this->TransformPointToContinuousGridIndex( point, cindex );
+    inside = this->InsideValidRegion( cindex );
+  }
 
   // NOTE: if the support region does not lie totally within the grid
   // we assume zero displacement and return the input point
-  bool inside = this->InsideValidRegion( cindex );
   if( !inside )
   {
     outputPoint = point;
@@ -83,8 +92,14 @@ RecursiveBSplineTransform< TScalar, NDimensions, VSplineOrder >
   }
 
   // Compute interpolation weighs and store them in weights1D
-  IndexType supportIndex;
-  this->m_RecursiveBSplineWeightFunction->Evaluate( cindex, weights1D, supportIndex );
+  if( cached )
+  {
+    std::copy( cachedWeights1D[ 0 ], cachedWeights1D[ 0 ] + numberOfWeights, weightsArray1D );
+  }
+  else
+  {
+    this->m_RecursiveBSplineWeightFunction->Evaluate( cindex, weights1D, supportIndex );
+  }
 
   /** Initialize (helper) variables. */
   const OffsetValueType * bsplineOffsetTable        = this->m_CoefficientImages[ 0 ]->GetOffsetTable();
@@ -94,6 +109,26 @@ RecursiveBSplineTransform< TScalar, NDimensions, VSplineOrder >
     totalOffsetToSupportIndex += supportIndex[ j ] * bsplineOffsetTable[ j ];
   }
 
+  /** Evaluate on the single precision copy of the coefficients, if requested. */
+  if( this->m_UseFloatCoefficients && this->m_FloatCoefficientImages[ 0 ] )
+  {
+    float * floatMu[ SpaceDimension ];
+    for( unsigned int j = 0; j < SpaceDimension; ++j )
+    {
+      floatMu[ j ] = this->m_FloatCoefficientImages[ j ]->GetBufferPointer() + totalOffsetToSupportIndex;
+    }
+
+    float floatDisplacement[ SpaceDimension ];
+    RecursiveBSplineTransformImplementation< SpaceDimension, SpaceDimension, SplineOrder, float >
+      ::TransformPoint( floatDisplacement, floatMu, bsplineOffsetTable, weightsArray1D );
+
+    for( unsigned int j = 0; j < SpaceDimension; ++j )
+    {
+      outputPoint[ j ] = static_cast< ScalarType >( floatDisplacement[ j ] ) + point[ j ];
+    }
+    return outputPoint;
+  }
+
   ScalarType * mu[ SpaceDimension ];
   for( unsigned int j = 0; j < SpaceDimension; ++j )
   {
@@ -125,11 +160,20 @@ RecursiveBSplineTransform< TScalar, NDimensions, VSplineOrder >
 ::GetJacobian( const InputPointType & ipp, JacobianType & jacobian,
   NonZeroJacobianIndicesType & nonZeroJacobianIndices ) const
 {
-  /** Convert the physical point to a continuous index, which
-   * is needed for the 'Evaluate()' functions below.
+  /** Look up the 1D weights in the cache, or convert the physical point
+   * to a continuous index, which is needed for the 'Evaluate()' functions below.
    */
+  IndexType           supportIndex;
+  OneDWeightsType     cachedWeights1D;
   ContinuousIndexType cindex;
-  this->TransformPointToContinuousGridIndex( ipp, cindex );
+  bool                inside = true;
+  const bool          cached = this->LookupCachedWeights(
+    ipp, cachedWeights1D, NULL, supportIndex, inside );
+  if( !cached )
+  {
+    this->TransformPointToContinuousGridIndex( ipp, cindex );
+    inside = this->InsideValidRegion( cindex );
+  }
 
   /** Initialize. */
   const NumberOfParametersType nnzji = this->GetNumberOfNonZeroJacobianIndices();
@@ -142,7 +186,7 @@ RecursiveBSplineTransform< TScalar, NDimensions, VSplineOrder >
   /** NOTE: if the support region does not lie totally within the grid
    * we assume zero displacement and zero Jacobian.
    */
-  if( !this->InsideValidRegion( cindex ) )
+  if( !inside )
   {
     nonZeroJacobianIndices.resize( this->GetNumberOfNonZeroJacobianIndices() );
     for( NumberOfParametersType i = 0; i < this->GetNumberOfNonZeroJacobianIndices(); ++i )
@@ -159,8 +203,14 @@ RecursiveBSplineTransform< TScalar, NDimensions, VSplineOrder >
   const unsigned int numberOfWeights = RecursiveBSplineWeightFunctionType::NumberOfWeights;
   typename WeightsType::ValueType weightsArray1D[ numberOfWeights ];
   WeightsType weights1D( weightsArray1D, numberOfWeights, false );
-  IndexType   supportIndex;
-  this->m_RecursiveBSplineWeightFunction->Evaluate( cindex, weights1D, supportIndex );
+  if( cached )
+  {
+    std::copy( cachedWeights1D[ 0 ], cachedWeights1D[ 0 ] + numberOfWeights, weightsArray1D );
+  }
+  else
+  {
+    this->m_RecursiveBSplineWeightFunction->Evaluate( cindex, weights1D, supportIndex );
+  }
 
   /** Recursively compute the first numberOfIndices entries of the Jacobian.
    * They are directly written in the Jacobian matrix memory block.
@@ -194,17 +244,26 @@ RecursiveBSplineTransform< TScalar, NDimensions, VSplineOrder >
   DerivativeType & imageJacobian,
   NonZeroJacobianIndicesType & nonZeroJacobianIndices ) const
 {
-  /** Convert the physical point to a continuous index, which
-   * is needed for the 'Evaluate()' functions below.
+  /** Look up the 1D weights in the cache, or convert the physical point
+   * to a continuous index, which is needed for the 'Evaluate()' functions below.
    */
+  IndexType           supportIndex;
+  OneDWeightsType     cachedWeights1D;
   ContinuousIndexType cindex;
-  this->TransformPointToContinuousGridIndex( ipp, cindex );
+  bool                inside = true;
+  const bool          cached = this->LookupCachedWeights(
+    ipp, cachedWeights1D, NULL, supportIndex, inside );
+  if( !cached )
+  {
+    this->TransformPointToContinuousGridIndex( ipp, cindex );
+    inside = this->InsideValidRegion( cindex );
+  }
 
   /** NOTE: if the support region does not lie totally within the grid
    * we assume zero displacement and zero Jacobian.
    */
   const NumberOfParametersType nnzji = this->GetNumberOfNonZeroJacobianIndices();
-  if( !this->InsideValidRegion( cindex ) )
+  if( !inside )
   {
     nonZeroJacobianIndices.resize( nnzji );
     for( NumberOfParametersType i = 0; i < nnzji; ++i )
@@ -221,8 +280,14 @@ RecursiveBSplineTransform< TScalar, NDimensions, VSplineOrder >
   const unsigned int numberOfWeights = RecursiveBSplineWeightFunctionType::NumberOfWeights;
   typename WeightsType::ValueType weightsArray1D[ numberOfWeights ];
   WeightsType weights1D( weightsArray1D, numberOfWeights, false );
-  IndexType   supportIndex;
-  this->m_RecursiveBSplineWeightFunction->Evaluate( cindex, weights1D, supportIndex );
+  if( cached )
+  {
+    std::copy( cachedWeights1D[ 0 ], cachedWeights1D[ 0 ] + numberOfWeights, weightsArray1D );
+  }
+  else
+  {
+    this->m_RecursiveBSplineWeightFunction->Evaluate( cindex, weights1D, supportIndex );
+  }
 
   /** Recursively compute the inner product of the Jacobian and the moving image gradient.
    * The pointer has changed after this function call.
@@ -105,9 +105,21 @@ public:
   /** Array type for parameter vector instantiation. */
   typedef typename ParametersType::ArrayType ParametersArrayType;
 
+  /** Container types for TransformPoints(). */
+  typedef std::vector< InputPointType >  InputPointContainerType;
+  typedef std::vector< OutputPointType > OutputPointContainerType;
+
   /**  Method to transform a point. */
   virtual OutputPointType TransformPoint( const InputPointType & ipp ) const;
 
+  /** Batched stack evaluation: opps[ i ] is set to TransformPoint( ipps[ i ] ).
+   * Groupwise metrics map one spatial sample to several positions along the
+   * last dimension; subclasses may share work between such points.
+   */
+  virtual void TransformPoints(
+    const InputPointContainerType & ipps,
+    OutputPointContainerType & opps ) const;
+
   /** These vector transforms are not implemented for this transform. */
   virtual OutputVectorType TransformVector( const InputVectorType & ) const
   {
@@ -288,10 +300,24 @@ protected:
   StackTransform();
   virtual ~StackTransform() {}
 
-private:
+  /** Reduce the dimension of an input point. */
+  static void ReduceInputPoint(
+    const InputPointType & ipp, SubTransformInputPointType & ippr )
+  {
+    for( unsigned int d = 0; d < ReducedInputSpaceDimension; ++d )
+    {
+      ippr[ d ] = ipp[ d ];
+    }
+  }
+
+  /** Get the index of the sub transform that maps an input point. */
+  unsigned int ComputeSubTransformIndex( const InputPointType & ipp ) const
+  {
+    return vnl_math_min( this->m_NumberOfSubTransforms - 1, static_cast< unsigned int >(
+      vnl_math_max( 0,
+      vnl_math_rnd( ( ipp[ ReducedInputSpaceDimension ] - m_StackOrigin ) / m_StackSpacing ) ) ) );
+  }
 
-  StackTransform( const Self & );  // purposely not implemented
-  void operator=( const Self & );  // purposely not implemented
 
   // Number of transforms and transform container
   unsigned int              m_NumberOfSubTransforms;
@@ -300,6 +326,11 @@ private:
   // Stack spacing and origin of last dimension
   TScalarType m_StackSpacing, m_StackOrigin;
 
+private:
+
+  StackTransform( const Self & );  // purposely not implemented
+  void operator=( const Self & );  // purposely not implemented
+
 };
 
 } // end namespace itk
@@ -107,17 +107,11 @@ StackTransform< TScalarType, NInputDimensions, NOutputDimensions >
 {
   /** Reduce dimension of input point. */
   SubTransformInputPointType ippr;
-  for( unsigned int d = 0; d < ReducedInputSpaceDimension; ++d )
-  {
-    ippr[ d ] = ipp[ d ];
-  }
+  Self::ReduceInputPoint( ipp, ippr );
 
   /** Transform point using right subtransform. */
   SubTransformOutputPointType oppr;
-  const unsigned int          subt
-    = vnl_math_min( this->m_NumberOfSubTransforms - 1, static_cast< unsigned int >(
-      vnl_math_max( 0,
-      vnl_math_rnd( ( ipp[ ReducedInputSpaceDimension ] - m_StackOrigin ) / m_StackSpacing ) ) ) );
+  const unsigned int          subt = this->ComputeSubTransformIndex( ipp );
   oppr = this->m_SubTransformContainer[ subt ]->TransformPoint( ippr );
 
   /** Increase dimension of input point. */
@@ -133,6 +127,26 @@ StackTransform< TScalarType, NInputDimensions, NOutputDimensions >
 } // end TransformPoint()
 
 
+/**
+ * ********************* TransformPoints ****************************
+ */
+
+template< class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions >
+void
+StackTransform< TScalarType, NInputDimensions, NOutputDimensions >
+::TransformPoints(
+  const InputPointContainerType & ipps,
+  OutputPointContainerType & opps ) const
+{
+  opps.resize( ipps.size() );
+  for( std::size_t i = 0; i < ipps.size(); ++i )
+  {
+    opps[ i ] = this->TransformPoint( ipps[ i ] );
+  }
+
+} // end TransformPoints()
+
+
 /**
  * ********************* GetJacobian ****************************
  */
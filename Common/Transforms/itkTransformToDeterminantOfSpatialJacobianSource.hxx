@@ -38,7 +38,7 @@
 
 #include "itkAdvancedIdentityTransform.h"
 #include "itkProgressReporter.h"
-#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageScanlineIterator.h"
 #include "vnl/vnl_det.h"
 
 namespace itk
@@ -245,32 +245,39 @@ TransformToDeterminantOfSpatialJacobianSource< TOutputImage, TTransformPrecision
   OutputImagePointer outputPtr = this->GetOutput();
 
   // Create an iterator that will walk the output region for this thread.
-  typedef ImageRegionIteratorWithIndex< TOutputImage > OutputIteratorType;
+  typedef ImageScanlineIterator< TOutputImage > OutputIteratorType;
   OutputIteratorType it( outputPtr, outputRegionForThread );
   it.GoToBegin();
 
-  // pixel coordinates
+  // pixel coordinates, and the physical step of one voxel along a scanline
   PointType point;
+  const VectorType scanlineStep = this->ComputeScanlineStep( outputPtr );
 
   // Support for progress methods/callbacks
   ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
 
+  SpatialJacobianType sj;
+
   // Walk the output region
   while( !it.IsAtEnd() )
   {
-    // Determine the coordinates of the current voxel
+    // Determine the coordinates of the first voxel of this line
     outputPtr->TransformIndexToPhysicalPoint( it.GetIndex(), point );
 
-    SpatialJacobianType sj;
-    this->m_Transform->GetSpatialJacobian( point, sj );
-    const PixelType detjac = static_cast< PixelType >( vnl_det( sj.GetVnlMatrix() ) );
+    while( !it.IsAtEndOfLine() )
+    {
+      this->m_Transform->GetSpatialJacobian( point, sj );
+      const PixelType detjac = static_cast< PixelType >( vnl_det( sj.GetVnlMatrix() ) );
 
-    // Set it
-    it.Set( detjac );
+      // Set it
+      it.Set( detjac );
 
-    // Update progress and iterator
-    progress.CompletedPixel();
-    ++it;
+      // Update progress, coordinates and iterator
+      progress.CompletedPixel();
+      point += scanlineStep;
+      ++it;
+    }
+    it.NextLine();
   }
 
 } // end NonlinearThreadedGenerateData()
@@ -301,6 +308,28 @@ TransformToDeterminantOfSpatialJacobianSource< TOutputImage, TTransformPrecision
 } // end LinearThreadedGenerateData()
 
 
+/**
+ * Compute the physical step of one voxel along the first dimension.
+ */
+template< class TOutputImage, class TTransformPrecisionType >
+typename TransformToDeterminantOfSpatialJacobianSource< TOutputImage, TTransformPrecisionType >
+::VectorType
+TransformToDeterminantOfSpatialJacobianSource< TOutputImage, TTransformPrecisionType >
+::ComputeScanlineStep( const OutputImageType * outputPtr ) const
+{
+  IndexType index0 = outputPtr->GetRequestedRegion().GetIndex();
+  IndexType index1 = index0;
+  ++index1[ 0 ];
+
+  PointType point0, point1;
+  outputPtr->TransformIndexToPhysicalPoint( index0, point0 );
+  outputPtr->TransformIndexToPhysicalPoint( index1, point1 );
+
+  return point1 - point0;
+
+} // end ComputeScanlineStep()
+
+
 /**
  * Inform pipeline of required output region
  */
@@ -323,7 +352,9 @@ TransformToDeterminantOfSpatialJacobianSource< TOutputImage, TTransformPrecision
   outputPtr->SetSpacing( m_OutputSpacing );
   outputPtr->SetOrigin( m_OutputOrigin );
   outputPtr->SetDirection( m_OutputDirection );
-  outputPtr->Allocate();
+
+  // NOTE: the output is not allocated here, but by the pipeline for the
+  // requested region only. This allows streaming the output to a file.
 
 } // end GenerateOutputInformation()
 
@@ -104,6 +104,7 @@ public:
   typedef typename RegionType::SizeType           SizeType;
   typedef typename OutputImageType::IndexType     IndexType;
   typedef typename OutputImageType::PointType     PointType;
+  typedef typename PointType::VectorType          VectorType;
   typedef typename OutputImageType::SpacingType   SpacingType;
   typedef typename OutputImageType::PointType     OriginType;
   typedef typename OutputImageType::DirectionType DirectionType;
@@ -194,6 +195,9 @@ protected:
     const OutputImageRegionType & outputRegionForThread,
     ThreadIdType threadId );
 
+  /** Compute the physical step of one voxel along a scanline. */
+  VectorType ComputeScanlineStep( const OutputImageType * outputPtr ) const;
+
   /** Faster implementation for resampling that works for with linear
    *  transformation types. Unthreaded.
    */
@@ -22,7 +22,7 @@
 
 #include "itkAdvancedIdentityTransform.h"
 #include "itkProgressReporter.h"
-#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageScanlineIterator.h"
 #include "vnl/vnl_copy.h"
 
 namespace itk
@@ -240,12 +240,13 @@ TransformToSpatialJacobianSource< TOutputImage, TTransformPrecisionType >
   OutputImagePointer outputPtr = this->GetOutput();
 
   // Create an iterator that will walk the output region for this thread.
-  typedef ImageRegionIteratorWithIndex< TOutputImage > OutputIteratorType;
+  typedef ImageScanlineIterator< TOutputImage > OutputIteratorType;
   OutputIteratorType it( outputPtr, outputRegionForThread );
   it.GoToBegin();
 
-  // pixel coordinates
+  // pixel coordinates, and the physical step of one voxel along a scanline
   PointType point;
+  const VectorType scanlineStep = this->ComputeScanlineStep( outputPtr );
 
   // Support for progress methods/callbacks
   ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
@@ -257,21 +258,26 @@ TransformToSpatialJacobianSource< TOutputImage, TTransformPrecisionType >
   // Walk the output region
   while( !it.IsAtEnd() )
   {
-    // Determine the coordinates of the current voxel
+    // Determine the coordinates of the first voxel of this line
     outputPtr->TransformIndexToPhysicalPoint( it.GetIndex(), point );
 
-    this->m_Transform->GetSpatialJacobian( point, sj );
+    while( !it.IsAtEndOfLine() )
+    {
+      this->m_Transform->GetSpatialJacobian( point, sj );
 
-    // cast spatial jacobian to output pixel type
-    vnl_copy( sj.GetVnlMatrix().begin(), sjOut.GetVnlMatrix().begin(),
-      nrElements );
+      // cast spatial jacobian to output pixel type
+      vnl_copy( sj.GetVnlMatrix().begin(), sjOut.GetVnlMatrix().begin(),
+        nrElements );
 
-    // Set it
-    it.Set( sjOut );
+      // Set it
+      it.Set( sjOut );
 
-    // Update progress and iterator
-    progress.CompletedPixel();
-    ++it;
+      // Update progress, coordinates and iterator
+      progress.CompletedPixel();
+      point += scanlineStep;
+      ++it;
+    }
+    it.NextLine();
   }
 
 } // end NonlinearThreadedGenerateData()
@@ -308,6 +314,28 @@ TransformToSpatialJacobianSource< TOutputImage, TTransformPrecisionType >
 } // end LinearThreadedGenerateData()
 
 
+/**
+ * Compute the physical step of one voxel along the first dimension.
+ */
+template< class TOutputImage, class TTransformPrecisionType >
+typename TransformToSpatialJacobianSource< TOutputImage, TTransformPrecisionType >
+::VectorType
+TransformToSpatialJacobianSource< TOutputImage, TTransformPrecisionType >
+::ComputeScanlineStep( const OutputImageType * outputPtr ) const
+{
+  IndexType index0 = outputPtr->GetRequestedRegion().GetIndex();
+  IndexType index1 = index0;
+  ++index1[ 0 ];
+
+  PointType point0, point1;
+  outputPtr->TransformIndexToPhysicalPoint( index0, point0 );
+  outputPtr->TransformIndexToPhysicalPoint( index1, point1 );
+
+  return point1 - point0;
+
+} // end ComputeScanlineStep()
+
+
 /**
  * Inform pipeline of required output region
  */
@@ -330,7 +358,9 @@ TransformToSpatialJacobianSource< TOutputImage, TTransformPrecisionType >
   outputPtr->SetSpacing( m_OutputSpacing );
   outputPtr->SetOrigin( m_OutputOrigin );
   outputPtr->SetDirection( m_OutputDirection );
-  outputPtr->Allocate();
+
+  // NOTE: the output is not allocated here, but by the pipeline for the
+  // requested region only. This allows streaming the output to a file.
 
 } // end GenerateOutputInformation()
 
@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkBSplineCoefficientImageCache_h
+#define __itkBSplineCoefficientImageCache_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkDataObject.h"
+#include "itkImageBase.h"
+#include "itkCommand.h"
+#include "itkSimpleFastMutexLock.h"
+#include <list>
+#include <vector>
+
+namespace itk
+{
+
+/** \class BSplineCoefficientImageCache
+ * \brief Process-wide store of B-spline coefficient images.
+ *
+ * B-spline interpolators decompose their input image into coefficients
+ * whenever SetInputImage() is called. When several interpolators are
+ * connected to the same image, the same decomposition is computed again.
+ * This class stores the coefficient images, so that they are computed only
+ * once. In elastix this happens for the metrics of a multi-metric
+ * registration that use the same moving image, and for the final
+ * resamplers of subsequent parameter files. The metrics and the final
+ * resampler never share an entry: the metrics interpolate the images of
+ * the moving pyramid, the resampler the original moving image.
+ *
+ * An entry is identified by the address and the modified time of the
+ * input image, together with the spline order in each dimension. The
+ * modified time changes whenever the image data is (re)generated, so a
+ * stale entry is never returned, even if the address is recycled. Whenever
+ * a new entry is inserted, the entries of images that were modified since,
+ * or whose data was released, are removed.
+ *
+ * The number of entries is bounded; when the bound is exceeded the least
+ * recently used entry is removed. The entries keep the coefficient images
+ * alive, but not the input images: an entry is removed as soon as its
+ * input image is deleted, so the coefficients of images that no longer
+ * exist are not kept.
+ *
+ * Note that the levels of the moving pyramid are separate images that live
+ * as long as the pyramid, so the coefficients of earlier resolutions are
+ * not removed when their image is deleted. With ComputePyramidImagesPerResolution
+ * the pyramid releases the data of the earlier level, and its coefficients
+ * are removed when the next resolution inserts its own entry. Without it,
+ * all levels keep their data, and their coefficients stay in the cache
+ * until they are pushed out by the bound.
+ *
+ * There is one instance per coefficient image type, obtained with
+ * GetInstance(). All public methods are thread-safe.
+ *
+ * \ingroup ImageFunctions
+ */
+
+template< class TCoefficientImage >
+class BSplineCoefficientImageCache : public Object
+{
+public:
+
+  /** Standard ITK-stuff. */
+  typedef BSplineCoefficientImageCache Self;
+  typedef Object                       Superclass;
+  typedef SmartPointer< Self >         Pointer;
+  typedef SmartPointer< const Self >   ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro( BSplineCoefficientImageCache, Object );
+
+  /** Return the single instance for this coefficient image type. */
+  static Pointer GetInstance( void );
+
+  /** Typedefs. */
+  typedef TCoefficientImage                           CoefficientImageType;
+  typedef typename CoefficientImageType::ConstPointer CoefficientImageConstPointer;
+  typedef std::vector< unsigned int >                 SplineOrderArrayType;
+
+  /** Look up the coefficients of the given image. Returns a null pointer
+   * if they are not in the cache.
+   */
+  CoefficientImageConstPointer Find( const DataObject * image,
+    const SplineOrderArrayType & splineOrders );
+
+  /** Store the coefficients of the given image. The coefficient image
+   * should not be connected to a pipeline anymore, since a pipeline
+   * update would silently overwrite the cached data.
+   */
+  void Insert( const DataObject * image,
+    const SplineOrderArrayType & splineOrders,
+    const CoefficientImageType * coefficients );
+
+  /** Remove all entries. */
+  void Clear( void );
+
+  /** Get the number of entries. */
+  unsigned int GetNumberOfEntries( void ) const;
+
+  /** Set/Get the maximum number of entries. Default: 4. */
+  void SetMaximumNumberOfEntries( unsigned int arg );
+  itkGetConstMacro( MaximumNumberOfEntries, unsigned int );
+
+protected:
+
+  BSplineCoefficientImageCache();
+  virtual ~BSplineCoefficientImageCache();
+
+  /** PrintSelf. */
+  void PrintSelf( std::ostream & os, Indent indent ) const;
+
+private:
+
+  BSplineCoefficientImageCache( const Self & ); // purposely not implemented
+  void operator=( const Self & );               // purposely not implemented
+
+  /** An entry of the cache. The image is observed, so that the entry is
+   * removed when the image is deleted; ObserverTag identifies the observer.
+   */
+  struct EntryType
+  {
+    const DataObject *           Image;
+    unsigned long                ImageMTime;
+    unsigned long                ObserverTag;
+    SplineOrderArrayType         SplineOrders;
+    CoefficientImageConstPointer Coefficients;
+  };
+
+  typedef std::list< EntryType > EntryContainerType;
+  typedef MemberCommand< Self >  DeleteCommandType;
+
+  /** Remove the entries of images that were modified since they were
+   * inserted, or whose data was released.
+   */
+  void RemoveStaleEntries( void );
+
+  /** Remove the least recently used entries until the bound is met. */
+  void Prune( void );
+
+  /** Stop observing the image of an entry that is removed. */
+  void StopObserving( const EntryType & entry );
+
+  /** Called when an image with an entry is deleted; removes its entries. */
+  void ImageDeleted( const Object * caller, const EventObject & event );
+
+  /** The entries, most recently used first. */
+  EntryContainerType                  m_Entries;
+  unsigned int                        m_MaximumNumberOfEntries;
+  mutable SimpleFastMutexLock         m_Mutex;
+  typename DeleteCommandType::Pointer m_DeleteCommand;
+
+  /** The single instance, and the lock that guards its creation. */
+  static Pointer             m_Instance;
+  static SimpleFastMutexLock m_InstanceMutex;
+
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBSplineCoefficientImageCache.hxx"
+#endif
+
+#endif // end #ifndef __itkBSplineCoefficientImageCache_h
@@ -0,0 +1,347 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkBSplineCoefficientImageCache_hxx
+#define __itkBSplineCoefficientImageCache_hxx
+
+#include "itkBSplineCoefficientImageCache.h"
+
+namespace itk
+{
+
+template< class TCoefficientImage >
+typename BSplineCoefficientImageCache< TCoefficientImage >::Pointer
+BSplineCoefficientImageCache< TCoefficientImage >::m_Instance = 0;
+
+template< class TCoefficientImage >
+SimpleFastMutexLock
+BSplineCoefficientImageCache< TCoefficientImage >::m_InstanceMutex;
+
+/**
+ * ******************* Constructor *******************
+ */
+
+template< class TCoefficientImage >
+BSplineCoefficientImageCache< TCoefficientImage >
+::BSplineCoefficientImageCache()
+{
+  this->m_MaximumNumberOfEntries = 4;
+  this->m_DeleteCommand          = DeleteCommandType::New();
+  this->m_DeleteCommand->SetCallbackFunction( this, &Self::ImageDeleted );
+
+} // end Constructor
+
+
+/**
+ * ******************* Destructor *******************
+ */
+
+template< class TCoefficientImage >
+BSplineCoefficientImageCache< TCoefficientImage >
+::~BSplineCoefficientImageCache()
+{
+  /** Stop observing the images that still have an entry. */
+  this->Clear();
+
+} // end Destructor
+
+
+/**
+ * ******************* GetInstance *******************
+ */
+
+template< class TCoefficientImage >
+typename BSplineCoefficientImageCache< TCoefficientImage >::Pointer
+BSplineCoefficientImageCache< TCoefficientImage >
+::GetInstance( void )
+{
+  /** Interpolators of different threads may ask for the instance at the
+   * same time, so its creation is guarded.
+   */
+  Self::m_InstanceMutex.Lock();
+  if( !Self::m_Instance )
+  {
+    Self::m_Instance = new Self;
+    /** Remove extra reference from construction. */
+    Self::m_Instance->UnRegister();
+  }
+  Pointer instance = Self::m_Instance;
+  Self::m_InstanceMutex.Unlock();
+
+  return instance;
+
+} // end GetInstance()
+
+
+/**
+ * ******************* Find *******************
+ */
+
+template< class TCoefficientImage >
+typename BSplineCoefficientImageCache< TCoefficientImage >::CoefficientImageConstPointer
+BSplineCoefficientImageCache< TCoefficientImage >
+::Find( const DataObject * image, const SplineOrderArrayType & splineOrders )
+{
+  CoefficientImageConstPointer coefficients = 0;
+  if( !image ) { return coefficients; }
+
+  const unsigned long mtime = image->GetMTime();
+
+  this->m_Mutex.Lock();
+  typename EntryContainerType::iterator it = this->m_Entries.begin();
+  for(; it != this->m_Entries.end(); ++it )
+  {
+    if( it->Image == image && it->ImageMTime == mtime
+      && it->SplineOrders == splineOrders )
+    {
+      coefficients = it->Coefficients;
+
+      /** Move the entry to the front, marking it most recently used. */
+      this->m_Entries.splice( this->m_Entries.begin(), this->m_Entries, it );
+      break;
+    }
+  }
+  this->m_Mutex.Unlock();
+
+  return coefficients;
+
+} // end Find()
+
+
+/**
+ * ******************* Insert *******************
+ */
+
+template< class TCoefficientImage >
+void
+BSplineCoefficientImageCache< TCoefficientImage >
+::Insert( const DataObject * image, const SplineOrderArrayType & splineOrders,
+  const CoefficientImageType * coefficients )
+{
+  if( !image || !coefficients ) { return; }
+
+  EntryType entry;
+  entry.Image        = image;
+  entry.ImageMTime   = image->GetMTime();
+  entry.SplineOrders = splineOrders;
+  entry.Coefficients = coefficients;
+
+  this->m_Mutex.Lock();
+  entry.ObserverTag = image->AddObserver( DeleteEvent(), this->m_DeleteCommand );
+
+  /** Replace an existing entry of the same image and spline orders;
+   * it is outdated, otherwise it would have been found.
+   */
+  typename EntryContainerType::iterator it = this->m_Entries.begin();
+  while( it != this->m_Entries.end() )
+  {
+    if( it->Image == image && it->SplineOrders == splineOrders )
+    {
+      this->StopObserving( *it );
+      it = this->m_Entries.erase( it );
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  this->RemoveStaleEntries();
+  this->m_Entries.push_front( entry );
+  this->Prune();
+
+  this->m_Mutex.Unlock();
+
+} // end Insert()
+
+
+/**
+ * ******************* Clear *******************
+ */
+
+template< class TCoefficientImage >
+void
+BSplineCoefficientImageCache< TCoefficientImage >
+::Clear( void )
+{
+  this->m_Mutex.Lock();
+  typename EntryContainerType::const_iterator it = this->m_Entries.begin();
+  for(; it != this->m_Entries.end(); ++it )
+  {
+    this->StopObserving( *it );
+  }
+  this->m_Entries.clear();
+  this->m_Mutex.Unlock();
+
+} // end Clear()
+
+
+/**
+ * ******************* GetNumberOfEntries *******************
+ */
+
+template< class TCoefficientImage >
+unsigned int
+BSplineCoefficientImageCache< TCoefficientImage >
+::GetNumberOfEntries( void ) const
+{
+  this->m_Mutex.Lock();
+  const unsigned int numberOfEntries
+    = static_cast< unsigned int >( this->m_Entries.size() );
+  this->m_Mutex.Unlock();
+
+  return numberOfEntries;
+
+} // end GetNumberOfEntries()
+
+
+/**
+ * ******************* SetMaximumNumberOfEntries *******************
+ */
+
+template< class TCoefficientImage >
+void
+BSplineCoefficientImageCache< TCoefficientImage >
+::SetMaximumNumberOfEntries( unsigned int arg )
+{
+  this->m_Mutex.Lock();
+  const bool changed = ( arg != this->m_MaximumNumberOfEntries );
+  this->m_MaximumNumberOfEntries = arg;
+  this->Prune();
+  this->m_Mutex.Unlock();
+
+  if( changed ) { this->Modified(); }
+
+} // end SetMaximumNumberOfEntries()
+
+
+/**
+ * ******************* RemoveStaleEntries *******************
+ */
+
+template< class TCoefficientImage >
+void
+BSplineCoefficientImageCache< TCoefficientImage >
+::RemoveStaleEntries( void )
+{
+  /** The images are alive: otherwise their entries would have been removed.
+   * Releasing the data of an image, as a pyramid does with the levels it
+   * does not compute, empties its buffered region but keeps its MTime.
+   */
+  typedef ImageBase< CoefficientImageType::ImageDimension > ImageBaseType;
+  typename EntryContainerType::iterator it = this->m_Entries.begin();
+  while( it != this->m_Entries.end() )
+  {
+    const ImageBaseType * image = dynamic_cast< const ImageBaseType * >( it->Image );
+    if( it->Image->GetMTime() != it->ImageMTime
+      || ( image && image->GetBufferedRegion().GetNumberOfPixels() == 0 ) )
+    {
+      this->StopObserving( *it );
+      it = this->m_Entries.erase( it );
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+} // end RemoveStaleEntries()
+
+
+/**
+ * ******************* Prune *******************
+ */
+
+template< class TCoefficientImage >
+void
+BSplineCoefficientImageCache< TCoefficientImage >
+::Prune( void )
+{
+  while( this->m_Entries.size() > this->m_MaximumNumberOfEntries )
+  {
+    this->StopObserving( this->m_Entries.back() );
+    this->m_Entries.pop_back();
+  }
+
+} // end Prune()
+
+
+/**
+ * ******************* StopObserving *******************
+ */
+
+template< class TCoefficientImage >
+void
+BSplineCoefficientImageCache< TCoefficientImage >
+::StopObserving( const EntryType & entry )
+{
+  /** The image is alive: otherwise its entry would have been removed. */
+  const_cast< DataObject * >( entry.Image )->RemoveObserver( entry.ObserverTag );
+
+} // end StopObserving()
+
+
+/**
+ * ******************* ImageDeleted *******************
+ */
+
+template< class TCoefficientImage >
+void
+BSplineCoefficientImageCache< TCoefficientImage >
+::ImageDeleted( const Object * caller, const EventObject & )
+{
+  /** The image is being destroyed, so its observers need not be removed. */
+  this->m_Mutex.Lock();
+  typename EntryContainerType::iterator it = this->m_Entries.begin();
+  while( it != this->m_Entries.end() )
+  {
+    if( static_cast< const Object * >( it->Image ) == caller )
+    {
+      it = this->m_Entries.erase( it );
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  this->m_Mutex.Unlock();
+
+} // end ImageDeleted()
+
+
+/**
+ * ******************* PrintSelf *******************
+ */
+
+template< class TCoefficientImage >
+void
+BSplineCoefficientImageCache< TCoefficientImage >
+::PrintSelf( std::ostream & os, Indent indent ) const
+{
+  Superclass::PrintSelf( os, indent );
+
+  os << indent << "MaximumNumberOfEntries: "
+     << this->m_MaximumNumberOfEntries << std::endl;
+  os << indent << "NumberOfEntries: "
+     << this->m_Entries.size() << std::endl;
+
+} // end PrintSelf()
+
+
+} // end namespace itk
+
+#endif // end #ifndef __itkBSplineCoefficientImageCache_hxx
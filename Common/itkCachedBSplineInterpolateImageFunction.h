@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkCachedBSplineInterpolateImageFunction_h
+#define __itkCachedBSplineInterpolateImageFunction_h
+
+#include "itkBSplineInterpolateImageFunction.h"
+#include "itkBSplineCoefficientImageCache.h"
+
+namespace itk
+{
+
+/** \class CachedBSplineInterpolateImageFunction
+ * \brief A BSplineInterpolateImageFunction that can share its coefficients.
+ *
+ * When UseCoefficientCache is on, the B-spline coefficients of the input
+ * image are looked up in the BSplineCoefficientImageCache before they are
+ * computed, and stored there afterwards. Interpolators connected to the
+ * same image with the same spline order then decompose it only once.
+ *
+ * With UseCoefficientCache off (the default) this class behaves exactly
+ * like its superclass.
+ *
+ * \sa BSplineCoefficientImageCache
+ * \ingroup ImageFunctions
+ */
+
+template< class TImageType, class TCoordRep = double, class TCoefficientType = double >
+class CachedBSplineInterpolateImageFunction :
+  public BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
+{
+public:
+
+  /** Standard ITK-stuff. */
+  typedef CachedBSplineInterpolateImageFunction Self;
+  typedef BSplineInterpolateImageFunction<
+    TImageType, TCoordRep, TCoefficientType > Superclass;
+  typedef SmartPointer< Self >                Pointer;
+  typedef SmartPointer< const Self >          ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro( Self );
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro( CachedBSplineInterpolateImageFunction, BSplineInterpolateImageFunction );
+
+  /** Dimension underlying input image. */
+  itkStaticConstMacro( ImageDimension, unsigned int, Superclass::ImageDimension );
+
+  /** Typedefs inherited from the superclass. */
+  typedef typename Superclass::InputImageType       InputImageType;
+  typedef typename Superclass::CoefficientImageType CoefficientImageType;
+  typedef typename Superclass::CoefficientFilter    CoefficientFilter;
+
+  /** Typedef for the cache. */
+  typedef BSplineCoefficientImageCache< CoefficientImageType > CoefficientImageCacheType;
+
+  /** Set the input image, reusing cached coefficients if possible. */
+  virtual void SetInputImage( const TImageType * inputData );
+
+  /** Set/Get whether the coefficients are shared through the cache. */
+  itkSetMacro( UseCoefficientCache, bool );
+  itkGetConstMacro( UseCoefficientCache, bool );
+  itkBooleanMacro( UseCoefficientCache );
+
+protected:
+
+  CachedBSplineInterpolateImageFunction();
+  virtual ~CachedBSplineInterpolateImageFunction() {}
+
+  /** PrintSelf. */
+  void PrintSelf( std::ostream & os, Indent indent ) const;
+
+private:
+
+  CachedBSplineInterpolateImageFunction( const Self & ); // purposely not implemented
+  void operator=( const Self & );                        // purposely not implemented
+
+  bool m_UseCoefficientCache;
+
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkCachedBSplineInterpolateImageFunction.hxx"
+#endif
+
+#endif // end #ifndef __itkCachedBSplineInterpolateImageFunction_h
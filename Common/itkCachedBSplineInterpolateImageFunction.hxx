@@ -0,0 +1,106 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkCachedBSplineInterpolateImageFunction_hxx
+#define __itkCachedBSplineInterpolateImageFunction_hxx
+
+#include "itkCachedBSplineInterpolateImageFunction.h"
+
+namespace itk
+{
+
+/**
+ * ******************* Constructor *******************
+ */
+
+template< class TImageType, class TCoordRep, class TCoefficientType >
+CachedBSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
+::CachedBSplineInterpolateImageFunction()
+{
+  this->m_UseCoefficientCache = false;
+
+} // end Constructor
+
+
+/**
+ * ******************* SetInputImage *******************
+ */
+
+template< class TImageType, class TCoordRep, class TCoefficientType >
+void
+CachedBSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
+::SetInputImage( const TImageType * inputData )
+{
+  if( !inputData || !this->m_UseCoefficientCache )
+  {
+    this->Superclass::SetInputImage( inputData );
+    return;
+  }
+
+  typename CoefficientImageCacheType::Pointer cache
+    = CoefficientImageCacheType::GetInstance();
+  const typename CoefficientImageCacheType::SplineOrderArrayType
+    splineOrders( ImageDimension, static_cast< unsigned int >( this->GetSplineOrder() ) );
+
+  typename CoefficientImageType::ConstPointer coefficients
+    = cache->Find( inputData, splineOrders );
+  if( coefficients.IsNull()
+    || coefficients->GetBufferedRegion() != inputData->GetBufferedRegion() )
+  {
+    /** Compute the coefficients with a private filter, whose output is
+     * disconnected, so that the cached image is never overwritten by a
+     * later update of the superclass' coefficient filter.
+     */
+    typename CoefficientFilter::Pointer filter = CoefficientFilter::New();
+    filter->SetSplineOrder( this->GetSplineOrder() );
+    filter->SetInput( inputData );
+    filter->Update();
+    typename CoefficientImageType::Pointer output = filter->GetOutput();
+    output->DisconnectPipeline();
+
+    cache->Insert( inputData, splineOrders, output );
+    coefficients = output;
+  }
+
+  /** Do what the superclass does, without running its coefficient filter. */
+  this->m_Coefficients = coefficients;
+  this->Superclass::Superclass::SetInputImage( inputData );
+  this->m_DataLength = inputData->GetBufferedRegion().GetSize();
+
+} // end SetInputImage()
+
+
+/**
+ * ******************* PrintSelf *******************
+ */
+
+template< class TImageType, class TCoordRep, class TCoefficientType >
+void
+CachedBSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
+::PrintSelf( std::ostream & os, Indent indent ) const
+{
+  Superclass::PrintSelf( os, indent );
+
+  os << indent << "UseCoefficientCache: "
+     << ( this->m_UseCoefficientCache ? "true" : "false" ) << std::endl;
+
+} // end PrintSelf()
+
+
+} // end namespace itk
+
+#endif // end #ifndef __itkCachedBSplineInterpolateImageFunction_hxx
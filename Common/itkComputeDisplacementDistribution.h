@@ -21,6 +21,7 @@
 #include "itkScaledSingleValuedNonLinearOptimizer.h"
 
 #include "itkImageGridSampler.h"
+#include "itkJacobianTermsKernel.h"
 #include "itkImageRandomSamplerBase.h"
 #include "itkImageRandomCoordinateSampler.h"
 #include "itkImageFullSampler.h"
@@ -175,9 +176,10 @@ protected:
   typedef typename TransformType::ScalarType             CoordinateRepresentationType;
   typedef typename TransformType::NumberOfParametersType NumberOfParametersType;
 
+  /** Shared sampling and per-sample kernels. */
+  typedef JacobianTermsKernel< FixedImageType, TransformType > JacobianTermsKernelType;
+
   /** Sample the fixed image to compute the Jacobian terms. */
-  // \todo: note that this is an exact copy of itk::ComputeJacobianTerms
-  // in the future it would be better to refactoring this part of the code
   virtual void SampleFixedImageForJacobianTerms(
     ImageSampleContainerPointer & sampleContainer );
 
@@ -175,12 +175,9 @@ ComputeDisplacementDistribution< TFixedImage, TTransform >
   /**
    * Compute maxJJ and jac*gradient
    */
-  DerivativeType Jgg( outdim );
-  Jgg.Fill( 0.0 );
   std::vector< double > JGG_k;
-  double                globalDeformation = 0.0;
-  const double          sqrt2             = vcl_sqrt( static_cast< double >( 2.0 ) );
-  JacobianType          jacjjacj( outdim, outdim );
+  JGG_k.reserve( nrofsamples );
+  double globalDeformation = 0.0;
 
   samplenr = 0;
   for( iter = begin; iter != end; ++iter )
@@ -192,37 +189,18 @@ ComputeDisplacementDistribution< TFixedImage, TTransform >
     /** Apply scales, if necessary. */
     if( this->GetUseScales() )
     {
-      for( unsigned int pi = 0; pi < sizejacind; ++pi )
-      {
-        const unsigned int p = jacind[ pi ];
-        jacj.scale_column( pi, 1.0 / scales[ p ] );
-      }
+      JacobianTermsKernelType::ApplyScales( scales, jacind, jacj );
     }
 
-    /** Compute 1st part of JJ: ||J_j||_F^2. */
-    double JJ_j = vnl_math_sqr( jacj.frobenius_norm() );
+    /** Max_j [JJ_j], with JJ_j = ||J_j||_F^2 + 2\sqrt{2} || J_j J_j^T ||_F. */
+    maxJJ = vnl_math_max( maxJJ, JacobianTermsKernelType::ComputeJJ( jacj ) );
 
-    /** Compute 2nd part of JJ: 2\sqrt{2} || J_j J_j^T ||_F. */
-    vnl_fastops::ABt( jacjjacj, jacj, jacj );
-    JJ_j += 2.0 * sqrt2 * jacjjacj.frobenius_norm();
+    /** Compute the magnitude of jac*gradient. */
+    const double jggMagnitude = JacobianTermsKernelType::ComputeDisplacementMagnitude(
+      jacj, jacind, this->m_ExactGradient );
 
-    /** Max_j [JJ_j]. */
-    maxJJ = vnl_math_max( maxJJ, JJ_j );
-
-    /** Compute the matrix of jac*gradient */
-    for( unsigned int i = 0; i < outdim; ++i )
-    {
-      double temp = 0.0;
-      for( unsigned int j = 0; j < sizejacind; ++j )
-      {
-        int pj = jacind[ j ];
-        temp += jacj( i, j ) * this->m_ExactGradient( pj );
-      }
-      Jgg( i ) = temp;
-    }
-
-    globalDeformation += Jgg.magnitude();
-    JGG_k.push_back( Jgg.magnitude() );
+    globalDeformation += jggMagnitude;
+    JGG_k.push_back( jggMagnitude );
     ++samplenr;
 
   } // end loop over sample container
@@ -390,14 +368,10 @@ ComputeDisplacementDistribution< TFixedImage, TTransform >
 
   /** Temporaries. */
   //std::vector< double > JGG_k; not here so only mean + 2 sigma is supported
-  DerivativeType Jgg( outdim ); Jgg.Fill( 0.0 );
-  const double   sqrt2 = vcl_sqrt( static_cast< double >( 2.0 ) );
-  JacobianType   jacjjacj( outdim, outdim );
-  double         maxJJ                 = 0.0;
-  double         jggMagnitude          = 0.0;
-  double         displacement          = 0.0;
-  double         displacementSquared   = 0.0;
-  unsigned long  numberOfPixelsCounted = 0;
+  double        maxJJ                 = 0.0;
+  double        displacement          = 0.0;
+  double        displacementSquared   = 0.0;
+  unsigned long numberOfPixelsCounted = 0;
 
   /** Create iterator over the sample container. */
   typename ImageSampleContainerType::ConstIterator threader_fiter;
@@ -417,37 +391,17 @@ ComputeDisplacementDistribution< TFixedImage, TTransform >
     /** Apply scales, if necessary. */
     if( this->GetUseScales() )
     {
-      for( unsigned int pi = 0; pi < sizejacind; ++pi )
-      {
-        const unsigned int p = jacind[ pi ];
-        jacj.scale_column( pi, 1.0 / scales[ p ] );
-      }
+      JacobianTermsKernelType::ApplyScales( scales, jacind, jacj );
     }
 
-    /** Compute 1st part of JJ: ||J_j||_F^2. */
-    double JJ_j = vnl_math_sqr( jacj.frobenius_norm() );
+    /** Max_j [JJ_j], with JJ_j = ||J_j||_F^2 + 2\sqrt{2} || J_j J_j^T ||_F. */
+    maxJJ = vnl_math_max( maxJJ, JacobianTermsKernelType::ComputeJJ( jacj ) );
 
-    /** Compute 2nd part of JJ: 2\sqrt{2} || J_j J_j^T ||_F. */
-    vnl_fastops::ABt( jacjjacj, jacj, jacj ); // is this thread-safe?
-    JJ_j += 2.0 * sqrt2 * jacjjacj.frobenius_norm();
-
-    /** Max_j [JJ_j]. */
-    maxJJ = vnl_math_max( maxJJ, JJ_j );
-
-    /** Compute the displacement  jac * gradient. */
-    for( unsigned int i = 0; i < outdim; ++i )
-    {
-      double temp = 0.0;
-      for( unsigned int j = 0; j < sizejacind; ++j )
-      {
-        int pj = jacind[ j ];
-        temp += jacj( i, j ) * this->m_ExactGradient( pj );
-      }
-      Jgg( i ) = temp;
-    }
+    /** Compute the displacement jac * gradient. */
+    const double jggMagnitude = JacobianTermsKernelType::ComputeDisplacementMagnitude(
+      jacj, jacind, this->m_ExactGradient );
 
     /** Sum the Jgg displacement for later use. */
-    jggMagnitude         = Jgg.magnitude();
     displacement        += jggMagnitude;
     displacementSquared += vnl_math_sqr( jggMagnitude );
     numberOfPixelsCounted++;
@@ -561,11 +515,9 @@ ComputeDisplacementDistribution< TFixedImage, TTransform >
   /**
    * Compute maxJJ and jac*gradient
    */
-  DerivativeType Jgg( outdim );
-  Jgg.Fill( 0.0 );
   std::vector< double > JGG_k;
-  double                globalDeformation = 0.0;
-  JacobianType          jacjjacj( outdim, outdim );
+  JGG_k.reserve( nrofsamples );
+  double globalDeformation = 0.0;
 
   samplenr = 0;
   for( iter = begin; iter != end; ++iter )
@@ -577,27 +529,15 @@ ComputeDisplacementDistribution< TFixedImage, TTransform >
     /** Apply scales, if necessary. */
     if( this->GetUseScales() )
     {
-      for( unsigned int pi = 0; pi < sizejacind; ++pi )
-      {
-        const unsigned int p = jacind[ pi ];
-        jacj.scale_column( pi, 1.0 / scales[ p ] );
-      }
+      JacobianTermsKernelType::ApplyScales( scales, jacind, jacj );
     }
 
-    /** Compute the matrix of jac*gradient */
-    for( unsigned int i = 0; i < outdim; ++i )
-    {
-      double temp = 0.0;
-      for( unsigned int j = 0; j < sizejacind; ++j )
-      {
-        int pj = jacind[ j ];
-        temp += jacj( i, j ) * exactgradient( pj );
-      }
-      Jgg( i ) = temp;
-    }
+    /** Compute the magnitude of jac*gradient. */
+    const double jggMagnitude = JacobianTermsKernelType::ComputeDisplacementMagnitude(
+      jacj, jacind, exactgradient );
 
-    globalDeformation += Jgg.magnitude();
-    JGG_k.push_back( Jgg.magnitude() );
+    globalDeformation += jggMagnitude;
+    JGG_k.push_back( jggMagnitude );
     ++samplenr;
 
   } // end loop over sample container
@@ -634,32 +574,10 @@ ComputeDisplacementDistribution< TFixedImage, TTransform >
 ::SampleFixedImageForJacobianTerms(
   ImageSampleContainerPointer & sampleContainer )
 {
-  /** Set up grid sampler. */
-  ImageGridSamplerPointer sampler = ImageGridSamplerType::New();
-  //  ImageFullSamplerPointer sampler = ImageFullSamplerType::New();
-  sampler->SetInput( this->m_FixedImage );
-  sampler->SetInputImageRegion( this->GetFixedImageRegion() );
-  sampler->SetMask( this->m_FixedImageMask );
-
-  /** Determine grid spacing of sampler such that the desired
-   * NumberOfJacobianMeasurements is achieved approximately.
-   * Note that the actually obtained number of samples may be lower, due to masks.
-   * This is taken into account at the end of this function.
-   */
-  SizeValueType nrofsamples = this->m_NumberOfJacobianMeasurements;
-  sampler->SetNumberOfSamples( nrofsamples );
+  JacobianTermsKernelType::SampleFixedImage( this->m_FixedImage,
+    this->GetFixedImageRegion(), this->m_FixedImageMask,
+    this->m_NumberOfJacobianMeasurements, sampleContainer );
 
-  /** Get samples and check the actually obtained number of samples. */
-  sampler->Update();
-  sampleContainer = sampler->GetOutput();
-  nrofsamples     = sampleContainer->Size();
-
-  if( nrofsamples == 0 )
-  {
-    itkExceptionMacro(
-      << "No valid voxels (0/" << this->m_NumberOfJacobianMeasurements
-      << ") found to estimate the AdaptiveStochasticGradientDescent parameters." );
-  }
 } // end SampleFixedImageForJacobianTerms()
 
 
@@ -19,10 +19,15 @@
 #define __itkComputeJacobianTerms_h
 
 #include "itkImageGridSampler.h"
+#include "itkJacobianTermsKernel.h"
 #include "itkImageRandomSamplerBase.h"
 #include "itkImageRandomCoordinateSampler.h"
 #include "itkScaledSingleValuedNonLinearOptimizer.h"
 
+#include "vnl/vnl_diag_matrix.h"
+#include "vnl/vnl_sparse_matrix.h"
+#include <vector>
+
 namespace itk
 {
 /**\class ComputeJacobianTerms
@@ -107,6 +112,13 @@ public:
   virtual void Compute( double & TrC, double & TrCC,
     double & maxJJ, double & maxJCJ );
 
+  /** Compute a diagonal preconditioner from the diagonal of
+   * C = 1/n \sum_{i=1}^n J_i^T J_i. The result is normalized to a mean of
+   * one and bounded from below by 0.01, so that it can be used as (squared)
+   * scales of the optimizer. The Scales are not applied.
+   */
+  virtual void ComputeDiagonalPreconditioner( ScalesType & preconditioner );
+
 protected:
 
   ComputeJacobianTerms();
@@ -145,12 +157,32 @@ protected:
   typedef typename TransformType::ScalarType             CoordinateRepresentationType;
   typedef typename TransformType::NumberOfParametersType NumberOfParametersType;
 
+  /** Typedefs for the covariance matrix C. */
+  typedef double                                   CovarianceValueType;
+  typedef itk::Array2D< CovarianceValueType >      CovarianceMatrixType;
+  typedef vnl_sparse_matrix< CovarianceValueType > SparseCovarianceMatrixType;
+  typedef SparseCovarianceMatrixType::row          SparseRowType;
+  typedef itk::Array< SizeValueType >              NonZeroJacobianIndicesExpandedType;
+  typedef vnl_diag_matrix< CovarianceValueType >   DiagCovarianceMatrixType;
+
+  /** Shared sampling and per-sample kernels. */
+  typedef JacobianTermsKernel< FixedImageType, TransformType > JacobianTermsKernelType;
+
   /** Sample the fixed image to compute the Jacobian terms. */
-  // \todo: note that this is an exact copy of itk::ComputeDisplacementDistribution
-  // in the future it would be better to refactoring this part of the code.
   virtual void SampleFixedImageForJacobianTerms(
     ImageSampleContainerPointer & sampleContainer );
 
+  /** Add a sum of J^T J products, divided by n, to the covariance matrix,
+   * which is stored as a band matrix and a sparse matrix.
+   */
+  void AccumulateCovariance(
+    const CovarianceMatrixType & jactjac,
+    const NonZeroJacobianIndicesType & jacind,
+    const double n,
+    const std::vector< unsigned int > & bandcovMap,
+    CovarianceMatrixType & bandcov,
+    SparseCovarianceMatrixType & cov ) const;
+
 private:
 
   ComputeJacobianTerms( const Self & ); // purposely not implemented
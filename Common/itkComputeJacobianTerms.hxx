@@ -73,13 +73,6 @@ ComputeJacobianTerms< TFixedImage, TTransform >
    * Term 4: maxJCJ, see (54)
    */
 
-  typedef double                                   CovarianceValueType;
-  typedef itk::Array2D< CovarianceValueType >      CovarianceMatrixType;
-  typedef vnl_sparse_matrix< CovarianceValueType > SparseCovarianceMatrixType;
-  typedef SparseCovarianceMatrixType::row          SparseRowType;
-  typedef itk::Array< SizeValueType >              NonZeroJacobianIndicesExpandedType;
-  typedef vnl_diag_matrix< CovarianceValueType >   DiagCovarianceMatrixType;
-
   /** Initialize. */
   TrC = TrCC = maxJJ = maxJCJ = 0.0;
 
@@ -101,31 +94,18 @@ ComputeJacobianTerms< TFixedImage, TTransform >
   /** Get scales vector */
   const ScalesType & scales = this->m_Scales;
 
-  /** Create iterator over the sample container. */
-  typename ImageSampleContainerType::ConstIterator iter;
-  typename ImageSampleContainerType::ConstIterator begin = sampleContainer->Begin();
-  typename ImageSampleContainerType::ConstIterator end   = sampleContainer->End();
-  unsigned int samplenr = 0;
-
   /** Variables for nonzerojacobian indices and the Jacobian. */
   NumberOfParametersType sizejacind
     = this->m_Transform->GetNumberOfNonZeroJacobianIndices();
   JacobianType jacj( outdim, sizejacind );
   jacj.Fill( 0.0 );
   NonZeroJacobianIndicesType jacind( sizejacind );
-  jacind[ 0 ] = 0;
-  if( sizejacind > 1 ) { jacind[ 1 ] = 0; }
-  NonZeroJacobianIndicesType prevjacind = jacind;
 
   /** Initialize covariance matrix. Sparse, diagonal, and band form. */
   SparseCovarianceMatrixType cov( P, P );
   DiagCovarianceMatrixType   diagcov( P, 0.0 );
   CovarianceMatrixType       bandcov;
 
-  /** For temporary storage of J'J. */
-  CovarianceMatrixType jactjac( sizejacind, sizejacind );
-  jactjac.Fill( 0.0 );
-
   typedef std::vector< unsigned int >             DifHistType;
   typedef std::pair< unsigned int, unsigned int > FreqPairType;
   typedef std::vector< FreqPairType >             DifHist2Type;
@@ -226,98 +206,72 @@ ComputeJacobianTerms< TFixedImage, TTransform >
    * Loop over image and compute Jacobian.
    * Compute C = 1/n \sum_i J_i^T J_i
    * Possibly apply scaling afterwards.
+   *
+   * The samples are divided in contiguous blocks over the threads. Each
+   * thread sums J_j^T J_j as long as the nonzero Jacobian indices do not
+   * change, and adds the sum to the covariance matrix when they do.
    */
-  jacind[ 0 ] = 0;
-  if( sizejacind > 1 ) { jacind[ 1 ] = 0; }
-  for( iter = begin; iter != end; ++iter )
+  const long numberOfSamples = static_cast< long >( nrofsamples );
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel
+#endif
   {
-    /** Print progress 0-50%.
-     *progressObserver->UpdateAndPrintProgress( samplenr );*/
-    ++samplenr;
-
-    /** Read fixed coordinates and get Jacobian J_j. */
-    const FixedImagePointType & point = ( *iter ).Value().m_ImageCoordinates;
-    this->m_Transform->GetJacobian( point, jacj, jacind  );
-
-    /** Skip invalid Jacobians in the beginning, if any. */
-    if( sizejacind > 1 )
+    JacobianType               threadJacj( outdim, sizejacind );
+    NonZeroJacobianIndicesType threadJacind( sizejacind );
+    NonZeroJacobianIndicesType threadPrevJacind( sizejacind );
+    CovarianceMatrixType       threadJacTJac( sizejacind, sizejacind );
+    bool                       haveJacTJac = false;
+
+#ifdef ELASTIX_USE_OPENMP
+    #pragma omp for schedule( static )
+#endif
+    for( long s = 0; s < numberOfSamples; ++s )
     {
-      if( jacind[ 0 ] == jacind[ 1 ] ) { continue; }
-    }
+      /** Read fixed coordinates and get Jacobian J_j. */
+      const FixedImagePointType & point
+        = sampleContainer->ElementAt( s ).m_ImageCoordinates;
+      this->m_Transform->GetJacobian( point, threadJacj, threadJacind );
 
-    if( jacind == prevjacind )
-    {
-      /** Update sum of J_j^T J_j. */
-      vnl_fastops::inc_X_by_AtA( jactjac, jacj );
-    }
-    else
-    {
-      /** The following should only be done after the first sample. */
-      if( iter != begin )
+      /** Skip invalid Jacobians, if any. */
+      if( sizejacind > 1 )
       {
-        /** Update covariance matrix. */
-        for( unsigned int pi = 0; pi < sizejacind; ++pi )
-        {
-          const unsigned int p = prevjacind[ pi ];
-          for( unsigned int qi = 0; qi < sizejacind; ++qi )
-          {
-            const unsigned int q = prevjacind[ qi ];
-            if( q >= p )
-            {
-              const double tempval = jactjac( pi, qi ) / n;
-              if( vcl_abs( tempval ) > 1e-14 )
-              {
-                const unsigned int bandindex = bandcovMap[ q - p ];
-                if( bandindex < bandcovsize )
-                {
-                  bandcov( p, bandindex ) += tempval;
-                }
-                else
-                {
-                  cov( p, q ) += tempval;
-                }
-              }
-            }
-          } // qi
-        }   // pi
-      }     // end if
-
-      /** Initialize jactjac by J_j^T J_j. */
-      vnl_fastops::AtA( jactjac, jacj );
-
-      /** Remember nonzerojacobian indices. */
-      prevjacind = jacind;
-    } // end else
-
-  } // end iter loop: end computation of covariance matrix
-
-  /** Update covariance matrix once again to include last jactjac updates
-   * \todo: a bit ugly that this loop is copied from above.
-   */
-  for( unsigned int pi = 0; pi < sizejacind; ++pi )
-  {
-    const unsigned int p = prevjacind[ pi ];
-    for( unsigned int qi = 0; qi < sizejacind; ++qi )
-    {
-      const unsigned int q = prevjacind[ qi ];
-      if( q >= p )
+        if( threadJacind[ 0 ] == threadJacind[ 1 ] ) { continue; }
+      }
+
+      if( haveJacTJac && threadJacind == threadPrevJacind )
       {
-        const double tempval = jactjac( pi, qi ) / n;
-        if( vcl_abs( tempval ) > 1e-14 )
-        {
-          const unsigned int bandindex = bandcovMap[ q - p ];
-          if( bandindex < bandcovsize )
-          {
-            bandcov( p, bandindex ) += tempval;
-          }
-          else
-          {
-            cov( p, q ) += tempval;
-          }
-        }
+        /** Update sum of J_j^T J_j. */
+        vnl_fastops::inc_X_by_AtA( threadJacTJac, threadJacj );
+        continue;
       }
-    } // qi
-  }   // pi
+
+      /** Add the previous sum to the covariance matrix. */
+      if( haveJacTJac )
+      {
+#ifdef ELASTIX_USE_OPENMP
+        #pragma omp critical
+#endif
+        this->AccumulateCovariance( threadJacTJac, threadPrevJacind, n,
+          bandcovMap, bandcov, cov );
+      }
+
+      /** Initialize the sum by J_j^T J_j and remember the nonzero Jacobian indices. */
+      vnl_fastops::AtA( threadJacTJac, threadJacj );
+      threadPrevJacind = threadJacind;
+      haveJacTJac      = true;
+
+    } // end loop over samples
+
+    /** Add the last sum to the covariance matrix. */
+    if( haveJacTJac )
+    {
+#ifdef ELASTIX_USE_OPENMP
+      #pragma omp critical
+#endif
+      this->AccumulateCovariance( threadJacTJac, threadPrevJacind, n,
+        bandcovMap, bandcov, cov );
+    }
+  } // end parallel region: end computation of covariance matrix
 
   /** Copy the bandmatrix into the sparse matrix and empty the bandcov matrix.
    * \todo: perhaps work further with this bandmatrix instead.
@@ -394,124 +348,249 @@ ComputeJacobianTerms< TFixedImage, TTransform >
   maxJCJ = 0.0;
   const double sqrt2 = vcl_sqrt( static_cast< double >( 2.0 ) );
 
-  JacobianType                       jacjjacj( outdim, outdim );
-  JacobianType                       jacjcov( outdim, sizejacind );
-  DiagCovarianceMatrixType           diagcovsparse( sizejacind );
-  JacobianType                       jacjdiagcov( outdim, sizejacind );
-  JacobianType                       jacjdiagcovjacj( outdim, outdim );
-  JacobianType                       jacjcovjacj( outdim, outdim );
-  NonZeroJacobianIndicesExpandedType jacindExpanded( P );
-
-  samplenr = 0;
-  for( iter = begin; iter != end; ++iter )
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel
+#endif
   {
-    /** Read fixed coordinates and get Jacobian. */
-    const FixedImagePointType & point = ( *iter ).Value().m_ImageCoordinates;
-    this->m_Transform->GetJacobian( point, jacj, jacind  );
-
-    /** Apply scales, if necessary. */
-    if( this->m_UseScales )
+    JacobianType                       threadJacj( outdim, sizejacind );
+    NonZeroJacobianIndicesType         threadJacind( sizejacind );
+    JacobianType                       jacjcov( outdim, sizejacind );
+    DiagCovarianceMatrixType           diagcovsparse( sizejacind );
+    JacobianType                       jacjdiagcov( outdim, sizejacind );
+    JacobianType                       jacjdiagcovjacj( outdim, outdim );
+    JacobianType                       jacjcovjacj( outdim, outdim );
+    NonZeroJacobianIndicesExpandedType jacindExpanded( P );
+    double                             threadMaxJJ  = 0.0;
+    double                             threadMaxJCJ = 0.0;
+
+#ifdef ELASTIX_USE_OPENMP
+    #pragma omp for schedule( static )
+#endif
+    for( long s = 0; s < numberOfSamples; ++s )
     {
+      /** Read fixed coordinates and get Jacobian. */
+      const FixedImagePointType & point
+        = sampleContainer->ElementAt( s ).m_ImageCoordinates;
+      this->m_Transform->GetJacobian( point, threadJacj, threadJacind );
+
+      /** Apply scales, if necessary. */
+      if( this->m_UseScales )
+      {
+        JacobianTermsKernelType::ApplyScales( scales, threadJacind, threadJacj );
+      }
+
+      /** Max_j [JJ_j], with JJ_j = ||J_j||_F^2 + 2\sqrt{2} || J_j J_j^T ||_F. */
+      const double JJ_j = JacobianTermsKernelType::ComputeJJ( threadJacj );
+      threadMaxJJ = vnl_math_max( threadMaxJJ, JJ_j );
+
+      /** Compute JCJ_j. */
+      double JCJ_j = 0.0;
+
+      /** J_j C = jacjC. */
+      jacjcov.Fill( 0.0 );
+
+      /** Store the nonzero Jacobian indices in a different format
+       * and create the sparse diagcov.
+       */
+      jacindExpanded.Fill( sizejacind );
       for( unsigned int pi = 0; pi < sizejacind; ++pi )
       {
-        const unsigned int p = jacind[ pi ];
-        jacj.scale_column( pi, 1.0 / scales[ p ] );
+        const unsigned int p = threadJacind[ pi ];
+        jacindExpanded[ p ] = pi;
+        diagcovsparse[ pi ] = diagcov[ p ];
       }
-    }
 
-    /** Compute 1st part of JJ: ||J_j||_F^2. */
-    double JJ_j = vnl_math_sqr( jacj.frobenius_norm() );
+      /** We below calculate jacjC = J_j cov^T, but later we will correct
+       * for this using:
+       * J C J' = J (cov + cov' - diag(cov')) J'.
+       * (NB: cov now still contains only the upper triangular part of C)
+       */
+      for( unsigned int pi = 0; pi < sizejacind; ++pi )
+      {
+        const unsigned int p = threadJacind[ pi ];
+        if( !cov.empty_row( p ) )
+        {
+          SparseRowType & covrowp = cov.get_row( p );
+          typename SparseRowType::iterator covrowpit;
 
-    /** Compute 2nd part of JJ: 2\sqrt{2} || J_j J_j^T ||_F. */
-    vnl_fastops::ABt( jacjjacj, jacj, jacj );
-    JJ_j += 2.0 * sqrt2 * jacjjacj.frobenius_norm();
+          /** Loop over row p of the sparse cov matrix. */
+          for( covrowpit = covrowp.begin(); covrowpit != covrowp.end(); ++covrowpit )
+          {
+            const unsigned int q  = ( *covrowpit ).first;
+            const unsigned int qi = jacindExpanded[ q ];
+
+            if( qi < sizejacind )
+            {
+              /** If found, update the jacjC matrix. */
+              const CovarianceValueType covElement = ( *covrowpit ).second;
+              for( unsigned int dx = 0; dx < outdim; ++dx )
+              {
+                jacjcov[ dx ][ pi ] += threadJacj[ dx ][ qi ] * covElement;
+              } //dx
+            }   // if qi < sizejacind
+          }     // for covrow
+
+        } // if not empty row
+      }   // pi
+
+      /** J_j C J_j^T  = jacjCjacj.
+       * But note that we actually compute J_j cov' J_j^T
+       */
+      vnl_fastops::ABt( jacjcovjacj, jacjcov, threadJacj );
+
+      /** jacjCjacj = jacjCjacj+ jacjCjacj' - jacjdiagcovjacj */
+      jacjdiagcov = threadJacj * diagcovsparse;
+      vnl_fastops::ABt( jacjdiagcovjacj, jacjdiagcov, threadJacj );
+      jacjcovjacj += jacjcovjacj.transpose();
+      jacjcovjacj -= jacjdiagcovjacj;
+
+      /** Compute 1st part of JCJ: Tr( J_j C J_j^T ). */
+      for( unsigned int d = 0; d < outdim; ++d )
+      {
+        JCJ_j += jacjcovjacj[ d ][ d ];
+      }
 
-    /** Max_j [JJ_j]. */
-    maxJJ = vnl_math_max( maxJJ, JJ_j );
+      /** Compute 2nd part of JCJ_j: 2 \sqrt{2} || J_j C J_j^T ||_F. */
+      JCJ_j += 2.0 * sqrt2 * jacjcovjacj.frobenius_norm();
 
-    /** Compute JCJ_j. */
-    double JCJ_j = 0.0;
+      /** Max_j [JCJ_j]. */
+      threadMaxJCJ = vnl_math_max( threadMaxJCJ, JCJ_j );
 
-    /** J_j C = jacjC. */
-    jacjcov.Fill( 0.0 );
+    } // end loop over sample container
 
-    /** Store the nonzero Jacobian indices in a different format
-     * and create the sparse diagcov.
-     */
-    jacindExpanded.Fill( sizejacind );
-    for( unsigned int pi = 0; pi < sizejacind; ++pi )
+    /** Combine the maxima of the threads. */
+#ifdef ELASTIX_USE_OPENMP
+    #pragma omp critical
+#endif
     {
-      const unsigned int p = jacind[ pi ];
-      jacindExpanded[ p ] = pi;
-      diagcovsparse[ pi ] = diagcov[ p ];
+      maxJJ  = vnl_math_max( maxJJ, threadMaxJJ );
+      maxJCJ = vnl_math_max( maxJCJ, threadMaxJCJ );
     }
+  } // end parallel region
+
+} // end Compute()
+
 
-    /** We below calculate jacjC = J_j cov^T, but later we will correct
-     * for this using:
-     * J C J' = J (cov + cov' - diag(cov')) J'.
-     * (NB: cov now still contains only the upper triangular part of C)
-     */
-    for( unsigned int pi = 0; pi < sizejacind; ++pi )
+/**
+ * ************************* AccumulateCovariance ************************
+ */
+
+template< class TFixedImage, class TTransform >
+void
+ComputeJacobianTerms< TFixedImage, TTransform >
+::AccumulateCovariance(
+  const CovarianceMatrixType & jactjac,
+  const NonZeroJacobianIndicesType & jacind,
+  const double n,
+  const std::vector< unsigned int > & bandcovMap,
+  CovarianceMatrixType & bandcov,
+  SparseCovarianceMatrixType & cov ) const
+{
+  /** Add the elements of the upper triangle of J^T J / n to the band matrix,
+   * if they lie on one of its bands, or else to the sparse matrix.
+   */
+  const unsigned int bandcovsize = bandcov.cols();
+  const unsigned int sizejacind  = jacind.size();
+  for( unsigned int pi = 0; pi < sizejacind; ++pi )
+  {
+    const unsigned int p = jacind[ pi ];
+    for( unsigned int qi = 0; qi < sizejacind; ++qi )
     {
-      const unsigned int p = jacind[ pi ];
-      if( !cov.empty_row( p ) )
+      const unsigned int q = jacind[ qi ];
+      if( q >= p )
       {
-        SparseRowType & covrowp = cov.get_row( p );
-        typename SparseRowType::iterator covrowpit;
-
-        /** Loop over row p of the sparse cov matrix. */
-        for( covrowpit = covrowp.begin(); covrowpit != covrowp.end(); ++covrowpit )
+        const double tempval = jactjac( pi, qi ) / n;
+        if( vcl_abs( tempval ) > 1e-14 )
         {
-          const unsigned int q  = ( *covrowpit ).first;
-          const unsigned int qi = jacindExpanded[ q ];
-
-          if( qi < sizejacind )
+          const unsigned int bandindex = bandcovMap[ q - p ];
+          if( bandindex < bandcovsize )
           {
-            /** If found, update the jacjC matrix. */
-            const CovarianceValueType covElement = ( *covrowpit ).second;
-            for( unsigned int dx = 0; dx < outdim; ++dx )
-            {
-              jacjcov[ dx ][ pi ] += jacj[ dx ][ qi ] * covElement;
-            } //dx
-          }   // if qi < sizejacind
-        }     // for covrow
-
-      } // if not empty row
-    }   // pi
-
-    /** J_j C J_j^T  = jacjCjacj.
-     * But note that we actually compute J_j cov' J_j^T
-     */
-    vnl_fastops::ABt( jacjcovjacj, jacjcov, jacj );
-
-    /** jacjCjacj = jacjCjacj+ jacjCjacj' - jacjdiagcovjacj */
-    jacjdiagcov = jacj * diagcovsparse;
-    vnl_fastops::ABt( jacjdiagcovjacj, jacjdiagcov, jacj );
-    jacjcovjacj += jacjcovjacj.transpose();
-    jacjcovjacj -= jacjdiagcovjacj;
-
-    /** Compute 1st part of JCJ: Tr( J_j C J_j^T ). */
-    for( unsigned int d = 0; d < outdim; ++d )
-    {
-      JCJ_j += jacjcovjacj[ d ][ d ];
-    }
+            bandcov( p, bandindex ) += tempval;
+          }
+          else
+          {
+            cov( p, q ) += tempval;
+          }
+        }
+      }
+    } // qi
+  }   // pi
 
-    /** Compute 2nd part of JCJ_j: 2 \sqrt{2} || J_j C J_j^T ||_F. */
-    JCJ_j += 2.0 * sqrt2 * jacjcovjacj.frobenius_norm();
+} // end AccumulateCovariance()
 
-    /** Max_j [JCJ_j]. */
-    maxJCJ = vnl_math_max( maxJCJ, JCJ_j );
 
-    /** Show progress 50-100%. */
-    //progressObserver->UpdateAndPrintProgress( samplenr + nrofsamples );
-    ++samplenr;
+/**
+ * ************************* ComputeDiagonalPreconditioner ************************
+ */
 
-  } // end loop over sample container
+template< class TFixedImage, class TTransform >
+void
+ComputeJacobianTerms< TFixedImage, TTransform >
+::ComputeDiagonalPreconditioner( ScalesType & preconditioner )
+{
+  /** Parameters whose Jacobian is (almost) zero everywhere in the
+   * sampled region would otherwise get an unbounded step size.
+   */
+  const double minimumPreconditionerValue = 1e-2;
 
-  /** Finalize progress information. */
-  //progressObserver->PrintProgress( 1.0 );
+  /** Get samples. */
+  ImageSampleContainerPointer sampleContainer = 0;
+  this->SampleFixedImageForJacobianTerms( sampleContainer );
+  const SizeValueType nrofsamples = sampleContainer->Size();
 
-} // end Compute()
+  /** Get the number of parameters. */
+  const unsigned int P = static_cast< unsigned int >(
+    this->m_Transform->GetNumberOfParameters() );
+  const unsigned int outdim = this->m_Transform->GetOutputSpaceDimension();
+
+  /** Variables for nonzerojacobian indices and the Jacobian. */
+  const NumberOfParametersType sizejacind
+    = this->m_Transform->GetNumberOfNonZeroJacobianIndices();
+  JacobianType jacj( outdim, sizejacind );
+  jacj.Fill( 0.0 );
+  NonZeroJacobianIndicesType jacind( sizejacind );
+
+  /** Accumulate diag( J_i^T J_i ), i.e. the squared column norms of J_i. */
+  preconditioner.SetSize( P );
+  preconditioner.Fill( 0.0 );
+  for( SizeValueType i = 0; i < nrofsamples; ++i )
+  {
+    const FixedImagePointType & point
+      = sampleContainer->GetElement( i ).m_ImageCoordinates;
+    this->m_Transform->GetJacobian( point, jacj, jacind );
+
+    for( unsigned int k = 0; k < sizejacind; ++k )
+    {
+      double sum = 0.0;
+      for( unsigned int d = 0; d < outdim; ++d )
+      {
+        sum += jacj[ d ][ k ] * jacj[ d ][ k ];
+      }
+      preconditioner[ jacind[ k ] ] += sum;
+    }
+  }
+
+  /** Normalize to a mean of one; the constant 1/n cancels. */
+  double mean = 0.0;
+  for( unsigned int p = 0; p < P; ++p )
+  {
+    mean += preconditioner[ p ];
+  }
+  mean /= static_cast< double >( P );
+
+  if( mean < 1e-14 )
+  {
+    preconditioner.Fill( 1.0 );
+    return;
+  }
+
+  for( unsigned int p = 0; p < P; ++p )
+  {
+    preconditioner[ p ] = vnl_math_max( minimumPreconditionerValue,
+      preconditioner[ p ] / mean );
+  }
+
+} // end ComputeDiagonalPreconditioner()
 
 
 /**
@@ -524,31 +603,9 @@ ComputeJacobianTerms< TFixedImage, TTransform >
 ::SampleFixedImageForJacobianTerms(
   ImageSampleContainerPointer & sampleContainer )
 {
-  /** Set up grid sampler. */
-  ImageGridSamplerPointer sampler = ImageGridSamplerType::New();
-  sampler->SetInput( this->m_FixedImage );
-  sampler->SetInputImageRegion( this->GetFixedImageRegion() );
-  sampler->SetMask( this->m_FixedImageMask );
-
-  /** Determine grid spacing of sampler such that the desired
-   * NumberOfJacobianMeasurements is achieved approximately.
-   * Note that the actually obtained number of samples may be lower, due to masks.
-   * This is taken into account at the end of this function.
-   */
-  SizeValueType nrofsamples = this->m_NumberOfJacobianMeasurements;
-  sampler->SetNumberOfSamples( nrofsamples );
-
-  /** Get samples and check the actually obtained number of samples. */
-  sampler->Update();
-  sampleContainer = sampler->GetOutput();
-  nrofsamples     = sampleContainer->Size();
-
-  if( nrofsamples == 0 )
-  {
-    itkExceptionMacro(
-        << "No valid voxels (0/" << this->m_NumberOfJacobianMeasurements
-        << ") found to estimate the AdaptiveStochasticGradientDescent parameters." );
-  }
+  JacobianTermsKernelType::SampleFixedImage( this->m_FixedImage,
+    this->GetFixedImageRegion(), this->m_FixedImageMask,
+    this->m_NumberOfJacobianMeasurements, sampleContainer );
 
 } // end SampleFixedImageForJacobianTerms()
 
@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkFusedSmoothingDecimationKernel_h
+#define __itkFusedSmoothingDecimationKernel_h
+
+#include "itkImage.h"
+#include "itkFixedArray.h"
+#include <vector>
+
+namespace itk
+{
+/**\class FusedSmoothingDecimationKernel
+ * \brief Gaussian smoothing and downsampling of an image in one separable pass.
+ *
+ * The input is smoothed with a (truncated, 3 sigma) Gaussian and the result
+ * is evaluated at the pixel centers of the output image, one dimension at a
+ * time. Each dimension is downsampled directly after it is smoothed, so that
+ * the following dimensions are filtered at the lower resolution. Every pass
+ * writes an intermediate image at the resolution reached so far, and the
+ * image of the previous pass is released directly after it, so that no full
+ * size smoothed image is kept, as in the smoother and shrinker or resampler
+ * pipeline. The output positions may lie between
+ * the input pixels; the Gaussian is then centered at those positions. When
+ * the standard deviation in a dimension is zero, linear interpolation is used.
+ * At the image border the input is extended by its edge values.
+ *
+ * The rows of each dimension are processed in parallel with OpenMP, when
+ * available. From the second dimension on, the dimensions below the filtered
+ * one form the innermost, contiguous loop, which vectorizes. The first
+ * dimension is contiguous itself, so there every output value is a short
+ * sum over its taps.
+ *
+ * The output must be allocated, and have the same direction cosines as the
+ * input.
+ */
+
+template< class TInputImage, class TOutputImage, class TPrecisionType = double >
+class FusedSmoothingDecimationKernel
+{
+public:
+
+  /** Standard typedefs. */
+  typedef FusedSmoothingDecimationKernel Self;
+
+  /** Typedefs. */
+  typedef TInputImage                         InputImageType;
+  typedef TOutputImage                        OutputImageType;
+  typedef TPrecisionType                      PrecisionType;
+  typedef typename InputImageType::PixelType  InputPixelType;
+  typedef typename OutputImageType::PixelType OutputPixelType;
+
+  itkStaticConstMacro( ImageDimension, unsigned int, TInputImage::ImageDimension );
+
+  /** The standard deviation per dimension, in physical units. */
+  typedef FixedArray< double, itkGetStaticConstMacro( ImageDimension ) > SigmaArrayType;
+
+  /** Compute the output from the buffered region of the input. */
+  static void Compute( const InputImageType * input,
+    const SigmaArrayType & sigma, OutputImageType * output );
+
+private:
+
+  /** The taps of all output positions of one dimension. The taps of output
+   * position j are [ Begin[ j ], Begin[ j + 1 ] ).
+   */
+  struct AxisWeightsType
+  {
+    std::vector< SizeValueType > Begin;
+    std::vector< SizeValueType > Index;
+    std::vector< PrecisionType > Weight;
+  };
+
+  /** Compute the taps, for output position j centered at the input
+   * continuous index first + j * step.
+   */
+  static void ComputeAxisWeights( const double first, const double step,
+    const SizeValueType inputSize, const SizeValueType outputSize,
+    const double sigmaInPixels, AxisWeightsType & weights );
+
+  /** Filter and downsample one dimension. The buffers are seen as
+   * outer x size x inner arrays.
+   */
+  template< class TInputValue >
+  static void FilterAxis( const TInputValue * in, PrecisionType * out,
+    const AxisWeightsType & weights, const SizeValueType inner,
+    const SizeValueType inputSize, const SizeValueType outputSize,
+    const SizeValueType outer );
+
+  FusedSmoothingDecimationKernel();               // purposely not implemented
+  FusedSmoothingDecimationKernel( const Self & ); // purposely not implemented
+  void operator=( const Self & );                 // purposely not implemented
+
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkFusedSmoothingDecimationKernel.hxx"
+#endif
+
+#endif // end #ifndef __itkFusedSmoothingDecimationKernel_h
@@ -0,0 +1,259 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkFusedSmoothingDecimationKernel_hxx
+#define __itkFusedSmoothingDecimationKernel_hxx
+
+#include "itkFusedSmoothingDecimationKernel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+
+/**
+ * ************************* Compute ************************
+ */
+
+template< class TInputImage, class TOutputImage, class TPrecisionType >
+void
+FusedSmoothingDecimationKernel< TInputImage, TOutputImage, TPrecisionType >
+::Compute( const InputImageType * input,
+  const SigmaArrayType & sigma, OutputImageType * output )
+{
+  typedef typename InputImageType::RegionType       InputRegionType;
+  typedef typename OutputImageType::RegionType      OutputRegionType;
+  typedef typename OutputImageType::IndexType       OutputIndexType;
+  typedef typename OutputImageType::PointType       PointType;
+  typedef ContinuousIndex< double, ImageDimension > ContinuousIndexType;
+
+  if( input->GetDirection() != output->GetDirection() )
+  {
+    itkGenericExceptionMacro( << "The input and output image must have the same direction." );
+  }
+
+  const InputRegionType  inputRegion  = input->GetBufferedRegion();
+  const OutputRegionType outputRegion = output->GetBufferedRegion();
+
+  /** Compute the input continuous index of the first output pixel, and the
+   * step between output pixels, for each dimension. The input index is
+   * relative to the start of the input buffer.
+   */
+  double          first[ ImageDimension ];
+  double          step[ ImageDimension ];
+  OutputIndexType outputIndex = outputRegion.GetIndex();
+  PointType       point;
+  ContinuousIndexType cindex0;
+  ContinuousIndexType cindex1;
+  output->TransformIndexToPhysicalPoint( outputIndex, point );
+  input->TransformPhysicalPointToContinuousIndex( point, cindex0 );
+  for( unsigned int d = 0; d < ImageDimension; ++d )
+  {
+    ++outputIndex[ d ];
+    output->TransformIndexToPhysicalPoint( outputIndex, point );
+    input->TransformPhysicalPointToContinuousIndex( point, cindex1 );
+    --outputIndex[ d ];
+
+    first[ d ] = cindex0[ d ] - static_cast< double >( inputRegion.GetIndex()[ d ] );
+    step[ d ]  = cindex1[ d ] - cindex0[ d ];
+  }
+
+  /** Filter the dimensions one by one. The first pass reads the input
+   * directly; dimensions that need no filtering are skipped. The result of
+   * the previous pass is released as soon as it has been filtered.
+   */
+  const InputPixelType *       inputBuffer    = input->GetBufferPointer();
+  bool                         currentIsInput = true;
+  std::vector< PrecisionType > current;
+  std::vector< PrecisionType > next;
+  SizeValueType                size[ ImageDimension ];
+  for( unsigned int d = 0; d < ImageDimension; ++d )
+  {
+    size[ d ] = inputRegion.GetSize()[ d ];
+  }
+
+  for( unsigned int d = 0; d < ImageDimension; ++d )
+  {
+    const SizeValueType inputSize     = size[ d ];
+    const SizeValueType outputSize    = outputRegion.GetSize()[ d ];
+    const double        sigmaInPixels = sigma[ d ] / input->GetSpacing()[ d ];
+    const bool          identity      = sigmaInPixels == 0.0
+      && inputSize == outputSize && std::abs( first[ d ] ) < 1e-6
+      && std::abs( step[ d ] - 1.0 ) < 1e-6;
+    if( identity )
+    {
+      continue;
+    }
+
+    SizeValueType inner = 1;
+    SizeValueType outer = 1;
+    for( unsigned int e = 0; e < d; ++e )
+    {
+      inner *= size[ e ];
+    }
+    for( unsigned int e = d + 1; e < ImageDimension; ++e )
+    {
+      outer *= size[ e ];
+    }
+
+    AxisWeightsType weights;
+    ComputeAxisWeights( first[ d ], step[ d ], inputSize, outputSize,
+      sigmaInPixels, weights );
+
+    next.resize( inner * outputSize * outer );
+    if( currentIsInput )
+    {
+      FilterAxis( inputBuffer, &next[ 0 ], weights, inner, inputSize, outputSize, outer );
+    }
+    else
+    {
+      FilterAxis( &current[ 0 ], &next[ 0 ], weights, inner, inputSize, outputSize, outer );
+    }
+    current.swap( next );
+    std::vector< PrecisionType >().swap( next );
+    currentIsInput = false;
+    size[ d ]      = outputSize;
+  }
+
+  /** Copy the result to the output. */
+  OutputPixelType *   outputBuffer = output->GetBufferPointer();
+  const SizeValueType numberOfPixels = outputRegion.GetNumberOfPixels();
+  if( currentIsInput )
+  {
+    for( SizeValueType i = 0; i < numberOfPixels; ++i )
+    {
+      outputBuffer[ i ] = static_cast< OutputPixelType >( inputBuffer[ i ] );
+    }
+  }
+  else
+  {
+    for( SizeValueType i = 0; i < numberOfPixels; ++i )
+    {
+      outputBuffer[ i ] = static_cast< OutputPixelType >( current[ i ] );
+    }
+  }
+
+} // end Compute()
+
+
+/**
+ * ************************* ComputeAxisWeights ************************
+ */
+
+template< class TInputImage, class TOutputImage, class TPrecisionType >
+void
+FusedSmoothingDecimationKernel< TInputImage, TOutputImage, TPrecisionType >
+::ComputeAxisWeights( const double first, const double step,
+  const SizeValueType inputSize, const SizeValueType outputSize,
+  const double sigmaInPixels, AxisWeightsType & weights )
+{
+  const OffsetValueType last = static_cast< OffsetValueType >( inputSize ) - 1;
+
+  /** Without smoothing the taps are those of linear interpolation. */
+  const bool            smooth = sigmaInPixels > 0.01;
+  const OffsetValueType radius = smooth
+    ? static_cast< OffsetValueType >( std::ceil( 3.0 * sigmaInPixels ) ) : 0;
+
+  weights.Begin.resize( outputSize + 1 );
+  weights.Index.clear();
+  weights.Weight.clear();
+  weights.Index.reserve( outputSize * ( 2 * radius + 2 ) );
+  weights.Weight.reserve( outputSize * ( 2 * radius + 2 ) );
+
+  for( SizeValueType j = 0; j < outputSize; ++j )
+  {
+    const double          center = first + static_cast< double >( j ) * step;
+    const OffsetValueType base   = static_cast< OffsetValueType >( std::floor( center ) );
+    weights.Begin[ j ] = weights.Index.size();
+
+    double sum = 0.0;
+    for( OffsetValueType i = base - radius; i <= base + radius + 1; ++i )
+    {
+      const double distance = static_cast< double >( i ) - center;
+      const double weight   = smooth
+        ? std::exp( -0.5 * distance * distance / ( sigmaInPixels * sigmaInPixels ) )
+        : 1.0 - std::abs( distance );
+      if( weight <= 0.0 )
+      {
+        continue;
+      }
+
+      /** Extend the input by its edge values. */
+      const OffsetValueType index = std::min( std::max( i, OffsetValueType( 0 ) ), last );
+      weights.Index.push_back( static_cast< SizeValueType >( index ) );
+      weights.Weight.push_back( static_cast< PrecisionType >( weight ) );
+      sum += weight;
+    }
+
+    /** Normalize. */
+    for( SizeValueType t = weights.Begin[ j ]; t < weights.Index.size(); ++t )
+    {
+      weights.Weight[ t ] = static_cast< PrecisionType >( weights.Weight[ t ] / sum );
+    }
+  }
+  weights.Begin[ outputSize ] = weights.Index.size();
+
+} // end ComputeAxisWeights()
+
+
+/**
+ * ************************* FilterAxis ************************
+ */
+
+template< class TInputImage, class TOutputImage, class TPrecisionType >
+template< class TInputValue >
+void
+FusedSmoothingDecimationKernel< TInputImage, TOutputImage, TPrecisionType >
+::FilterAxis( const TInputValue * in, PrecisionType * out,
+  const AxisWeightsType & weights, const SizeValueType inner,
+  const SizeValueType inputSize, const SizeValueType outputSize,
+  const SizeValueType outer )
+{
+  /** Every output row, consisting of inner contiguous values, is a weighted
+   * sum of a few input rows.
+   */
+  const long numberOfRows = static_cast< long >( outer * outputSize );
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for schedule( static )
+#endif
+  for( long row = 0; row < numberOfRows; ++row )
+  {
+    const SizeValueType o = static_cast< SizeValueType >( row ) / outputSize;
+    const SizeValueType j = static_cast< SizeValueType >( row ) % outputSize;
+
+    const TInputValue * inSlab = in + o * inputSize * inner;
+    PrecisionType *     outRow = out + static_cast< SizeValueType >( row ) * inner;
+    std::fill( outRow, outRow + inner, NumericTraits< PrecisionType >::Zero );
+
+    for( SizeValueType t = weights.Begin[ j ]; t < weights.Begin[ j + 1 ]; ++t )
+    {
+      const TInputValue * inRow  = inSlab + weights.Index[ t ] * inner;
+      const PrecisionType weight = weights.Weight[ t ];
+      for( SizeValueType i = 0; i < inner; ++i )
+      {
+        outRow[ i ] += weight * static_cast< PrecisionType >( inRow[ i ] );
+      }
+    }
+  }
+
+} // end FilterAxis()
+
+
+} // end namespace itk
+
+#endif // end #ifndef __itkFusedSmoothingDecimationKernel_hxx
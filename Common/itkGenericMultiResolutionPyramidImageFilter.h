@@ -86,6 +86,8 @@ namespace itk
  *
  * The smoothed image is then downsampled using a ResampleImageFilter or
  * ShrinkImageFilter depending on SetUseShrinkImageFilter().
+ * With SetUseFusedSmoothingAndDownsampling() both steps are instead done
+ * at once by the FusedSmoothingDecimationKernel.
  *
  * When this filter is updated, NumberOfLevels outputs are produced.
  * The N'th output correspond to the N'th level of the pyramid.
@@ -220,6 +222,15 @@ public:
   itkGetConstMacro( ComputeOnlyForCurrentLevel, bool );
   itkBooleanMacro( ComputeOnlyForCurrentLevel );
 
+  /** Set whether smoothing and rescaling are done in one pass by the
+   * FusedSmoothingDecimationKernel, for the levels that are rescaled. The
+   * smoothed image is then evaluated at the output pixel positions, without
+   * creating a full resolution smoothed image. Default: false.
+   */
+  itkSetMacro( UseFusedSmoothingAndDownsampling, bool );
+  itkGetConstMacro( UseFusedSmoothingAndDownsampling, bool );
+  itkBooleanMacro( UseFusedSmoothingAndDownsampling );
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   /** Begin concept checking */
   itkConceptMacro( SameDimensionCheck,
@@ -266,6 +277,7 @@ protected:
   unsigned int          m_CurrentLevel;
   bool                  m_ComputeOnlyForCurrentLevel;
   bool                  m_SmoothingScheduleDefined;
+  bool                  m_UseFusedSmoothingAndDownsampling;
 
 private:
 
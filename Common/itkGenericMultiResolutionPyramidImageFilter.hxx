@@ -23,6 +23,7 @@
 #include "itkResampleImageFilter.h"
 #include "itkShrinkImageFilter.h"
 #include "itkImageAlgorithm.h"
+#include "itkFusedSmoothingDecimationKernel.h"
 
 namespace // anonymous namespace
 {
@@ -59,8 +60,9 @@ template< class TInputImage, class TOutputImage, class TPrecisionType >
 GenericMultiResolutionPyramidImageFilter< TInputImage, TOutputImage, TPrecisionType >
 ::GenericMultiResolutionPyramidImageFilter()
 {
-  this->m_CurrentLevel               = 0;
-  this->m_ComputeOnlyForCurrentLevel = false;
+  this->m_CurrentLevel                     = 0;
+  this->m_ComputeOnlyForCurrentLevel       = false;
+  this->m_UseFusedSmoothingAndDownsampling = false;
   SmoothingScheduleType temp( this->GetNumberOfLevels(), ImageDimension );
   temp.Fill( NumericTraits< ScalarRealType >::ZeroValue() );
   this->m_SmoothingSchedule        = temp;
@@ -348,6 +350,25 @@ GenericMultiResolutionPyramidImageFilter< TInputImage, TOutputImage, TPrecisionT
       outputPtr->SetBufferedRegion( outputPtr->GetRequestedRegion() );
       outputPtr->Allocate();
 
+      // Smooth and rescale in one pass, if requested
+      RescaleFactorArrayType shrinkFactors;
+      this->GetShrinkFactors( level, shrinkFactors );
+      if( this->m_UseFusedSmoothingAndDownsampling
+        && !this->AreRescaleFactorsAllOnes( shrinkFactors ) )
+      {
+        typedef FusedSmoothingDecimationKernel<
+          InputImageType, OutputImageType, TPrecisionType > FusedKernelType;
+        SigmaArrayType                           sigmaArray;
+        typename FusedKernelType::SigmaArrayType sigma;
+        this->GetSigma( level, sigmaArray );
+        for( unsigned int dim = 0; dim < ImageDimension; ++dim )
+        {
+          sigma[ dim ] = static_cast< double >( sigmaArray[ dim ] );
+        }
+        FusedKernelType::Compute( input, sigma, outputPtr );
+        continue;
+      }
+
       // Setup the smoother
       const bool smootherIsUsed = this->SetupSmoother( level, smoother, input );
 
@@ -914,6 +935,8 @@ GenericMultiResolutionPyramidImageFilter< TInputImage, TOutputImage, TPrecisionT
      << this->m_CurrentLevel << std::endl;
   os << indent << "ComputeOnlyForCurrentLevel: "
      << ( this->m_ComputeOnlyForCurrentLevel ? "true" : "false" ) << std::endl;
+  os << indent << "UseFusedSmoothingAndDownsampling: "
+     << ( this->m_UseFusedSmoothingAndDownsampling ? "true" : "false" ) << std::endl;
   os << indent << "SmoothingScheduleDefined: "
      << ( this->m_SmoothingScheduleDefined ? "true" : "false" ) << std::endl;
   os << indent << "Smoothing Schedule: ";
@@ -0,0 +1,108 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkJacobianTermsKernel_h
+#define __itkJacobianTermsKernel_h
+
+#include "itkImageGridSampler.h"
+#include "itkScaledSingleValuedNonLinearOptimizer.h"
+
+namespace itk
+{
+/**\class JacobianTermsKernel
+ * \brief Sampling and per-sample Jacobian terms shared by the automatic
+ * parameter estimation strategies of the ASGD optimizer.
+ *
+ * Both itk::ComputeJacobianTerms and itk::ComputeDisplacementDistribution
+ * measure the transform Jacobian J_j on a grid of fixed image samples and
+ * compute, per sample, terms that only involve J_j restricted to its
+ * nonzero Jacobian indices. This class contains that common code, so that
+ * both strategies use the same sample set and the same kernels.
+ *
+ * All functions are static and thread-safe, given that the output arguments
+ * are not shared between threads.
+ */
+
+template< class TFixedImage, class TTransform >
+class JacobianTermsKernel
+{
+public:
+
+  /** Standard typedefs. */
+  typedef JacobianTermsKernel Self;
+
+  /** Typedefs. */
+  typedef TFixedImage                                          FixedImageType;
+  typedef TTransform                                           TransformType;
+  typedef typename FixedImageType::RegionType                  FixedImageRegionType;
+  typedef typename TransformType::JacobianType                 JacobianType;
+  typedef typename TransformType::NonZeroJacobianIndicesType   NonZeroJacobianIndicesType;
+  typedef ScaledSingleValuedNonLinearOptimizer::ScalesType     ScalesType;
+  typedef ScaledSingleValuedNonLinearOptimizer::DerivativeType DerivativeType;
+
+  itkStaticConstMacro( FixedImageDimension, unsigned int,
+    TFixedImage::ImageDimension );
+  typedef SpatialObject< itkGetStaticConstMacro( FixedImageDimension ) > FixedImageMaskType;
+
+  typedef ImageGridSampler< FixedImageType >         ImageGridSamplerType;
+  typedef typename ImageGridSamplerType::Pointer     ImageGridSamplerPointer;
+  typedef typename ImageGridSamplerType
+    ::ImageSampleContainerType ImageSampleContainerType;
+  typedef typename ImageSampleContainerType::Pointer ImageSampleContainerPointer;
+
+  /** Sample the fixed image on a grid, such that approximately
+   * numberOfJacobianMeasurements samples are obtained. Throws an exception
+   * when no valid sample is found, e.g. due to the mask.
+   */
+  static void SampleFixedImage(
+    const FixedImageType * fixedImage,
+    const FixedImageRegionType & fixedImageRegion,
+    const FixedImageMaskType * fixedImageMask,
+    const SizeValueType numberOfJacobianMeasurements,
+    ImageSampleContainerPointer & sampleContainer );
+
+  /** Divide column pi of the Jacobian by the scale of parameter jacind[pi]. */
+  static void ApplyScales( const ScalesType & scales,
+    const NonZeroJacobianIndicesType & jacind, JacobianType & jacj );
+
+  /** Compute JJ_j = ||J_j||_F^2 + 2\sqrt{2} || J_j J_j^T ||_F.
+   * Only the upper triangle of the symmetric product J_j J_j^T is formed,
+   * from the nonzero columns of J_j, and ||J_j||_F^2 is taken as its trace.
+   */
+  static double ComputeJJ( const JacobianType & jacj );
+
+  /** Compute the displacement magnitude || J_j g ||, where g is a full
+   * parameter vector that is indexed by the nonzero Jacobian indices.
+   */
+  static double ComputeDisplacementMagnitude( const JacobianType & jacj,
+    const NonZeroJacobianIndicesType & jacind, const DerivativeType & gradient );
+
+private:
+
+  JacobianTermsKernel();              // purposely not implemented
+  JacobianTermsKernel( const Self & ); // purposely not implemented
+  void operator=( const Self & );     // purposely not implemented
+
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkJacobianTermsKernel.hxx"
+#endif
+
+#endif // end #ifndef __itkJacobianTermsKernel_h
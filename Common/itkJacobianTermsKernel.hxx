@@ -0,0 +1,170 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkJacobianTermsKernel_hxx
+#define __itkJacobianTermsKernel_hxx
+
+#include "itkJacobianTermsKernel.h"
+
+#include "vnl/vnl_math.h"
+
+namespace itk
+{
+
+/**
+ * ************************* SampleFixedImage ************************
+ */
+
+template< class TFixedImage, class TTransform >
+void
+JacobianTermsKernel< TFixedImage, TTransform >
+::SampleFixedImage(
+  const FixedImageType * fixedImage,
+  const FixedImageRegionType & fixedImageRegion,
+  const FixedImageMaskType * fixedImageMask,
+  const SizeValueType numberOfJacobianMeasurements,
+  ImageSampleContainerPointer & sampleContainer )
+{
+  /** Set up grid sampler. */
+  ImageGridSamplerPointer sampler = ImageGridSamplerType::New();
+  sampler->SetInput( fixedImage );
+  sampler->SetInputImageRegion( fixedImageRegion );
+  sampler->SetMask( fixedImageMask );
+
+  /** Determine grid spacing of sampler such that the desired
+   * NumberOfJacobianMeasurements is achieved approximately.
+   * Note that the actually obtained number of samples may be lower, due to masks.
+   * This is taken into account at the end of this function.
+   */
+  SizeValueType nrofsamples = numberOfJacobianMeasurements;
+  sampler->SetNumberOfSamples( nrofsamples );
+
+  /** Get samples and check the actually obtained number of samples. */
+  sampler->Update();
+  sampleContainer = sampler->GetOutput();
+  nrofsamples     = sampleContainer->Size();
+
+  if( nrofsamples == 0 )
+  {
+    itkGenericExceptionMacro(
+        << "No valid voxels (0/" << numberOfJacobianMeasurements
+        << ") found to estimate the AdaptiveStochasticGradientDescent parameters." );
+  }
+
+} // end SampleFixedImage()
+
+
+/**
+ * ************************* ApplyScales ************************
+ */
+
+template< class TFixedImage, class TTransform >
+void
+JacobianTermsKernel< TFixedImage, TTransform >
+::ApplyScales( const ScalesType & scales,
+  const NonZeroJacobianIndicesType & jacind, JacobianType & jacj )
+{
+  const unsigned int sizejacind = jacj.cols();
+  for( unsigned int pi = 0; pi < sizejacind; ++pi )
+  {
+    jacj.scale_column( pi, 1.0 / scales[ jacind[ pi ] ] );
+  }
+
+} // end ApplyScales()
+
+
+/**
+ * ************************* ComputeJJ ************************
+ */
+
+template< class TFixedImage, class TTransform >
+double
+JacobianTermsKernel< TFixedImage, TTransform >
+::ComputeJJ( const JacobianType & jacj )
+{
+  const unsigned int outdim     = jacj.rows();
+  const unsigned int sizejacind = jacj.cols();
+
+  /** Loop over the upper triangle of J_j J_j^T. The diagonal elements
+   * sum to ||J_j||_F^2, the off-diagonal ones count twice in the norm.
+   */
+  double trace      = 0.0;
+  double sumSqrDiag = 0.0;
+  double sumSqrOff  = 0.0;
+  for( unsigned int i = 0; i < outdim; ++i )
+  {
+    const double * rowi = jacj[ i ];
+    for( unsigned int j = i; j < outdim; ++j )
+    {
+      const double * rowj = jacj[ j ];
+      double         dot  = 0.0;
+      for( unsigned int k = 0; k < sizejacind; ++k )
+      {
+        dot += rowi[ k ] * rowj[ k ];
+      }
+
+      if( i == j )
+      {
+        trace      += dot;
+        sumSqrDiag += dot * dot;
+      }
+      else
+      {
+        sumSqrOff += dot * dot;
+      }
+    }
+  }
+
+  const double sqrt2 = vcl_sqrt( static_cast< double >( 2.0 ) );
+  return trace + 2.0 * sqrt2 * vcl_sqrt( sumSqrDiag + 2.0 * sumSqrOff );
+
+} // end ComputeJJ()
+
+
+/**
+ * ************************* ComputeDisplacementMagnitude ************************
+ */
+
+template< class TFixedImage, class TTransform >
+double
+JacobianTermsKernel< TFixedImage, TTransform >
+::ComputeDisplacementMagnitude( const JacobianType & jacj,
+  const NonZeroJacobianIndicesType & jacind, const DerivativeType & gradient )
+{
+  const unsigned int outdim     = jacj.rows();
+  const unsigned int sizejacind = jacj.cols();
+
+  double sumSqr = 0.0;
+  for( unsigned int i = 0; i < outdim; ++i )
+  {
+    const double * rowi = jacj[ i ];
+    double         temp = 0.0;
+    for( unsigned int j = 0; j < sizejacind; ++j )
+    {
+      temp += rowi[ j ] * gradient[ jacind[ j ] ];
+    }
+    sumSqr += temp * temp;
+  }
+
+  return vcl_sqrt( sumSqr );
+
+} // end ComputeDisplacementMagnitude()
+
+
+} // end namespace itk
+
+#endif // end #ifndef __itkJacobianTermsKernel_hxx
@@ -0,0 +1,154 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkMemoryMappedImageReader_h
+#define __itkMemoryMappedImageReader_h
+
+#include "itkImportImageContainer.h"
+#include "itkImageIOBase.h"
+#include <string>
+
+namespace itk
+{
+
+/** \class MemoryMappedImportImageContainer
+ * \brief Pixel container whose buffer is a private mapping of a file.
+ *
+ * The mapping is copy-on-write: the pixels may be modified without
+ * affecting the file. The mapping is removed when the container is
+ * destroyed.
+ */
+template< class TElementIdentifier, class TElement >
+class MemoryMappedImportImageContainer :
+  public ImportImageContainer< TElementIdentifier, TElement >
+{
+public:
+
+  /** Standard class typedefs. */
+  typedef MemoryMappedImportImageContainer                     Self;
+  typedef ImportImageContainer< TElementIdentifier, TElement > Superclass;
+  typedef SmartPointer< Self >                                 Pointer;
+  typedef SmartPointer< const Self >                           ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro( Self );
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro( MemoryMappedImportImageContainer, ImportImageContainer );
+
+  typedef TElementIdentifier ElementIdentifier;
+  typedef TElement           Element;
+
+  /** Map numberOfElements elements of a file, starting at byte dataOffset.
+   * The mapping starts at a page boundary. If dataOffset is not a multiple
+   * of the element size, the pixels would not be aligned in memory, so they
+   * are copied into a buffer owned by the container and the file is
+   * unmapped. Returns false, leaving the container untouched, if the file
+   * cannot be mapped or is too short.
+   */
+  bool MapFile( const std::string & fileName, std::size_t dataOffset,
+    ElementIdentifier numberOfElements );
+
+  /** Whether the last call to MapFile() copied the pixels. */
+  bool GetDataIsCopied( void ) const
+  {
+    return this->m_DataIsCopied;
+  }
+
+protected:
+
+  MemoryMappedImportImageContainer();
+  virtual ~MemoryMappedImportImageContainer();
+
+  /** Remove the mapping, if any. */
+  void UnmapFile( void );
+
+private:
+
+  MemoryMappedImportImageContainer( const Self & ); // purposely not implemented
+  void operator=( const Self & );                   // purposely not implemented
+
+  void *      m_MappedAddress;
+  std::size_t m_MappedLength;
+  bool        m_DataIsCopied;
+
+};
+
+/** \class MemoryMappedImageReader
+ * \brief Reads an image by mapping its file into memory, instead of copying it.
+ *
+ * This is possible for uncompressed MetaImage files (.mha and .mhd/.raw),
+ * of which the pixel type, number of components, dimension and byte order
+ * match the image type. The pixel data are paged in on demand, and a file
+ * that is mapped by several processes occupies physical memory only once.
+ *
+ * The data offset is taken from the header: for .mha files the data start
+ * right after the ElementDataFile line, for separate data files at
+ * HeaderSize, or at the end of the file if HeaderSize is -1. When that
+ * offset is not a multiple of the pixel size, which is usually the case
+ * for .mha files, the mapped pixels are copied once (see
+ * MemoryMappedImportImageContainer::MapFile()). So in practice zero-copy
+ * mapping needs .mhd/.raw pairs, with an aligned HeaderSize.
+ *
+ * Read() returns a null pointer if the file cannot be mapped, in which
+ * case the caller should use a normal ImageFileReader. Mapping is only
+ * supported on POSIX systems.
+ */
+template< class TImage >
+class MemoryMappedImageReader
+{
+public:
+
+  typedef TImage                                ImageType;
+  typedef typename ImageType::Pointer           ImagePointer;
+  typedef typename ImageType::PixelType         PixelType;
+  typedef typename ImageType::RegionType        RegionType;
+  typedef typename ImageType::SizeType          SizeType;
+  typedef typename ImageType::SpacingType       SpacingType;
+  typedef typename ImageType::PointType         PointType;
+  typedef typename ImageType::DirectionType     DirectionType;
+  typedef MemoryMappedImportImageContainer<
+    SizeValueType, PixelType >                  PixelContainerType;
+
+  itkStaticConstMacro( ImageDimension, unsigned int, ImageType::ImageDimension );
+
+  /** Map the file; returns a null pointer if that is not possible. If
+   * dataIsCopied is given, it tells whether the pixels had to be copied.
+   */
+  static ImagePointer Read( const std::string & fileName, bool * dataIsCopied = 0 );
+
+private:
+
+  /** Check the header and find the file that contains the pixel data. */
+  static bool CanMap( ImageIOBase * imageIO, const std::string & fileName,
+    std::string & dataFileName );
+
+  /** Find the byte offset of the pixel data in the data file, and check
+   * that the file is long enough to hold dataLength bytes from there.
+   */
+  static bool ComputeDataOffset( ImageIOBase * imageIO, const std::string & dataFileName,
+    bool dataIsLocal, std::size_t dataLength, std::size_t & dataOffset );
+
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkMemoryMappedImageReader.hxx"
+#endif
+
+#endif // end #ifndef __itkMemoryMappedImageReader_h
@@ -0,0 +1,356 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef _itkMemoryMappedImageReader_hxx
+#define _itkMemoryMappedImageReader_hxx
+
+#include "itkMemoryMappedImageReader.h"
+#include "itkMetaImageIO.h"
+#include "itkByteSwapper.h"
+#include "itksys/SystemTools.hxx"
+#include <cstring>
+#include <fstream>
+
+#if !defined( _WIN32 ) || defined( __CYGWIN__ )
+#define ELASTIX_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace itk
+{
+
+/**
+ * ******************* Constructor *******************
+ */
+
+template< class TElementIdentifier, class TElement >
+MemoryMappedImportImageContainer< TElementIdentifier, TElement >
+::MemoryMappedImportImageContainer()
+{
+  this->m_MappedAddress = 0;
+  this->m_MappedLength  = 0;
+  this->m_DataIsCopied  = false;
+
+} // end Constructor
+
+
+/**
+ * ******************* Destructor *******************
+ */
+
+template< class TElementIdentifier, class TElement >
+MemoryMappedImportImageContainer< TElementIdentifier, TElement >
+::~MemoryMappedImportImageContainer()
+{
+  this->UnmapFile();
+
+} // end Destructor
+
+
+/**
+ * ******************* MapFile *******************
+ */
+
+template< class TElementIdentifier, class TElement >
+bool
+MemoryMappedImportImageContainer< TElementIdentifier, TElement >
+::MapFile( const std::string & fileName, std::size_t dataOffset,
+  ElementIdentifier numberOfElements )
+{
+#ifdef ELASTIX_HAVE_MMAP
+  const int fileDescriptor = open( fileName.c_str(), O_RDONLY );
+  if( fileDescriptor < 0 )
+  {
+    return false;
+  }
+
+  /** The pixel data must lie within the file. */
+  struct stat fileStatus;
+  if( fstat( fileDescriptor, &fileStatus ) != 0 )
+  {
+    close( fileDescriptor );
+    return false;
+  }
+  const std::size_t fileLength = static_cast< std::size_t >( fileStatus.st_size );
+  const std::size_t dataLength = numberOfElements * sizeof( Element );
+  if( dataLength == 0 || dataOffset > fileLength || fileLength - dataOffset < dataLength )
+  {
+    close( fileDescriptor );
+    return false;
+  }
+
+  /** mmap needs an offset at a page boundary. */
+  const std::size_t pageSize     = static_cast< std::size_t >( sysconf( _SC_PAGESIZE ) );
+  const std::size_t mappedOffset = dataOffset - dataOffset % pageSize;
+  const std::size_t mappedLength = dataOffset - mappedOffset + dataLength;
+
+  /** A private mapping, so that writing to the pixels does not change the file. */
+  void * address = mmap( 0, mappedLength, PROT_READ | PROT_WRITE,
+    MAP_PRIVATE, fileDescriptor, static_cast< off_t >( mappedOffset ) );
+  close( fileDescriptor );
+  if( address == MAP_FAILED )
+  {
+    return false;
+  }
+  const char * data = static_cast< char * >( address ) + ( dataOffset - mappedOffset );
+
+  this->UnmapFile();
+  if( dataOffset % sizeof( Element ) == 0 )
+  {
+    this->m_MappedAddress = address;
+    this->m_MappedLength  = mappedLength;
+    this->m_DataIsCopied  = false;
+    this->SetImportPointer( reinterpret_cast< Element * >( const_cast< char * >( data ) ),
+      numberOfElements, false );
+  }
+  else
+  {
+    /** Unaligned pixels: copy them into a buffer that the container owns. */
+    Element * buffer = new Element[ numberOfElements ];
+    std::memcpy( buffer, data, dataLength );
+    munmap( address, mappedLength );
+    this->m_DataIsCopied = true;
+    this->SetImportPointer( buffer, numberOfElements, true );
+  }
+
+  return true;
+#else
+  return false;
+#endif
+
+} // end MapFile()
+
+
+/**
+ * ******************* UnmapFile *******************
+ */
+
+template< class TElementIdentifier, class TElement >
+void
+MemoryMappedImportImageContainer< TElementIdentifier, TElement >
+::UnmapFile( void )
+{
+#ifdef ELASTIX_HAVE_MMAP
+  if( this->m_MappedAddress )
+  {
+    munmap( this->m_MappedAddress, this->m_MappedLength );
+    this->m_MappedAddress = 0;
+    this->m_MappedLength  = 0;
+  }
+#endif
+
+} // end UnmapFile()
+
+
+/**
+ * ******************* CanMap *******************
+ */
+
+template< class TImage >
+bool
+MemoryMappedImageReader< TImage >
+::CanMap( ImageIOBase * imageIO, const std::string & fileName,
+  std::string & dataFileName )
+{
+  /** Only uncompressed binary MetaImage files with a single data file. */
+  MetaImageIO * metaImageIO = dynamic_cast< MetaImageIO * >( imageIO );
+  if( metaImageIO == 0 )
+  {
+    return false;
+  }
+  MetaImage * metaImage = metaImageIO->GetMetaImagePointer();
+  if( metaImage->CompressedData() || !metaImage->BinaryData() )
+  {
+    return false;
+  }
+
+  /** The pixels must be stored exactly as in memory. */
+  const bool fileIsBigEndian = imageIO->GetByteOrder() == ImageIOBase::BigEndian;
+  if( imageIO->GetNumberOfDimensions() != ImageDimension
+    || imageIO->GetNumberOfComponents() != 1
+    || imageIO->GetComponentType() != ImageIOBase::MapPixelType< PixelType >::CType
+    || imageIO->GetComponentSize() != sizeof( PixelType )
+    || fileIsBigEndian != ByteSwapper< int >::SystemIsBigEndian() )
+  {
+    return false;
+  }
+
+  /** Find the data file, which is relative to the header. */
+  const std::string elementDataFileName = metaImage->ElementDataFileName();
+  if( elementDataFileName == "LOCAL" )
+  {
+    dataFileName = fileName;
+  }
+  else if( elementDataFileName == "LIST"
+    || elementDataFileName.find( '%' ) != std::string::npos
+    || elementDataFileName.find( ' ' ) != std::string::npos )
+  {
+    return false;
+  }
+  else if( itksys::SystemTools::FileIsFullPath( elementDataFileName.c_str() ) )
+  {
+    dataFileName = elementDataFileName;
+  }
+  else
+  {
+    std::string path = itksys::SystemTools::GetFilenamePath( fileName );
+    dataFileName = path.empty() ? elementDataFileName : path + "/" + elementDataFileName;
+  }
+
+  return true;
+
+} // end CanMap()
+
+
+/**
+ * ******************* ComputeDataOffset *******************
+ */
+
+template< class TImage >
+bool
+MemoryMappedImageReader< TImage >
+::ComputeDataOffset( ImageIOBase * imageIO, const std::string & dataFileName,
+  bool dataIsLocal, std::size_t dataLength, std::size_t & dataOffset )
+{
+  const std::size_t fileLength = static_cast< std::size_t >(
+    itksys::SystemTools::FileLength( dataFileName.c_str() ) );
+
+  if( dataIsLocal )
+  {
+    /** In a .mha file, ElementDataFile is the last field of the header,
+     * and the pixel data start right after its line.
+     */
+    std::ifstream file( dataFileName.c_str(), std::ios::in | std::ios::binary );
+    std::string   line;
+    bool          found = false;
+    while( !found && std::getline( file, line ) )
+    {
+      const std::string::size_type first = line.find_first_not_of( " \t" );
+      found = first != std::string::npos
+        && line.compare( first, 15, "ElementDataFile" ) == 0;
+    }
+    if( !found || file.eof() )
+    {
+      return false;
+    }
+    dataOffset = static_cast< std::size_t >( file.tellg() );
+  }
+  else
+  {
+    /** A separate data file may start with a header of HeaderSize bytes;
+     * -1 means that the pixel data are at the end of the file.
+     */
+    MetaImage * metaImage = dynamic_cast< MetaImageIO * >( imageIO )->GetMetaImagePointer();
+    const int   headerSize = metaImage->HeaderSize();
+    if( headerSize >= 0 )
+    {
+      dataOffset = static_cast< std::size_t >( headerSize );
+    }
+    else if( fileLength >= dataLength )
+    {
+      dataOffset = fileLength - dataLength;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  return dataOffset <= fileLength && fileLength - dataOffset >= dataLength;
+
+} // end ComputeDataOffset()
+
+
+/**
+ * ******************* Read *******************
+ */
+
+template< class TImage >
+typename MemoryMappedImageReader< TImage >::ImagePointer
+MemoryMappedImageReader< TImage >
+::Read( const std::string & fileName, bool * dataIsCopied )
+{
+  /** Read the header. */
+  MetaImageIO::Pointer imageIO = MetaImageIO::New();
+  if( !imageIO->CanReadFile( fileName.c_str() ) )
+  {
+    return 0;
+  }
+  imageIO->SetFileName( fileName );
+  imageIO->ReadImageInformation();
+
+  std::string dataFileName;
+  if( !CanMap( imageIO, fileName, dataFileName ) )
+  {
+    return 0;
+  }
+
+  /** Copy the geometry. */
+  SizeType      size;
+  SpacingType   spacing;
+  PointType     origin;
+  DirectionType direction;
+  for( unsigned int i = 0; i < ImageDimension; ++i )
+  {
+    size[ i ]    = imageIO->GetDimensions( i );
+    spacing[ i ] = imageIO->GetSpacing( i );
+    origin[ i ]  = imageIO->GetOrigin( i );
+    const std::vector< double > axis = imageIO->GetDirection( i );
+    for( unsigned int j = 0; j < ImageDimension; ++j )
+    {
+      direction[ j ][ i ] = axis[ j ];
+    }
+  }
+  RegionType region;
+  region.SetSize( size );
+
+  /** Map the pixel data. */
+  const std::size_t numberOfPixels = region.GetNumberOfPixels();
+  std::size_t       dataOffset     = 0;
+  if( !ComputeDataOffset( imageIO, dataFileName, dataFileName == fileName,
+    numberOfPixels * sizeof( PixelType ), dataOffset ) )
+  {
+    return 0;
+  }
+  typename PixelContainerType::Pointer container = PixelContainerType::New();
+  if( !container->MapFile( dataFileName, dataOffset, numberOfPixels ) )
+  {
+    return 0;
+  }
+  if( dataIsCopied )
+  {
+    *dataIsCopied = container->GetDataIsCopied();
+  }
+
+  ImagePointer image = ImageType::New();
+  image->SetRegions( region );
+  image->SetSpacing( spacing );
+  image->SetOrigin( origin );
+  image->SetDirection( direction );
+  image->SetPixelContainer( container );
+
+  return image;
+
+} // end Read()
+
+
+} // end namespace itk
+
+#endif // end #ifndef _itkMemoryMappedImageReader_hxx
@@ -71,11 +71,16 @@ namespace itk
  *               Uses mirror boundary conditions.
  *               Can only process LargestPossibleRegion
  *
+ * The recursive filters are applied in place on the output buffer. Along
+ * each dimension except the first, blocks of neighbouring lines are
+ * filtered together, so that the innermost loop runs over contiguous
+ * memory. When elastix is built with OpenMP, the lines (or blocks of
+ * lines) are distributed over the threads.
+ *
  * \sa itkBSplineInterpolateImageFunction
  *
  *  ***TODO: Is this an ImageFilter?  or does it belong to another group?
  * \ingroup ImageFilters
- * \ingroup SingleThreaded
  * \ingroup CannotBeStreamed
  */
 template< class TInputImage, class TOutputImage >
@@ -102,7 +107,8 @@ public:
   typedef typename Superclass::InputImageConstPointer InputImageConstPointer;
   typedef typename Superclass::OutputImagePointer     OutputImagePointer;
 
-  typedef typename itk::NumericTraits< typename TOutputImage::PixelType >::RealType CoeffType;
+  typedef typename TOutputImage::PixelType                         OutputPixelType;
+  typedef typename itk::NumericTraits< OutputPixelType >::RealType CoeffType;
 
   /** Dimension underlying input image. */
   itkStaticConstMacro( ImageDimension, unsigned int, TInputImage::ImageDimension );
@@ -153,14 +159,12 @@ protected:
   void EnlargeOutputRequestedRegion( DataObject * output );
 
   /** These are needed by the smoothing spline routine. */
-  std::vector< CoeffType > m_Scratch;             // temp storage for processing of Coefficients
   typename TInputImage::SizeType m_DataLength;    // Image size
 
   unsigned int m_SplineOrder[ ImageDimension ];            // User specified spline order per dimension (3rd or cubic is the default)
   double       m_SplinePoles[ 3 ];                         // Poles calculated for a given spline order
   int          m_NumberOfPoles;                            // number of poles
   double       m_Tolerance;                                // Tolerance used for determining initial causal coefficient
-  unsigned int m_IteratorDirection;                        // Direction for iterator incrementing
 
 private:
 
@@ -170,28 +174,32 @@ private:
   /** Determines the poles for dimension given the Spline Order. */
   virtual void SetPoles( unsigned int dimension );
 
-  /** Converts a vector of data to a vector of Spline coefficients. */
-  virtual bool DataToCoefficients1D();
+  /** The maximum number of neighbouring lines that are filtered together. */
+  itkStaticConstMacro( LineBlockSize, unsigned int, 16 );
+
+  /** Converts a block of neighbouring lines of data to spline coefficients,
+   * in place. The lines start at data, data + 1, ..., data + numberOfLines - 1,
+   * and consecutive elements of a line are stride apart. Uses the poles of
+   * the current dimension, but does not modify the filter.
+   */
+  void DataToCoefficientsLines( OutputPixelType * data, SizeValueType length,
+    SizeValueType stride, unsigned int numberOfLines ) const;
 
   /** Converts an N-dimension image of data to an equivalent sized image
    *    of spline coefficients. */
   void DataToCoefficientsND();
 
-  /** Determines the first coefficient for the causal filtering of the data. */
-  virtual void SetInitialCausalCoefficient( double z );
+  /** Determines the first coefficients for the causal filtering of a block of lines. */
+  void SetInitialCausalCoefficients( OutputPixelType * data, SizeValueType length,
+    SizeValueType stride, unsigned int numberOfLines, double z ) const;
 
-  /** Determines the first coefficient for the anti-causal filtering of the data. */
-  virtual void SetInitialAntiCausalCoefficient( double z );
+  /** Determines the first coefficients for the anti-causal filtering of a block of lines. */
+  void SetInitialAntiCausalCoefficients( OutputPixelType * data, SizeValueType length,
+    SizeValueType stride, unsigned int numberOfLines, double z ) const;
 
   /** Used to initialize the Coefficients image before calculation. */
   void CopyImageToImage();
 
-  /** Copies a vector of data from the Coefficients image to the m_Scratch vector. */
-  void CopyCoefficientsToScratch( OutputLinearIterator & );
-
-  /** Copies a vector of data from m_Scratch to the Coefficients image. */
-  void CopyScratchToCoefficients( OutputLinearIterator & );
-
 };
 
 } // namespace itk
@@ -84,10 +84,14 @@ MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
 }
 
 
+/**
+ * Filter a block of neighbouring lines in place
+ */
 template< class TInputImage, class TOutputImage >
-bool
+void
 MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
-::DataToCoefficients1D()
+::DataToCoefficientsLines( OutputPixelType * data, SizeValueType length,
+  SizeValueType stride, unsigned int numberOfLines ) const
 {
 
   // See Unser, 1993, Part II, Equation 2.5,
@@ -95,9 +99,9 @@ MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
 
   double c0 = 1.0;
 
-  if( m_DataLength[ m_IteratorDirection ] == 1 ) //Required by mirror boundaries
+  if( length == 1 ) //Required by mirror boundaries
   {
-    return false;
+    return;
   }
 
   // Compute overall gain
@@ -108,31 +112,46 @@ MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
   }
 
   // apply the gain
-  for( unsigned int n = 0; n < m_DataLength[ m_IteratorDirection ]; n++ )
+  for( SizeValueType n = 0; n < length; n++ )
   {
-    m_Scratch[ n ] *= c0;
+    OutputPixelType * x = data + n * stride;
+    for( unsigned int j = 0; j < numberOfLines; j++ )
+    {
+      x[ j ] = static_cast< OutputPixelType >( c0 * x[ j ] );
+    }
   }
 
   // loop over all poles
   for( int k = 0; k < m_NumberOfPoles; k++ )
   {
+    const double z = m_SplinePoles[ k ];
+
     // causal initialization
-    this->SetInitialCausalCoefficient( m_SplinePoles[ k ] );
-    // causal recursion
-    for( unsigned int n = 1; n < m_DataLength[ m_IteratorDirection ]; n++ )
+    this->SetInitialCausalCoefficients( data, length, stride, numberOfLines, z );
+    // causal recursion; the inner loop runs over neighbouring lines
+    for( SizeValueType n = 1; n < length; n++ )
     {
-      m_Scratch[ n ] += m_SplinePoles[ k ] * m_Scratch[ n - 1 ];
+      OutputPixelType *       x    = data + n * stride;
+      const OutputPixelType * prev = x - stride;
+      for( unsigned int j = 0; j < numberOfLines; j++ )
+      {
+        x[ j ] = static_cast< OutputPixelType >( x[ j ] + z * prev[ j ] );
+      }
     }
 
     // anticausal initialization
-    this->SetInitialAntiCausalCoefficient( m_SplinePoles[ k ] );
+    this->SetInitialAntiCausalCoefficients( data, length, stride, numberOfLines, z );
     // anticausal recursion
-    for( int n = m_DataLength[ m_IteratorDirection ] - 2; 0 <= n; n-- )
+    for( long n = static_cast< long >( length ) - 2; 0 <= n; n-- )
     {
-      m_Scratch[ n ] = m_SplinePoles[ k ] * ( m_Scratch[ n + 1 ] - m_Scratch[ n ] );
+      OutputPixelType *       x    = data + n * stride;
+      const OutputPixelType * next = x + stride;
+      for( unsigned int j = 0; j < numberOfLines; j++ )
+      {
+        x[ j ] = static_cast< OutputPixelType >( z * ( next[ j ] - x[ j ] ) );
+      }
     }
   }
-  return true;
 
 }
 
@@ -225,46 +244,68 @@ MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
 template< class TInputImage, class TOutputImage >
 void
 MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
-::SetInitialCausalCoefficient( double z )
+::SetInitialCausalCoefficients( OutputPixelType * data, SizeValueType length,
+  SizeValueType stride, unsigned int numberOfLines, double z ) const
 {
   /* begining InitialCausalCoefficient */
   /* See Unser, 1999, Box 2 for explaination */
-  CoeffType     sum;
+  CoeffType     sum[ LineBlockSize ];
   double        zn, z2n, iz;
   unsigned long horizon;
 
   /* this initialization corresponds to mirror boundaries */
-  horizon = m_DataLength[ m_IteratorDirection ];
+  horizon = length;
   zn      = z;
   if( m_Tolerance > 0.0 )
   {
     horizon = (long)vcl_ceil( vcl_log( m_Tolerance ) / vcl_log( vcl_fabs( z ) ) );
   }
-  if( horizon < m_DataLength[ m_IteratorDirection ] )
+  if( horizon < length )
   {
     /* accelerated loop */
-    sum = m_Scratch[ 0 ];   // verify this
-    for( unsigned int n = 1; n < horizon; n++ )
+    for( unsigned int j = 0; j < numberOfLines; j++ )
     {
-      sum += zn * m_Scratch[ n ];
-      zn  *= z;
+      sum[ j ] = data[ j ];
+    }
+    for( unsigned long n = 1; n < horizon; n++ )
+    {
+      const OutputPixelType * x = data + n * stride;
+      for( unsigned int j = 0; j < numberOfLines; j++ )
+      {
+        sum[ j ] += zn * x[ j ];
+      }
+      zn *= z;
+    }
+    for( unsigned int j = 0; j < numberOfLines; j++ )
+    {
+      data[ j ] = static_cast< OutputPixelType >( sum[ j ] );
     }
-    m_Scratch[ 0 ] = sum;
   }
   else
   {
     /* full loop */
-    iz   = 1.0 / z;
-    z2n  = vcl_pow( z, (double)( m_DataLength[ m_IteratorDirection ] - 1L ) );
-    sum  = m_Scratch[ 0 ] + z2n * m_Scratch[ m_DataLength[ m_IteratorDirection ] - 1L ];
+    const OutputPixelType * last = data + ( length - 1 ) * stride;
+    iz  = 1.0 / z;
+    z2n = vcl_pow( z, (double)( length - 1L ) );
+    for( unsigned int j = 0; j < numberOfLines; j++ )
+    {
+      sum[ j ] = data[ j ] + z2n * last[ j ];
+    }
     z2n *= z2n * iz;
-    for( unsigned int n = 1; n <= ( m_DataLength[ m_IteratorDirection ] - 2 ); n++ )
+    for( SizeValueType n = 1; n <= ( length - 2 ); n++ )
     {
-      sum += ( zn + z2n ) * m_Scratch[ n ];
+      const OutputPixelType * x = data + n * stride;
+      for( unsigned int j = 0; j < numberOfLines; j++ )
+      {
+        sum[ j ] += ( zn + z2n ) * x[ j ];
+      }
       zn  *= z;
       z2n *= iz;
     }
-    m_Scratch[ 0 ] = sum / ( 1.0 - zn * zn );
+    for( unsigned int j = 0; j < numberOfLines; j++ )
+    {
+      data[ j ] = static_cast< OutputPixelType >( sum[ j ] / ( 1.0 - zn * zn ) );
+    }
   }
 }
 
@@ -272,14 +313,19 @@ MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
 template< class TInputImage, class TOutputImage >
 void
 MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
-::SetInitialAntiCausalCoefficient( double z )
+::SetInitialAntiCausalCoefficients( OutputPixelType * data, SizeValueType length,
+  SizeValueType stride, unsigned int numberOfLines, double z ) const
 {
   // this initialization corresponds to mirror boundaries
   /* See Unser, 1999, Box 2 for explaination */
   //  Also see erratum at http://bigwww.epfl.ch/publications/unser9902.html
-  m_Scratch[ m_DataLength[ m_IteratorDirection ] - 1 ]
-    = ( z / ( z * z - 1.0 ) )
-    * ( z * m_Scratch[ m_DataLength[ m_IteratorDirection ] - 2 ] + m_Scratch[ m_DataLength[ m_IteratorDirection ] - 1 ] );
+  OutputPixelType *       last = data + ( length - 1 ) * stride;
+  const OutputPixelType * prev = last - stride;
+  for( unsigned int j = 0; j < numberOfLines; j++ )
+  {
+    last[ j ] = static_cast< OutputPixelType >(
+      ( z / ( z * z - 1.0 ) ) * ( z * prev[ j ] + last[ j ] ) );
+  }
 }
 
 
@@ -292,40 +338,53 @@ MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
 
   Size< ImageDimension > size = output->GetBufferedRegion().GetSize();
 
-  unsigned int count = output->GetBufferedRegion().GetNumberOfPixels() / size[ 0 ] * ImageDimension;
+  const SizeValueType numberOfPixels = output->GetBufferedRegion().GetNumberOfPixels();
 
-  ProgressReporter progress( this, 0, count, 10 );
+  ProgressReporter progress( this, 0, ImageDimension );
 
   // Initialize coeffient array
   this->CopyImageToImage();   // Coefficients are initialized to the input data
 
+  OutputPixelType * buffer = output->GetBufferPointer();
+
+  // Distance in the buffer between consecutive elements of a line
+  SizeValueType       stride    = 1;
+  const SizeValueType blockSize = LineBlockSize;
   for( unsigned int n = 0; n < ImageDimension; n++ )
   {
-    m_IteratorDirection = n;
     // Loop through each dimension
+    const SizeValueType length = size[ n ];
 
     // Compute poles for this dimension
     this->SetPoles( n );
 
-    // Initialize iterators
-    OutputLinearIterator CIterator( output, output->GetBufferedRegion() );
-    CIterator.SetDirection( m_IteratorDirection );
-    // For each data vector
-    while( !CIterator.IsAtEnd() )
+    // Orders without poles, and lines of length 1, leave the data unchanged
+    if( m_NumberOfPoles > 0 && length > 1 )
     {
-      // Copy coefficients to scratch
-      this->CopyCoefficientsToScratch( CIterator );
-
-      // Perform 1D BSpline calculations
-      this->DataToCoefficients1D();
-
-      // Copy scratch back to coefficients.
-      // Brings us back to the end of the line we were working on.
-      CIterator.GoToBeginOfLine();
-      this->CopyScratchToCoefficients( CIterator ); // m_Scratch = m_Image;
-      CIterator.NextLine();
-      progress.CompletedPixel();
+      // The buffer consists of slabs of length * stride elements. Within a
+      // slab the lines start at the first stride elements, so these lines
+      // are neighbours in memory and are processed in blocks.
+      const SizeValueType numberOfSlabs  = numberOfPixels / ( length * stride );
+      const SizeValueType blocksPerSlab  = ( stride + blockSize - 1 ) / blockSize;
+      const long          numberOfBlocks = static_cast< long >( numberOfSlabs * blocksPerSlab );
+
+#ifdef ELASTIX_USE_OPENMP
+      #pragma omp parallel for schedule( static )
+#endif
+      for( long b = 0; b < numberOfBlocks; ++b )
+      {
+        const SizeValueType slab  = static_cast< SizeValueType >( b ) / blocksPerSlab;
+        const SizeValueType first = ( static_cast< SizeValueType >( b ) % blocksPerSlab ) * blockSize;
+        const unsigned int  numberOfLines = static_cast< unsigned int >(
+          stride - first < blockSize ? stride - first : blockSize );
+
+        this->DataToCoefficientsLines( buffer + slab * length * stride + first,
+          length, stride, numberOfLines );
+      }
     }
+
+    stride *= length;
+    progress.CompletedPixel();
   }
 }
 
@@ -340,7 +399,6 @@ MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
 {
   typedef ImageRegionConstIteratorWithIndex< TInputImage > InputIterator;
   typedef ImageRegionIterator< TOutputImage >              OutputIterator;
-  typedef typename TOutputImage::PixelType                 OutputPixelType;
 
   InputIterator  inIt( this->GetInput(), this->GetInput()->GetBufferedRegion() );
   OutputIterator outIt( this->GetOutput(), this->GetOutput()->GetBufferedRegion() );
@@ -356,44 +414,6 @@ MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
 }
 
 
-/**
- * Copy the scratch to one line of the output image
- */
-template< class TInputImage, class TOutputImage >
-void
-MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
-::CopyScratchToCoefficients( OutputLinearIterator & Iter )
-{
-  typedef typename TOutputImage::PixelType OutputPixelType;
-  unsigned long j = 0;
-  while( !Iter.IsAtEndOfLine() )
-  {
-    Iter.Set( static_cast< OutputPixelType >( m_Scratch[ j ] ) );
-    ++Iter;
-    ++j;
-  }
-
-}
-
-
-/**
- * Copy one line of the output image to the scratch
- */
-template< class TInputImage, class TOutputImage >
-void
-MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
-::CopyCoefficientsToScratch( OutputLinearIterator & Iter )
-{
-  unsigned long j = 0;
-  while( !Iter.IsAtEndOfLine() )
-  {
-    m_Scratch[ j ] = static_cast< CoeffType >( Iter.Get() );
-    ++Iter;
-    ++j;
-  }
-}
-
-
 /**
  * GenerateInputRequestedRegion method.
  */
@@ -443,20 +463,9 @@ MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
 ::GenerateData()
 {
 
-  // Allocate scratch memory
   InputImageConstPointer inputPtr = this->GetInput();
   m_DataLength = inputPtr->GetBufferedRegion().GetSize();
 
-  unsigned long maxLength = 0;
-  for( unsigned int n = 0; n < ImageDimension; n++ )
-  {
-    if( m_DataLength[ n ] > maxLength )
-    {
-      maxLength = m_DataLength[ n ];
-    }
-  }
-  m_Scratch.resize( maxLength );
-
   // Allocate memory for output image
   OutputImagePointer outputPtr = this->GetOutput();
   outputPtr->SetBufferedRegion( outputPtr->GetRequestedRegion() );
@@ -465,9 +474,6 @@ MultiOrderBSplineDecompositionImageFilter< TInputImage, TOutputImage >
   // Calculate actual output
   this->DataToCoefficientsND();
 
-  // Clean up
-  m_Scratch.clear();
-
 }
 
 
@@ -118,6 +118,11 @@ namespace itk
  *
  * This filter supports streaming.
  *
+ * With SetComputeOnlyForCurrentLevel() only the output of the level set by
+ * SetCurrentLevel() is computed, and the outputs of the other levels are
+ * released. Since the outputs are not downsampled, this saves a full size
+ * image per level.
+ *
  * \ingroup PyramidImageFilter Multithreaded Streamed
  */
 template<
@@ -187,6 +192,23 @@ public:
    * ProcessObject::GenerateInputRequestedRegion() */
   virtual void GenerateInputRequestedRegion();
 
+  /** Set the current multi-resolution levels. The current level is clamped to
+   * a total number of levels.
+   */
+  virtual void SetCurrentLevel( unsigned int level );
+
+  /** Get the current multi-resolution level. */
+  itkGetConstReferenceMacro( CurrentLevel, unsigned int );
+
+  /** Set a control on whether only the current level is computed. The
+   * outputs of the other levels are then released, so that only one level
+   * of the pyramid is kept in memory.
+   */
+  virtual void SetComputeOnlyForCurrentLevel( const bool _arg );
+
+  itkGetConstMacro( ComputeOnlyForCurrentLevel, bool );
+  itkBooleanMacro( ComputeOnlyForCurrentLevel );
+
 protected:
 
   MultiResolutionGaussianSmoothingPyramidImageFilter();
@@ -200,6 +222,17 @@ protected:
    * because it uses internally a filter that does this. */
   virtual void EnlargeOutputRequestedRegion( DataObject * output );
 
+  /** Checks whether we have to compute anything based on
+   * m_ComputeOnlyForCurrentLevel and m_CurrentLevel.
+   */
+  bool ComputeForCurrentLevel( const unsigned int level ) const;
+
+  /** Release the outputs of the levels other than the current one. */
+  void ReleaseOutputs( void );
+
+  unsigned int m_CurrentLevel;
+  bool         m_ComputeOnlyForCurrentLevel;
+
 private:
 
   MultiResolutionGaussianSmoothingPyramidImageFilter( const Self & ); // purposely not implemented
@@ -53,7 +53,10 @@ namespace itk
 template< class TInputImage, class TOutputImage >
 MultiResolutionGaussianSmoothingPyramidImageFilter< TInputImage, TOutputImage >
 ::MultiResolutionGaussianSmoothingPyramidImageFilter()
-{}
+{
+  this->m_CurrentLevel               = 0;
+  this->m_ComputeOnlyForCurrentLevel = false;
+}
 
 /*
  * Set the multi-resolution schedule
@@ -144,6 +147,11 @@ MultiResolutionGaussianSmoothingPyramidImageFilter< TInputImage, TOutputImage >
     this->UpdateProgress( static_cast< float >( ilevel )
       / static_cast< float >( this->m_NumberOfLevels ) );
 
+    if( !this->ComputeForCurrentLevel( ilevel ) )
+    {
+      continue;
+    }
+
     // Allocate memory for each output
     OutputImagePointer outputPtr = this->GetOutput( ilevel );
     outputPtr->SetBufferedRegion( outputPtr->GetRequestedRegion() );
@@ -208,6 +216,85 @@ MultiResolutionGaussianSmoothingPyramidImageFilter< TInputImage, TOutputImage >
 }
 
 
+
+/*
+ * SetCurrentLevel
+ */
+template< class TInputImage, class TOutputImage >
+void
+MultiResolutionGaussianSmoothingPyramidImageFilter< TInputImage, TOutputImage >
+::SetCurrentLevel( unsigned int level )
+{
+  itkDebugMacro( "setting CurrentLevel to " << level );
+  if( this->m_CurrentLevel != level )
+  {
+    // clamp value to be less then number of levels
+    this->m_CurrentLevel = level;
+    if( this->m_CurrentLevel >= this->m_NumberOfLevels )
+    {
+      this->m_CurrentLevel = this->m_NumberOfLevels - 1;
+    }
+    this->ReleaseOutputs();
+
+    /** Only set the modified flag for this filter if the output is computed per level. */
+    if( this->m_ComputeOnlyForCurrentLevel )
+    {
+      this->Modified();
+    }
+  }
+} // end SetCurrentLevel()
+
+
+/*
+ * SetComputeOnlyForCurrentLevel
+ */
+template< class TInputImage, class TOutputImage >
+void
+MultiResolutionGaussianSmoothingPyramidImageFilter< TInputImage, TOutputImage >
+::SetComputeOnlyForCurrentLevel( const bool _arg )
+{
+  itkDebugMacro( "setting ComputeOnlyForCurrentLevel to " << _arg );
+  if( this->m_ComputeOnlyForCurrentLevel != _arg )
+  {
+    this->m_ComputeOnlyForCurrentLevel = _arg;
+    this->ReleaseOutputs();
+    this->Modified();
+  }
+} // end SetComputeOnlyForCurrentLevel()
+
+
+/*
+ * ReleaseOutputs
+ */
+template< class TInputImage, class TOutputImage >
+void
+MultiResolutionGaussianSmoothingPyramidImageFilter< TInputImage, TOutputImage >
+::ReleaseOutputs( void )
+{
+  // release the memories if already has been allocated
+  for( unsigned int level = 0; level < this->m_NumberOfLevels; level++ )
+  {
+    if( this->m_ComputeOnlyForCurrentLevel && level != this->m_CurrentLevel
+      && this->GetOutput( level ) )
+    {
+      this->GetOutput( level )->Initialize();
+    }
+  }
+} // end ReleaseOutputs()
+
+
+/*
+ * ComputeForCurrentLevel
+ */
+template< class TInputImage, class TOutputImage >
+bool
+MultiResolutionGaussianSmoothingPyramidImageFilter< TInputImage, TOutputImage >
+::ComputeForCurrentLevel( const unsigned int level ) const
+{
+  return !this->m_ComputeOnlyForCurrentLevel || level == this->m_CurrentLevel;
+} // end ComputeForCurrentLevel()
+
+
 /*
  * PrintSelf method
  */
@@ -217,6 +304,9 @@ MultiResolutionGaussianSmoothingPyramidImageFilter< TInputImage, TOutputImage >
 ::PrintSelf( std::ostream & os, Indent indent ) const
 {
   Superclass::PrintSelf( os, indent );
+  os << indent << "CurrentLevel: " << this->m_CurrentLevel << std::endl;
+  os << indent << "ComputeOnlyForCurrentLevel: "
+     << ( this->m_ComputeOnlyForCurrentLevel ? "true" : "false" ) << std::endl;
 }
 
 
@@ -74,6 +74,23 @@ public:
   /** Overwrite the Superclass implementation: no padding required. */
   virtual void GenerateInputRequestedRegion( void );
 
+  /** Set the current multi-resolution levels. The current level is clamped to
+   * a total number of levels.
+   */
+  virtual void SetCurrentLevel( unsigned int level );
+
+  /** Get the current multi-resolution level. */
+  itkGetConstReferenceMacro( CurrentLevel, unsigned int );
+
+  /** Set a control on whether only the current level is computed. The
+   * outputs of the other levels are then released, so that only one level
+   * of the pyramid is kept in memory.
+   */
+  virtual void SetComputeOnlyForCurrentLevel( const bool _arg );
+
+  itkGetConstMacro( ComputeOnlyForCurrentLevel, bool );
+  itkBooleanMacro( ComputeOnlyForCurrentLevel );
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   /** Begin concept checking */
   itkConceptMacro( SameDimensionCheck,
@@ -85,12 +102,23 @@ public:
 
 protected:
 
-  MultiResolutionShrinkPyramidImageFilter() {}
+  MultiResolutionShrinkPyramidImageFilter();
   ~MultiResolutionShrinkPyramidImageFilter() {}
 
   /** Generate the output data. */
   virtual void GenerateData( void );
 
+  /** Checks whether we have to compute anything based on
+   * m_ComputeOnlyForCurrentLevel and m_CurrentLevel.
+   */
+  bool ComputeForCurrentLevel( const unsigned int level ) const;
+
+  /** Release the outputs of the levels other than the current one. */
+  void ReleaseOutputs( void );
+
+  unsigned int m_CurrentLevel;
+  bool         m_ComputeOnlyForCurrentLevel;
+
 private:
 
   MultiResolutionShrinkPyramidImageFilter( const Self & ); // purposely not implemented
@@ -26,6 +26,96 @@
 namespace itk
 {
 
+/*
+ * Constructor
+ */
+template< class TInputImage, class TOutputImage >
+MultiResolutionShrinkPyramidImageFilter< TInputImage, TOutputImage >
+::MultiResolutionShrinkPyramidImageFilter()
+{
+  this->m_CurrentLevel               = 0;
+  this->m_ComputeOnlyForCurrentLevel = false;
+} // end Constructor()
+
+
+/*
+ * SetCurrentLevel
+ */
+template< class TInputImage, class TOutputImage >
+void
+MultiResolutionShrinkPyramidImageFilter< TInputImage, TOutputImage >
+::SetCurrentLevel( unsigned int level )
+{
+  itkDebugMacro( "setting CurrentLevel to " << level );
+  if( this->m_CurrentLevel != level )
+  {
+    // clamp value to be less then number of levels
+    this->m_CurrentLevel = level;
+    if( this->m_CurrentLevel >= this->m_NumberOfLevels )
+    {
+      this->m_CurrentLevel = this->m_NumberOfLevels - 1;
+    }
+    this->ReleaseOutputs();
+
+    /** Only set the modified flag for this filter if the output is computed per level. */
+    if( this->m_ComputeOnlyForCurrentLevel )
+    {
+      this->Modified();
+    }
+  }
+} // end SetCurrentLevel()
+
+
+/*
+ * SetComputeOnlyForCurrentLevel
+ */
+template< class TInputImage, class TOutputImage >
+void
+MultiResolutionShrinkPyramidImageFilter< TInputImage, TOutputImage >
+::SetComputeOnlyForCurrentLevel( const bool _arg )
+{
+  itkDebugMacro( "setting ComputeOnlyForCurrentLevel to " << _arg );
+  if( this->m_ComputeOnlyForCurrentLevel != _arg )
+  {
+    this->m_ComputeOnlyForCurrentLevel = _arg;
+    this->ReleaseOutputs();
+    this->Modified();
+  }
+} // end SetComputeOnlyForCurrentLevel()
+
+
+/*
+ * ReleaseOutputs
+ */
+template< class TInputImage, class TOutputImage >
+void
+MultiResolutionShrinkPyramidImageFilter< TInputImage, TOutputImage >
+::ReleaseOutputs( void )
+{
+  // release the memories if already has been allocated
+  for( unsigned int level = 0; level < this->m_NumberOfLevels; level++ )
+  {
+    if( this->m_ComputeOnlyForCurrentLevel && level != this->m_CurrentLevel
+      && this->GetOutput( level ) )
+    {
+      this->GetOutput( level )->Initialize();
+    }
+  }
+} // end ReleaseOutputs()
+
+
+/*
+ * ComputeForCurrentLevel
+ */
+template< class TInputImage, class TOutputImage >
+bool
+MultiResolutionShrinkPyramidImageFilter< TInputImage, TOutputImage >
+::ComputeForCurrentLevel( const unsigned int level ) const
+{
+  return !this->m_ComputeOnlyForCurrentLevel || level == this->m_CurrentLevel;
+} // end ComputeForCurrentLevel()
+
+
 /*
  * GenerateData
  */
@@ -46,6 +136,11 @@ MultiResolutionShrinkPyramidImageFilter< TInputImage, TOutputImage >
     this->UpdateProgress( static_cast< float >( ilevel )
       / static_cast< float >( this->m_NumberOfLevels ) );
 
+    if( !this->ComputeForCurrentLevel( ilevel ) )
+    {
+      continue;
+    }
+
     // Allocate memory for each output
     OutputImagePointer outputPtr = this->GetOutput( ilevel );
     outputPtr->SetBufferedRegion( outputPtr->GetRequestedRegion() );
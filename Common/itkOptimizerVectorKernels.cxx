@@ -0,0 +1,287 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkOptimizerVectorKernels.h"
+
+#include "vnl/vnl_math.h"
+
+namespace itk
+{
+
+/** Below this size thread start-up costs more than the loop itself. */
+const unsigned int OptimizerVectorKernels::MinimumNumberOfElementsPerThread = 32768;
+
+/**
+ * ********************* InnerProduct ****************************
+ */
+
+double
+OptimizerVectorKernels
+::InnerProduct( const VectorType & x, const VectorType & y )
+{
+  return Self::InnerProduct( x.data_block(), y.data_block(), x.GetSize() );
+
+} // end InnerProduct()
+
+
+double
+OptimizerVectorKernels
+::InnerProduct( const double * x, const double * y, const unsigned int n )
+{
+  const int ni  = static_cast< int >( n );
+  double    sum = 0.0;
+
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for reduction( + : sum ) schedule( static ) \
+  if( ni >= static_cast< int >( 2 * MinimumNumberOfElementsPerThread ) )
+#endif
+  for( int i = 0; i < ni; ++i )
+  {
+    sum += x[ i ] * y[ i ];
+  }
+
+  return sum;
+
+} // end InnerProduct()
+
+
+/**
+ * ********************* SquaredMagnitude ****************************
+ */
+
+double
+OptimizerVectorKernels
+::SquaredMagnitude( const VectorType & x )
+{
+  return Self::InnerProduct( x, x );
+
+} // end SquaredMagnitude()
+
+
+/**
+ * ********************* Magnitude ****************************
+ */
+
+double
+OptimizerVectorKernels
+::Magnitude( const VectorType & x )
+{
+  return vcl_sqrt( Self::InnerProduct( x, x ) );
+
+} // end Magnitude()
+
+
+/**
+ * ********************* Axpy ****************************
+ */
+
+void
+OptimizerVectorKernels
+::Axpy( const double a, const VectorType & x, VectorType & y )
+{
+  Self::Axpy( a, x.data_block(), y.data_block(), x.GetSize() );
+
+} // end Axpy()
+
+
+void
+OptimizerVectorKernels
+::Axpy( const double a, const double * x, double * y, const unsigned int n )
+{
+  const int ni = static_cast< int >( n );
+
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for schedule( static ) \
+  if( ni >= static_cast< int >( 2 * MinimumNumberOfElementsPerThread ) )
+#endif
+  for( int i = 0; i < ni; ++i )
+  {
+    y[ i ] += a * x[ i ];
+  }
+
+} // end Axpy()
+
+
+/**
+ * ********************* AxpyAndInnerProduct ****************************
+ */
+
+double
+OptimizerVectorKernels
+::AxpyAndInnerProduct( const double a, const double * x,
+  double * y, const double * z, const unsigned int n )
+{
+  const int ni  = static_cast< int >( n );
+  double    sum = 0.0;
+
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for reduction( + : sum ) schedule( static ) \
+  if( ni >= static_cast< int >( 2 * MinimumNumberOfElementsPerThread ) )
+#endif
+  for( int i = 0; i < ni; ++i )
+  {
+    const double yi = y[ i ] + a * x[ i ];
+    y[ i ] = yi;
+    sum   += z[ i ] * yi;
+  }
+
+  return sum;
+
+} // end AxpyAndInnerProduct()
+
+
+/**
+ * ********************* Axpby ****************************
+ */
+
+void
+OptimizerVectorKernels
+::Axpby( const double a, const VectorType & x, const double b, VectorType & y )
+{
+  const int      n     = static_cast< int >( x.GetSize() );
+  const double * xdata = x.data_block();
+  double *       ydata = y.data_block();
+
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for schedule( static ) \
+  if( n >= static_cast< int >( 2 * MinimumNumberOfElementsPerThread ) )
+#endif
+  for( int i = 0; i < n; ++i )
+  {
+    ydata[ i ] = a * xdata[ i ] + b * ydata[ i ];
+  }
+
+} // end Axpby()
+
+
+/**
+ * ********************* ScaledUpdate ****************************
+ */
+
+void
+OptimizerVectorKernels
+::ScaledUpdate( const VectorType & x, const double a,
+  const VectorType & d, VectorType & z )
+{
+  Self::ScaledUpdate( x.data_block(), a, d.data_block(), z.data_block(), x.GetSize() );
+
+} // end ScaledUpdate()
+
+
+void
+OptimizerVectorKernels
+::ScaledUpdate( const double * x, const double a,
+  const double * d, double * z, const unsigned int n )
+{
+  const int ni = static_cast< int >( n );
+
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for schedule( static ) \
+  if( ni >= static_cast< int >( 2 * MinimumNumberOfElementsPerThread ) )
+#endif
+  for( int i = 0; i < ni; ++i )
+  {
+    z[ i ] = x[ i ] + a * d[ i ];
+  }
+
+} // end ScaledUpdate()
+
+
+/**
+ * ********************* ElementWiseUpdate ****************************
+ */
+
+void
+OptimizerVectorKernels
+::ElementWiseUpdate( const VectorType & x,
+  const VectorType & d, const VectorType & f, VectorType & z )
+{
+  const int      n     = static_cast< int >( x.GetSize() );
+  const double * xdata = x.data_block();
+  const double * ddata = d.data_block();
+  const double * fdata = f.data_block();
+  double *       zdata = z.data_block();
+
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for schedule( static ) \
+  if( n >= static_cast< int >( 2 * MinimumNumberOfElementsPerThread ) )
+#endif
+  for( int i = 0; i < n; ++i )
+  {
+    zdata[ i ] = xdata[ i ] + ddata[ i ] * fdata[ i ];
+  }
+
+} // end ElementWiseUpdate()
+
+
+/**
+ * ********************* ElementWiseMultiply ****************************
+ */
+
+void
+OptimizerVectorKernels
+::ElementWiseMultiply( const VectorType & x, VectorType & y )
+{
+  const int      n     = static_cast< int >( x.GetSize() );
+  const double * xdata = x.data_block();
+  double *       ydata = y.data_block();
+
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for schedule( static ) \
+  if( n >= static_cast< int >( 2 * MinimumNumberOfElementsPerThread ) )
+#endif
+  for( int i = 0; i < n; ++i )
+  {
+    ydata[ i ] *= xdata[ i ];
+  }
+
+} // end ElementWiseMultiply()
+
+
+/**
+ * ********************* Scale ****************************
+ */
+
+void
+OptimizerVectorKernels
+::Scale( const double a, VectorType & x )
+{
+  Self::Scale( a, x.data_block(), x.data_block(), x.GetSize() );
+
+} // end Scale()
+
+
+void
+OptimizerVectorKernels
+::Scale( const double a, const double * x, double * z, const unsigned int n )
+{
+  const int ni = static_cast< int >( n );
+
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for schedule( static ) \
+  if( ni >= static_cast< int >( 2 * MinimumNumberOfElementsPerThread ) )
+#endif
+  for( int i = 0; i < ni; ++i )
+  {
+    z[ i ] = a * x[ i ];
+  }
+
+} // end Scale()
+
+
+} // end namespace itk
@@ -0,0 +1,109 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkOptimizerVectorKernels_h
+#define __itkOptimizerVectorKernels_h
+
+#include "itkArray.h"
+
+namespace itk
+{
+/** \class OptimizerVectorKernels
+ * \brief Threaded kernels for the parameter-vector arithmetic of the optimizers.
+ *
+ * The optimizers perform a few passes over the full parameter vector per
+ * iteration: a position update, inner products, norms. For transforms with
+ * millions of parameters these passes are no longer negligible compared to
+ * the cost function evaluation. This class collects them, using OpenMP
+ * when available and the vectors are large enough to amortise the thread
+ * start-up. None of the functions allocates memory.
+ *
+ * The output vectors must have the size of the input vectors, and may be
+ * the same object as one of the inputs. The overloads on raw pointers
+ * allow working on rows of a matrix, e.g. a history of vectors that is
+ * stored contiguously.
+ */
+
+class OptimizerVectorKernels
+{
+public:
+
+  /** Standard typedefs. */
+  typedef OptimizerVectorKernels Self;
+  typedef Array< double >        VectorType;
+
+  /** Return x^T y. */
+  static double InnerProduct( const VectorType & x, const VectorType & y );
+
+  static double InnerProduct( const double * x, const double * y,
+    const unsigned int n );
+
+  /** Return x^T x. */
+  static double SquaredMagnitude( const VectorType & x );
+
+  /** Return sqrt( x^T x ). */
+  static double Magnitude( const VectorType & x );
+
+  /** y = a x + y. */
+  static void Axpy( const double a, const VectorType & x, VectorType & y );
+
+  static void Axpy( const double a, const double * x, double * y,
+    const unsigned int n );
+
+  /** y = a x + y, and return z^T y of the updated y, in a single pass. */
+  static double AxpyAndInnerProduct( const double a, const double * x,
+    double * y, const double * z, const unsigned int n );
+
+  /** y = a x + b y. */
+  static void Axpby( const double a, const VectorType & x,
+    const double b, VectorType & y );
+
+  /** z = x + a d. Typically used as newPosition = position + step * direction. */
+  static void ScaledUpdate( const VectorType & x, const double a,
+    const VectorType & d, VectorType & z );
+
+  static void ScaledUpdate( const double * x, const double a,
+    const double * d, double * z, const unsigned int n );
+
+  /** z = x + d .* f, with .* the element-wise product. */
+  static void ElementWiseUpdate( const VectorType & x,
+    const VectorType & d, const VectorType & f, VectorType & z );
+
+  /** y = x .* y. */
+  static void ElementWiseMultiply( const VectorType & x, VectorType & y );
+
+  /** x = a x. */
+  static void Scale( const double a, VectorType & x );
+
+  /** z = a x. */
+  static void Scale( const double a, const double * x, double * z,
+    const unsigned int n );
+
+  /** Vectors with fewer elements are processed by a single thread. */
+  static const unsigned int MinimumNumberOfElementsPerThread;
+
+private:
+
+  OptimizerVectorKernels();               // purposely not implemented
+  OptimizerVectorKernels( const Self & ); // purposely not implemented
+  void operator=( const Self & );         // purposely not implemented
+
+};
+
+} // end namespace itk
+
+#endif // end #ifndef __itkOptimizerVectorKernels_h
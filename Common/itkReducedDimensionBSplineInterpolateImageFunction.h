@@ -45,6 +45,7 @@
 #include "vnl/vnl_matrix.h"
 
 #include "itkMultiOrderBSplineDecompositionImageFilter.h"
+#include "itkBSplineCoefficientImageCache.h"
 #include "itkConceptChecking.h"
 #include "itkCovariantVector.h"
 
@@ -174,6 +175,12 @@ public:
   /** Set the input image.  This must be set by the user. */
   virtual void SetInputImage( const TImageType * inputData );
 
+  /** Set/Get whether the coefficients are shared with other interpolators
+   * through the BSplineCoefficientImageCache. Default: false. */
+  itkSetMacro( UseCoefficientCache, bool );
+  itkGetConstMacro( UseCoefficientCache, bool );
+  itkBooleanMacro( UseCoefficientCache );
+
   /** The UseImageDirection flag determines whether image derivatives are
    * computed with respect to the image grid or with respect to the physical
    * space. When this flag is ON the derivatives are computed with respect to
@@ -244,6 +251,9 @@ private:
   // derivatives.
   bool m_UseImageDirection;
 
+  // flag to look up and store the coefficients in the coefficient cache.
+  bool m_UseCoefficientCache;
+
 };
 
 } // namespace itk
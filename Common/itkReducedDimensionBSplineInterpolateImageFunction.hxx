@@ -65,6 +65,7 @@ ReducedDimensionBSplineInterpolateImageFunction< TImageType, TCoordRep, TCoeffic
   m_Coefficients = CoefficientImageType::New();
   this->SetSplineOrder( SplineOrder );
   this->m_UseImageDirection = true;
+  this->m_UseCoefficientCache = false;
 }
 
 
@@ -82,6 +83,8 @@ ReducedDimensionBSplineInterpolateImageFunction< TImageType, TCoordRep, TCoeffic
   os << indent << "Spline Order: " << m_SplineOrder << std::endl;
   os << indent << "UseImageDirection = "
      << ( this->m_UseImageDirection ? "On" : "Off" ) << std::endl;
+  os << indent << "UseCoefficientCache = "
+     << ( this->m_UseCoefficientCache ? "On" : "Off" ) << std::endl;
 
 }
 
@@ -91,7 +94,39 @@ void
 ReducedDimensionBSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
 ::SetInputImage( const TImageType * inputData )
 {
-  if( inputData )
+  if( inputData && m_UseCoefficientCache )
+  {
+    typedef BSplineCoefficientImageCache< CoefficientImageType > CacheType;
+    typename CacheType::Pointer cache = CacheType::GetInstance();
+
+    // The last dimension always has order zero, see SetSplineOrder().
+    typename CacheType::SplineOrderArrayType splineOrders( ImageDimension, m_SplineOrder );
+    splineOrders[ ImageDimension - 1 ] = 0;
+
+    typename CoefficientImageType::ConstPointer coefficients
+      = cache->Find( inputData, splineOrders );
+    if( coefficients.IsNull()
+      || coefficients->GetBufferedRegion() != inputData->GetBufferedRegion() )
+    {
+      // Use a private filter with a disconnected output, so that the
+      // cached image is never overwritten by m_CoefficientFilter.
+      CoefficientFilterPointer filter = CoefficientFilter::New();
+      filter->SetSplineOrder( m_SplineOrder );
+      filter->SetSplineOrder( ImageDimension - 1, 0 );
+      filter->SetInput( inputData );
+      filter->Update();
+      typename CoefficientImageType::Pointer output = filter->GetOutput();
+      output->DisconnectPipeline();
+
+      cache->Insert( inputData, splineOrders, output );
+      coefficients = output;
+    }
+
+    m_Coefficients = coefficients;
+    Superclass::SetInputImage( inputData );
+    m_DataLength = inputData->GetBufferedRegion().GetSize();
+  }
+  else if( inputData )
   {
     m_CoefficientFilter->SetInput( inputData );
 
@@ -65,6 +65,11 @@ namespace elastix
  *    for rescaling the image, or the ResampleImageFilter. Skrinker is faster.\n
  *    example: <tt>(ImagePyramidUseShrinkImageFilter "true")</tt>\n
  *    Default false, so by default the resampler is used.
+ * \parameter ImagePyramidUseFusedSmoothingAndDownsampling: Flag to specify if smoothing and
+ *    rescaling are done in one pass, which evaluates the smoothed image only at the downsampled
+ *    positions. This is faster and does not allocate a full resolution smoothed image.\n
+ *    example: <tt>(ImagePyramidUseFusedSmoothingAndDownsampling "true")</tt>\n
+ *    Default false.
  *
  * \ingroup ImagePyramids
  */
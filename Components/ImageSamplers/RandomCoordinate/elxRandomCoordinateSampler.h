@@ -70,6 +70,11 @@ namespace elastix
  *    With this option you can specify the order of interpolation.\n
  *    example: <tt>(FixedImageBSplineInterpolationOrder 0 0 1)</tt>\n
  *    Default value: 1. The parameter can be specified for each resolution.
+ * \parameter UseSamplePrefetching: Defines whether the samples of the next iteration
+ *    are generated in a background thread, while the metric is evaluated. Only useful
+ *    in combination with the NewSamplesEveryIteration parameter.\n
+ *    example: <tt>(UseSamplePrefetching "true")</tt>\n
+ *    Default: false. The parameter can be specified for each resolution.
  *
  * \ingroup ImageSamplers
  */
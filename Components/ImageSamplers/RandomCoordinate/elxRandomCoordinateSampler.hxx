@@ -68,6 +68,12 @@ RandomCoordinateSampler< TElastix >
     "UseRandomSampleRegion", this->GetComponentLabel(), level, 0 );
   this->SetUseRandomSampleRegion( useRandomSampleRegion );
 
+  /** Set the UseSamplePrefetching bool. */
+  bool useSamplePrefetching = false;
+  this->GetConfiguration()->ReadParameter( useSamplePrefetching,
+    "UseSamplePrefetching", this->GetComponentLabel(), level, 0 );
+  this->SetUsePrefetching( useSamplePrefetching );
+
   /** Set the SampleRegionSize. */
   if( useRandomSampleRegion )
   {
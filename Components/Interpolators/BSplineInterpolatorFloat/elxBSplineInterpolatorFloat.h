@@ -19,7 +19,7 @@
 #define __elxBSplineInterpolatorFloat_h
 
 #include "elxIncludes.h" // include first to avoid MSVS warning
-#include "itkBSplineInterpolateImageFunction.h"
+#include "itkCachedBSplineInterpolateImageFunction.h"
 
 namespace elastix
 {
@@ -42,6 +42,14 @@ namespace elastix
  *    example: <tt>(BSplineInterpolationOrder 3 2 3)</tt> \n
  *    The default order is 1. The parameter can be specified for each resolution.\n
  *    If only given for one resolution, that value is used for the other resolutions as well.
+ * \parameter UseBSplineCoefficientCache: whether the B-spline coefficients of the
+ *    moving image are shared with other B-spline interpolators that use the same
+ *    image and spline order, instead of being computed again. This helps when
+ *    several metrics use the same moving image. The final resampler uses the
+ *    original moving image, not the pyramid images, so it does not share with
+ *    the metrics.
+ *    example: <tt>(UseBSplineCoefficientCache "true")</tt> \n
+ *    Default: "false". Cached coefficients are released when their image is deleted.
  *
  * \ingroup Interpolators
  */
@@ -49,7 +57,7 @@ namespace elastix
 template< class TElastix >
 class BSplineInterpolatorFloat :
   public
-  itk::BSplineInterpolateImageFunction<
+  itk::CachedBSplineInterpolateImageFunction<
   typename InterpolatorBase< TElastix >::InputImageType,
   typename InterpolatorBase< TElastix >::CoordRepType,
   float >,        //CoefficientType
@@ -60,7 +68,7 @@ public:
 
   /** Standard ITK-stuff. */
   typedef BSplineInterpolatorFloat Self;
-  typedef itk::BSplineInterpolateImageFunction<
+  typedef itk::CachedBSplineInterpolateImageFunction<
     typename InterpolatorBase< TElastix >::InputImageType,
     typename InterpolatorBase< TElastix >::CoordRepType,
     float >                                   Superclass1;
@@ -72,7 +80,7 @@ public:
   itkNewMacro( Self );
 
   /** Run-time type information (and related methods). */
-  itkTypeMacro( BSplineInterpolatorFloat, BSplineInterpolateImageFunction );
+  itkTypeMacro( BSplineInterpolatorFloat, CachedBSplineInterpolateImageFunction );
 
   /** Name of this class.
    * Use this name in the parameter file to select this specific interpolator. \n
@@ -54,6 +54,12 @@ BSplineInterpolatorFloat< TElastix >
   /** Set the splineOrder. */
   this->SetSplineOrder( splineOrder );
 
+  /** Check if the coefficients may be shared through the cache. */
+  bool useCache = false;
+  this->GetConfiguration()->ReadParameter( useCache,
+    "UseBSplineCoefficientCache", this->GetComponentLabel(), 0, 0 );
+  this->SetUseCoefficientCache( useCache );
+
 } // end BeforeEachResolution()
 
 
@@ -40,6 +40,14 @@ namespace elastix
  *    The default order is 1. The parameter can be specified for each resolution.\n
  *    If only given for one resolution, that value is used for the other resolutions as well. \n
  *    Currently only first order B-spline interpolation is supported.
+ * \parameter UseBSplineCoefficientCache: whether the B-spline coefficients of the
+ *    moving image are shared with other B-spline interpolators that use the same
+ *    image and spline order, instead of being computed again. This helps when
+ *    several metrics use the same moving image. The final resampler uses the
+ *    original moving image, not the pyramid images, so it does not share with
+ *    the metrics.
+ *    example: <tt>(UseBSplineCoefficientCache "true")</tt> \n
+ *    Default: "false". Cached coefficients are released when their image is deleted.
  *
  * \ingroup Interpolators
  */
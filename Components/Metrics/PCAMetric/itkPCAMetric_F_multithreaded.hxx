@@ -237,6 +237,16 @@ PCAMetric< TFixedImage, TMovingImage >
 
     unsigned int numSamplesOk = 0;
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( this->m_G );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < this->m_G; ++d )
+    {
+      voxelCoord[ this->m_LastDimIndex ] = d;
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    const bool transformOk = this->TransformPoints( fixedPoints, mappedPoints );
+
     /** Loop over t */
     for( unsigned int d = 0; d < this->m_G; ++d )
     {
@@ -244,14 +254,10 @@ PCAMetric< TFixedImage, TMovingImage >
       RealType             movingImageValue;
       MovingImagePointType mappedPoint;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ this->m_LastDimIndex ] = d;
-
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
-
-      /** Transform point and check if it is inside the B-spline support region. */
-      bool sampleOk = this->TransformPoint( fixedPoint, mappedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
+      bool sampleOk = transformOk;
 
       /** Check if point is inside mask. */
       if( sampleOk )
@@ -423,6 +429,16 @@ PCAMetric< TFixedImage, TMovingImage >
 
     unsigned int numSamplesOk = 0;
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( this->m_G );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < this->m_G; ++d )
+    {
+      voxelCoord[ this->m_LastDimIndex ] = d;
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    const bool transformOk = this->TransformPoints( fixedPoints, mappedPoints );
+
     /** Loop over t */
     for( unsigned int d = 0; d < this->m_G; ++d )
     {
@@ -430,14 +446,11 @@ PCAMetric< TFixedImage, TMovingImage >
       RealType             movingImageValue;
       MovingImagePointType mappedPoint;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ this->m_LastDimIndex ] = d;
-
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
+      bool sampleOk = transformOk;
 
-      /** Transform point and check if it is inside the B-spline support region. */
-      bool sampleOk = this->TransformPoint( fixedPoint, mappedPoint );
       /** Check if point is inside mask. */
       if( sampleOk )
       {
@@ -560,6 +573,16 @@ PCAMetric< TFixedImage, TMovingImage >
     FixedImageContinuousIndexType voxelCoord;
     this->GetFixedImage()->TransformPhysicalPointToContinuousIndex( fixedPoint, voxelCoord );
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( this->m_G );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < this->m_G; ++d )
+    {
+      voxelCoord[ this->m_LastDimIndex ] = d;
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    this->TransformPoints( fixedPoints, mappedPoints );
+
     for( unsigned int d = 0; d < this->m_G; ++d )
     {
       /** Initialize some variables. */
@@ -567,12 +590,9 @@ PCAMetric< TFixedImage, TMovingImage >
       MovingImagePointType      mappedPoint;
       MovingImageDerivativeType movingImageDerivative;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ this->m_LastDimIndex ] = d;
-
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
-      this->TransformPoint( fixedPoint, mappedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
 
       this->EvaluateMovingImageValueAndDerivative(
         mappedPoint, movingImageValue, &movingImageDerivative );
@@ -773,6 +793,16 @@ PCAMetric< TFixedImage, TMovingImage >
 
     unsigned int numSamplesOk = 0;
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( this->m_G );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < this->m_G; ++d )
+    {
+      voxelCoord[ this->m_LastDimIndex ] = d;
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    const bool transformOk = this->TransformPoints( fixedPoints, mappedPoints );
+
     /** Loop over t */
     for( unsigned int d = 0; d < this->m_G; ++d )
     {
@@ -780,14 +810,11 @@ PCAMetric< TFixedImage, TMovingImage >
       RealType             movingImageValue;
       MovingImagePointType mappedPoint;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ this->m_LastDimIndex ] = d;
-
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
+      bool sampleOk = transformOk;
 
-      /** Transform point and check if it is inside the B-spline support region. */
-      bool sampleOk = this->TransformPoint( fixedPoint, mappedPoint );
       /** Check if point is inside mask. */
       if( sampleOk )
       {
@@ -1004,14 +1031,21 @@ PCAMetric< TFixedImage, TMovingImage >
     FixedImageContinuousIndexType voxelCoord;
     this->GetFixedImage()->TransformPhysicalPointToContinuousIndex( fixedPoint, voxelCoord );
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( this->m_G );
+    std::vector< MovingImagePointType > mappedPoints;
     for( unsigned int d = 0; d < this->m_G; ++d )
     {
-      /** Set fixed point's last dimension to lastDimPosition. */
       voxelCoord[ this->m_LastDimIndex ] = d;
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    this->TransformPoints( fixedPoints, mappedPoints );
 
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
-      this->TransformPoint( fixedPoint, mappedPoint );
+    for( unsigned int d = 0; d < this->m_G; ++d )
+    {
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
 
       this->EvaluateMovingImageValueAndDerivative(
         mappedPoint, movingImageValue, &movingImageDerivative );
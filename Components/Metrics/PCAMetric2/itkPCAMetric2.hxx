@@ -222,6 +222,16 @@ PCAMetric2< TFixedImage, TMovingImage >
 
     unsigned int numSamplesOk = 0;
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( G );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < G; ++d )
+    {
+      voxelCoord[ lastDim ] = lastDimPositions[ d ];
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    const bool transformOk = this->TransformPoints( fixedPoints, mappedPoints );
+
     /** Loop over t */
     for( unsigned int d = 0; d < G; ++d )
     {
@@ -229,14 +239,10 @@ PCAMetric2< TFixedImage, TMovingImage >
       RealType             movingImageValue;
       MovingImagePointType mappedPoint;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ lastDim ] = lastDimPositions[ d ];
-
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
-
-      /** Transform point and check if it is inside the B-spline support region. */
-      bool sampleOk = this->TransformPoint( fixedPoint, mappedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
+      bool sampleOk = transformOk;
 
       /** Check if point is inside mask. */
       if( sampleOk )
@@ -433,6 +439,16 @@ PCAMetric2< TFixedImage, TMovingImage >
 
     unsigned int numSamplesOk = 0;
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( G );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < G; ++d )
+    {
+      voxelCoord[ lastDim ] = lastDimPositions[ d ];
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    const bool transformOk = this->TransformPoints( fixedPoints, mappedPoints );
+
     /** Loop over t */
     for( unsigned int d = 0; d < G; ++d )
     {
@@ -440,14 +456,10 @@ PCAMetric2< TFixedImage, TMovingImage >
       RealType             movingImageValue;
       MovingImagePointType mappedPoint;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ lastDim ] = lastDimPositions[ d ];
-
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
-
-      /** Transform point and check if it is inside the B-spline support region. */
-      bool sampleOk = this->TransformPoint( fixedPoint, mappedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
+      bool sampleOk = transformOk;
 
       /** Check if point is inside mask. */
       if( sampleOk )
@@ -575,6 +587,16 @@ PCAMetric2< TFixedImage, TMovingImage >
 
     const unsigned int G = lastDimPositions.size();
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( G );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < G; ++d )
+    {
+      voxelCoord[ lastDim ] = lastDimPositions[ d ];
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    this->TransformPoints( fixedPoints, mappedPoints );
+
     for( unsigned int d = 0; d < G; ++d )
     {
       /** Initialize some variables. */
@@ -582,12 +604,9 @@ PCAMetric2< TFixedImage, TMovingImage >
       MovingImagePointType      mappedPoint;
       MovingImageDerivativeType movingImageDerivative;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ lastDim ] = lastDimPositions[ d ];
-
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
-      this->TransformPoint( fixedPoint, mappedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
 
       this->EvaluateMovingImageValueAndDerivative(
         mappedPoint, movingImageValue, &movingImageDerivative );
@@ -192,6 +192,16 @@ SumOfPairwiseCorrelationCoefficientsMetric< TFixedImage, TMovingImage >
 
     unsigned int numSamplesOk = 0;
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( G );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < G; ++d )
+    {
+      voxelCoord[ lastDim ] = d;
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    const bool transformOk = this->TransformPoints( fixedPoints, mappedPoints );
+
     /** Loop over t */
     for( unsigned int d = 0; d < G; ++d )
     {
@@ -199,14 +209,10 @@ SumOfPairwiseCorrelationCoefficientsMetric< TFixedImage, TMovingImage >
       RealType             movingImageValue;
       MovingImagePointType mappedPoint;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ lastDim ] = d;
-
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
-
-      /** Transform point and check if it is inside the B-spline support region. */
-      bool sampleOk = this->TransformPoint( fixedPoint, mappedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
+      bool sampleOk = transformOk;
 
       /** Check if point is inside mask. */
       if( sampleOk )
@@ -374,6 +380,16 @@ SumOfPairwiseCorrelationCoefficientsMetric< TFixedImage, TMovingImage >
 
     unsigned int numSamplesOk = 0;
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( G );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < G; ++d )
+    {
+      voxelCoord[ lastDim ] = d;
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    const bool transformOk = this->TransformPoints( fixedPoints, mappedPoints );
+
     /** Loop over t */
     for( unsigned int d = 0; d < G; ++d )
     {
@@ -381,14 +397,10 @@ SumOfPairwiseCorrelationCoefficientsMetric< TFixedImage, TMovingImage >
       RealType             movingImageValue;
       MovingImagePointType mappedPoint;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ lastDim ] = d;
-
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
-
-      /** Transform point and check if it is inside the B-spline support region. */
-      bool sampleOk = this->TransformPoint( fixedPoint, mappedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
+      bool sampleOk = transformOk;
 
       /** Check if point is inside mask. */
       if( sampleOk )
@@ -496,6 +508,16 @@ SumOfPairwiseCorrelationCoefficientsMetric< TFixedImage, TMovingImage >
     FixedImageContinuousIndexType voxelCoord;
     this->GetFixedImage()->TransformPhysicalPointToContinuousIndex( fixedPoint, voxelCoord );
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( G );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < G; ++d )
+    {
+      voxelCoord[ lastDim ] = d;
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    this->TransformPoints( fixedPoints, mappedPoints );
+
     for( unsigned int d = 0; d < G; ++d )
     {
       /** Initialize some variables. */
@@ -503,12 +525,9 @@ SumOfPairwiseCorrelationCoefficientsMetric< TFixedImage, TMovingImage >
       MovingImagePointType      mappedPoint;
       MovingImageDerivativeType movingImageDerivative;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ lastDim ] = d;
-
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
-      this->TransformPoint( fixedPoint, mappedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
 
       this->EvaluateMovingImageValueAndDerivative(
         mappedPoint, movingImageValue, &movingImageDerivative );
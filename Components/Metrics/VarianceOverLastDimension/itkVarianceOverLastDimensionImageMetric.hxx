@@ -268,20 +268,26 @@ VarianceOverLastDimensionImageMetric< TFixedImage, TMovingImage >
     float              sumValuesSquared        = 0.0;
     unsigned int       numSamplesOk            = 0;
     const unsigned int realNumLastDimPositions = lastDimPositions.size();
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( realNumLastDimPositions );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < realNumLastDimPositions; ++d )
+    {
+      voxelCoord[ lastDim ] = lastDimPositions[ d ];
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    const bool transformOk = this->TransformPoints( fixedPoints, mappedPoints );
+
     for( unsigned int d = 0; d < realNumLastDimPositions; ++d )
     {
       /** Initialize some variables. */
       RealType             movingImageValue;
       MovingImagePointType mappedPoint;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ lastDim ] = lastDimPositions[ d ];
-
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
-
-      /** Transform point and check if it is inside the B-spline support region. */
-      bool sampleOk = this->TransformPoint( fixedPoint, mappedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
+      bool sampleOk = transformOk;
 
       /** Check if point is inside mask. */
       if( sampleOk )
@@ -456,6 +462,16 @@ VarianceOverLastDimensionImageMetric< TFixedImage, TMovingImage >
     float        sumValuesSquared = 0.0;
     unsigned int numSamplesOk     = 0;
 
+    /** Map the sample to all positions along the last dimension at once. */
+    std::vector< FixedImagePointType >  fixedPoints( realNumLastDimPositions );
+    std::vector< MovingImagePointType > mappedPoints;
+    for( unsigned int d = 0; d < realNumLastDimPositions; ++d )
+    {
+      voxelCoord[ lastDim ] = lastDimPositions[ d ];
+      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoints[ d ] );
+    }
+    const bool transformOk = this->TransformPoints( fixedPoints, mappedPoints );
+
     /** First loop over t: compute M(T(x,t)), dM(T(x,t))/dmu, nzji and store. */
     for( unsigned int d = 0; d < realNumLastDimPositions; ++d )
     {
@@ -464,12 +480,10 @@ VarianceOverLastDimensionImageMetric< TFixedImage, TMovingImage >
       MovingImagePointType      mappedPoint;
       MovingImageDerivativeType movingImageDerivative;
 
-      /** Set fixed point's last dimension to lastDimPosition. */
-      voxelCoord[ lastDim ] = lastDimPositions[ d ];
-      /** Transform sampled point back to world coordinates. */
-      this->GetFixedImage()->TransformContinuousIndexToPhysicalPoint( voxelCoord, fixedPoint );
-      /** Transform point and check if it is inside the B-spline support region. */
-      bool sampleOk = this->TransformPoint( fixedPoint, mappedPoint );
+      /** Get the fixed point at this position and its mapping. */
+      fixedPoint  = fixedPoints[ d ];
+      mappedPoint = mappedPoints[ d ];
+      bool sampleOk = transformOk;
 
       /** Check if point is inside mask. */
       if( sampleOk )
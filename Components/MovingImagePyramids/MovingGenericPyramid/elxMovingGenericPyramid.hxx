@@ -144,6 +144,12 @@ MovingGenericPyramid< TElastix >
     "ImagePyramidUseShrinkImageFilter", 0, false );
   this->SetUseShrinkImageFilter( useShrinkImageFilter );
 
+  /** Use a single pass for smoothing and rescaling within the pyramid. */
+  bool useFusedSmoothingAndDownsampling = false;
+  this->m_Configuration->ReadParameter( useFusedSmoothingAndDownsampling,
+    "ImagePyramidUseFusedSmoothingAndDownsampling", 0, false );
+  this->SetUseFusedSmoothingAndDownsampling( useFusedSmoothingAndDownsampling );
+
   /** Decide whether or not to compute the pyramid images only for the current
    * resolution. Setting the option to true saves memory, since only one level
    * of the pyramid gets allocated per resolution.
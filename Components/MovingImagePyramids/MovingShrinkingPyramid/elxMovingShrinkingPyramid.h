@@ -31,6 +31,10 @@ namespace elastix
  * The parameters used in this class are:
  * \parameter FixedImagePyramid: Select this pyramid as follows:\n
  *    <tt>(MovingImagePyramid "MovingShrinkingImagePyramid")</tt>
+ * \parameter ComputePyramidImagesPerResolution: Flag to specify if all resolution levels are computed
+ *    at once, or per resolution. Latter saves memory.\n
+ *    example: <tt>(ComputePyramidImagesPerResolution "true")</tt>\n
+ *    Default false.
  *
  * \ingroup ImagePyramids
  */
@@ -87,6 +91,14 @@ public:
   typedef typename Superclass2::RegistrationPointer  RegistrationPointer;
   typedef typename Superclass2::ITKBaseType          ITKBaseType;
 
+  /** Method for setting the schedule. Override from MovingImagePyramidBase,
+   * to read whether the levels are computed per resolution.
+   */
+  virtual void SetMovingSchedule( void );
+
+  /** Update the current resolution level. */
+  virtual void BeforeEachResolution( void );
+
 protected:
 
   /** The constructor. */
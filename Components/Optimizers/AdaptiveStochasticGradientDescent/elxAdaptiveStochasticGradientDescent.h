@@ -182,6 +182,27 @@ namespace elastix
  *   The parameter can be specified for each resolution, or for all resolutions at once.\n
  *   example: <tt>(NoiseCompensation "true")</tt>\n
  *   Default/recommended: true.
+ * \parameter ConvergenceWindowSize: The number of iterations W over which the optimizer
+ *   tests for convergence. If the magnitude of the summed gradients of a window is below
+ *   ConvergenceTolerance times its value expected for purely random gradients, the
+ *   optimization stops before MaximumNumberOfIterations is reached.
+ *   The parameter can be specified for each resolution, or for all resolutions at once.\n
+ *   example: <tt>(ConvergenceWindowSize 100)</tt>\n
+ *   Default: 0, which disables the test.
+ * \parameter ConvergenceTolerance: The tolerance of the convergence test, see ConvergenceWindowSize.
+ *   The parameter can be specified for each resolution, or for all resolutions at once.\n
+ *   example: <tt>(ConvergenceTolerance 1.5)</tt>\n
+ *   Default: 1.5.
+ * \parameter UseJacobianPreconditioner: Selects whether or not to precondition the
+ *   gradient with the diagonal of the Jacobian covariance matrix C = 1/M \sum_i J_i^T J_i,
+ *   estimated once per resolution from NumberOfJacobianMeasurements samples. Parameters
+ *   that are poorly covered by samples, such as B-spline coefficients in regions of low
+ *   sample density, then take relatively larger steps. The preconditioner replaces
+ *   the Scales. It is best combined with AutomaticParameterEstimation, which adapts the
+ *   gain to it.
+ *   The parameter can be specified for each resolution, or for all resolutions at once.\n
+ *   example: <tt>(UseJacobianPreconditioner "true")</tt>\n
+ *   Default: false.
  *
  * \todo: this class contains a lot of functional code, which actually does not belong here.
  *
@@ -402,6 +423,12 @@ protected:
    */
   virtual void AddRandomPerturbation( ParametersType & parameters, double sigma );
 
+  /** Estimate the diagonal preconditioner at the current position and
+   * set it as the scales of the optimizer. Used by StartOptimization if
+   * UseJacobianPreconditioner is true.
+   */
+  virtual void ComputeJacobianPreconditioner( void );
+
 private:
 
   AdaptiveStochasticGradientDescent( const Self & );  // purposely not implemented
@@ -425,6 +452,9 @@ private:
   bool m_UseNoiseCompensation;
   bool m_OriginalButSigmoidToDefault;
 
+  /** The flag of using the diagonal Jacobian preconditioner. */
+  bool m_UseJacobianPreconditioner;
+
 };
 
 } // end namespace elastix
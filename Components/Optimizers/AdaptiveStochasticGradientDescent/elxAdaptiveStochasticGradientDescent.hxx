@@ -59,6 +59,7 @@ AdaptiveStochasticGradientDescent< TElastix >
 
   this->m_UseNoiseCompensation        = true;
   this->m_OriginalButSigmoidToDefault = false;
+  this->m_UseJacobianPreconditioner   = false;
 
 } // Constructor
 
@@ -160,6 +161,21 @@ AdaptiveStochasticGradientDescent< TElastix >
     "UseAdaptiveStepSizes", this->GetComponentLabel(), level, 0 );
   this->SetUseAdaptiveStepSizes( useAdaptiveStepSizes );
 
+  /** Set the convergence test; a window size of 0 (default) disables it. */
+  unsigned long convergenceWindowSize = 0;
+  double        convergenceTolerance  = 1.5;
+  this->GetConfiguration()->ReadParameter( convergenceWindowSize,
+    "ConvergenceWindowSize", this->GetComponentLabel(), level, 0 );
+  this->GetConfiguration()->ReadParameter( convergenceTolerance,
+    "ConvergenceTolerance", this->GetComponentLabel(), level, 0 );
+  this->SetConvergenceWindowSize( convergenceWindowSize );
+  this->SetConvergenceTolerance( convergenceTolerance );
+
+  /** Set whether the diagonal Jacobian preconditioner is used; default: false. */
+  this->m_UseJacobianPreconditioner = false;
+  this->GetConfiguration()->ReadParameter( this->m_UseJacobianPreconditioner,
+    "UseJacobianPreconditioner", this->GetComponentLabel(), level, 0 );
+
   /** Set whether automatic gain estimation is required; default: true. */
   this->m_AutomaticParameterEstimation = true;
   this->GetConfiguration()->ReadParameter( this->m_AutomaticParameterEstimation,
@@ -324,7 +340,8 @@ AdaptiveStochasticGradientDescent< TElastix >
    * typedef enum {
    *   MaximumNumberOfIterations,
    *   MetricError,
-   *   MinimumStepSize } StopConditionType;
+   *   MinimumStepSize,
+   *   ConvergenceDetected } StopConditionType;
    */
   std::string stopcondition;
 
@@ -342,6 +359,10 @@ AdaptiveStochasticGradientDescent< TElastix >
       stopcondition = "The minimum step length has been reached";
       break;
 
+    case ConvergenceDetected:
+      stopcondition = "Convergence of the stochastic gradient has been detected";
+      break;
+
     default:
       stopcondition = "Unknown";
       break;
@@ -420,8 +441,20 @@ AdaptiveStochasticGradientDescent< TElastix >
 
   this->m_AutomaticParameterEstimationDone = false;
 
+  /** Replace the scales by the preconditioner during this resolution. */
+  const ScalesType userScales = this->GetScales();
+  if( this->m_UseJacobianPreconditioner )
+  {
+    this->ComputeJacobianPreconditioner();
+  }
+
   this->Superclass1::StartOptimization();
 
+  if( this->m_UseJacobianPreconditioner )
+  {
+    this->SetScales( userScales );
+  }
+
 } // end StartOptimization()
 
 
@@ -1097,6 +1130,68 @@ AdaptiveStochasticGradientDescent< TElastix >
 } // end CheckForAdvancedTransform()
 
 
+/**
+ * ******************** ComputeJacobianPreconditioner ********************
+ */
+
+template< class TElastix >
+void
+AdaptiveStochasticGradientDescent< TElastix >
+::ComputeJacobianPreconditioner( void )
+{
+  itk::TimeProbe timer;
+  timer.Start();
+  elxout << "Computing the Jacobian preconditioner ..." << std::endl;
+
+  /** Get the initial position to estimate the preconditioner. */
+  this->GetRegistration()->GetAsITKBaseType()->GetTransform()->SetParameters(
+    this->GetInitialPosition() );
+
+  /** Cast to advanced metric type. */
+  typedef typename ElastixType::MetricBaseType::AdvancedMetricType MetricType;
+  MetricType * testPtr = dynamic_cast< MetricType * >(
+    this->GetElastix()->GetElxMetricBase()->GetAsITKBaseType() );
+  if( !testPtr )
+  {
+    itkExceptionMacro( << "ERROR: AdaptiveStochasticGradientDescent expects "
+                       << "the metric to be of type AdvancedImageToImageMetric!" );
+  }
+
+  /** The number of Jacobian measurements is only read in case of
+   * automatic parameter estimation; otherwise use its default.
+   */
+  SizeValueType numberOfJacobianMeasurements = this->m_NumberOfJacobianMeasurements;
+  if( numberOfJacobianMeasurements == 0 )
+  {
+    numberOfJacobianMeasurements = vnl_math_max(
+      static_cast< SizeValueType >( 1000 ),
+      static_cast< SizeValueType >( this->GetInitialPosition().GetSize() ) );
+  }
+
+  typename ComputeJacobianTermsType::Pointer computeJacobianTerms = ComputeJacobianTermsType::New();
+  computeJacobianTerms->SetFixedImage( testPtr->GetFixedImage() );
+  computeJacobianTerms->SetFixedImageRegion( testPtr->GetFixedImageRegion() );
+  computeJacobianTerms->SetFixedImageMask( testPtr->GetFixedImageMask() );
+  computeJacobianTerms->SetTransform(
+    this->GetRegistration()->GetAsITKBaseType()->GetTransform() );
+  computeJacobianTerms->SetNumberOfJacobianMeasurements( numberOfJacobianMeasurements );
+
+  ScalesType preconditioner;
+  computeJacobianTerms->ComputeDiagonalPreconditioner( preconditioner );
+
+  /** SetScales expects squared scales, so the step of parameter i is
+   * divided by preconditioner[ i ].
+   */
+  this->SetScales( preconditioner );
+  this->SetUseScales( true );
+
+  timer.Stop();
+  elxout << "Computing the Jacobian preconditioner took "
+         << this->ConvertSecondsToDHMS( timer.GetMean(), 6 ) << std::endl;
+
+} // end ComputeJacobianPreconditioner()
+
+
 /**
  * *************** GetScaledDerivativeWithExceptionHandling ***************
  */
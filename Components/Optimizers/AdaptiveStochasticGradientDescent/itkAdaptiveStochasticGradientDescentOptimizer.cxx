@@ -17,6 +17,7 @@
  *=========================================================================*/
 
 #include "itkAdaptiveStochasticGradientDescentOptimizer.h"
+#include "itkOptimizerVectorKernels.h"
 
 #include "vnl/vnl_math.h"
 #include "itkSigmoidImageFilter.h"
@@ -65,7 +66,7 @@ AdaptiveStochasticGradientDescentOptimizer
       sigmoid.SetBeta( beta );
 
       /** Formula (2) in Cruz */
-      const double inprod = inner_product(
+      const double inprod = OptimizerVectorKernels::InnerProduct(
         this->m_PreviousGradient, this->GetGradient() );
       this->m_CurrentTime += sigmoid( -inprod );
       this->m_CurrentTime  = vnl_math_max( 0.0, this->m_CurrentTime );
@@ -20,6 +20,7 @@
 #define __itkCMAEvolutionStrategyOptimizer_cxx
 
 #include "itkCMAEvolutionStrategyOptimizer.h"
+#include "itkOptimizerVectorKernels.h"
 #include "itkSymmetricEigenAnalysis.h"
 #include "vnl/vnl_math.h"
 #include <algorithm>
@@ -512,8 +513,9 @@ CMAEvolutionStrategyOptimizer::GenerateOffspring( void )
   this->m_CostFunctionValues.clear();
 
   /** Fill the m_NormalizedSearchDirs and SearchDirs */
-  unsigned int lam       = 0;
-  unsigned int nrOfFails = 0;
+  unsigned int   lam       = 0;
+  unsigned int   nrOfFails = 0;
+  ParametersType x_lam( N );
   while( lam < lambda )
   {
     /** draw from distribution N(0,I) */
@@ -537,8 +539,8 @@ CMAEvolutionStrategyOptimizer::GenerateOffspring( void )
     /** Compute the cost function */
     MeasureType costFunctionValue = 0.0;
     /** x_lam = m + d_lam */
-    ParametersType x_lam = this->GetScaledCurrentPosition();
-    x_lam += this->m_SearchDirs[ lam ];
+    OptimizerVectorKernels::ScaledUpdate( this->GetScaledCurrentPosition(),
+      1.0, this->m_SearchDirs[ lam ], x_lam );
     try
     {
       costFunctionValue = this->GetScaledValue( x_lam );
@@ -20,6 +20,7 @@
 #define __itkGenericConjugateGradientOptimizer_cxx
 
 #include "itkGenericConjugateGradientOptimizer.h"
+#include "itkOptimizerVectorKernels.h"
 #include "vnl/vnl_math.h"
 
 namespace itk
@@ -264,8 +265,6 @@ GenericConjugateGradientOptimizer::ComputeSearchDirection(
 {
   itkDebugMacro( "ComputeSearchDirection" );
 
-  const unsigned int numberOfParameters = gradient.GetSize();
-
   /** When no previous gradient and/or previous search direction are
    * available, return the negative gradient as search direction */
   if( !this->m_PreviousGradientAndSearchDirValid )
@@ -284,10 +283,7 @@ GenericConjugateGradientOptimizer::ComputeSearchDirection(
   }
 
   /** Compute the new search direction */
-  for( unsigned int i = 0; i < numberOfParameters; ++i )
-  {
-    searchDir[ i ] = -gradient[ i ] + beta * searchDir[ i ];
-  }
+  OptimizerVectorKernels::Axpby( -1.0, gradient, beta, searchDir );
 
 } // end ComputeSearchDirection
 
@@ -405,17 +401,8 @@ GenericConjugateGradientOptimizer::ComputeBetaFR(
   const DerivativeType & gradient,
   const ParametersType & itkNotUsed( previousSearchDir ) )
 {
-  const unsigned int numberOfParameters = gradient.GetSize();
-  double             num                = 0.0;
-  double             den                = 0.0;
-
-  for( unsigned int i = 0; i < numberOfParameters; ++i )
-  {
-    const double & grad     = gradient[ i ];
-    const double & prevgrad = previousGradient[ i ];
-    num += grad * grad;
-    den += prevgrad * prevgrad;
-  }
+  const double num = OptimizerVectorKernels::SquaredMagnitude( gradient );
+  const double den = OptimizerVectorKernels::SquaredMagnitude( previousGradient );
 
   if( den <= NumericTraits< double >::epsilon() )
   {
@@ -612,8 +599,8 @@ GenericConjugateGradientOptimizer::TestConvergence( bool itkNotUsed( firstLineSe
   }
 
   /** Check for convergence of gradient magnitude */
-  const double gnorm = this->GetCurrentGradient().magnitude();
-  const double xnorm = this->GetScaledCurrentPosition().magnitude();
+  const double gnorm = OptimizerVectorKernels::Magnitude( this->GetCurrentGradient() );
+  const double xnorm = OptimizerVectorKernels::Magnitude( this->GetScaledCurrentPosition() );
   if( gnorm / vnl_math_max( 1.0, xnorm ) <= this->GetGradientMagnitudeTolerance() )
   {
     this->m_StopCondition = GradientMagnitudeTolerance;
@@ -379,6 +379,42 @@ ConjugateGradientFRPR< TElastix >
 }     // end LineOptimize
 
 
+/**
+ * ******************* StartOptimization ************************
+ */
+
+template< class TElastix >
+void
+ConjugateGradientFRPR< TElastix >
+::StartOptimization( void )
+{
+  const unsigned int numberOfStartingPoints = this->GetNumberOfStartingPoints();
+  if( numberOfStartingPoints < 2 )
+  {
+    this->Superclass1::StartOptimization();
+    return;
+  }
+
+  this->SetCurrentPosition( this->StartMultiStartOptimization() );
+
+} // end StartOptimization()
+
+
+/**
+ * ******************* StartSingleOptimization ************************
+ */
+
+template< class TElastix >
+double
+ConjugateGradientFRPR< TElastix >
+::StartSingleOptimization( void )
+{
+  this->Superclass1::StartOptimization();
+  return this->GetValue();
+
+} // end StartSingleOptimization()
+
+
 } // end namespace elastix
 
 #endif // end #ifndef __elxConjugateGradientFRPR_hxx
@@ -20,6 +20,7 @@
 #define __itkFiniteDifferenceGradientDescentOptimizer_cxx
 
 #include "itkFiniteDifferenceGradientDescentOptimizer.h"
+#include "itkOptimizerVectorKernels.h"
 #include "itkCommand.h"
 #include "itkEventObject.h"
 #include "itkExceptionObject.h"
@@ -138,7 +139,7 @@ FiniteDifferenceGradientDescentOptimizer
 
     /** Initialisation.*/
     ck               = this->Compute_c( m_CurrentIteration );
-    this->m_Gradient = DerivativeType( spaceDimension );
+    this->m_Gradient.SetSize( spaceDimension );
     param            = this->GetScaledCurrentPosition();
 
     /** Compute the current value, if desired by interested users */
@@ -245,24 +246,16 @@ FiniteDifferenceGradientDescentOptimizer
 {
   itkDebugMacro( "AdvanceOneStep" );
 
-  const unsigned int spaceDimension
-    = this->GetScaledCostFunction()->GetNumberOfParameters();
-
   /** Compute the gain */
   double ak = this->Compute_a( this->m_CurrentIteration );
 
   /** Save it for users that are interested */
   this->m_LearningRate = ak;
 
-  const ParametersType & currentPosition = this->GetScaledCurrentPosition();
-
-  ParametersType newPosition( spaceDimension );
-  for( unsigned int j = 0; j < spaceDimension; j++ )
-  {
-    newPosition[ j ] = currentPosition[ j ] - ak * this->m_Gradient[ j ];
-  }
-
-  this->SetScaledCurrentPosition( newPosition );
+  /** Update the scaled current position in place. */
+  ParametersType & newPosition = this->m_ScaledCurrentPosition;
+  OptimizerVectorKernels::ScaledUpdate( newPosition, -ak, this->m_Gradient, newPosition );
+  this->Modified();
 
   this->InvokeEvent( IterationEvent() );
 
@@ -48,6 +48,15 @@ namespace elastix
  *   This varies the second transform parameter in the range [-4.0 3.0] with steps of 1.0
  *   and the third parameter in the range [-1.0 1.0] with steps of 0.5. The names are used
  *   as column headers in the screen output.
+ * \parameter FullSearchCoarseGridSpacing: Enables a coarse-to-fine search for each resolution.
+ *   Only every n-th node in each search space dimension is evaluated first, after which the
+ *   full grid is scanned around the best coarse nodes. A value of 1 scans the full grid.\n
+ *   example: <tt>(FullSearchCoarseGridSpacing 4 2)</tt> \n
+ *   Default: 1.
+ * \parameter FullSearchNumberOfRefinementCandidates: The number of best coarse nodes around
+ *   which the full grid is scanned in a coarse-to-fine search, for each resolution.\n
+ *   example: <tt>(FullSearchNumberOfRefinementCandidates 3 1)</tt> \n
+ *   Default: 1.
  *
  * \ingroup Optimizers
  * \sa FullSearchOptimizer
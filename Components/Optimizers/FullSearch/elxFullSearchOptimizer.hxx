@@ -180,6 +180,23 @@ FullSearch< TElastix >
     this->m_OptimizationSurface->Allocate();
     /** \todo try/catch block around Allocate? */
 
+    /** Read the coarse-to-fine search settings. */
+    unsigned int coarseGridSpacing = 1;
+    this->GetConfiguration()->ReadParameter( coarseGridSpacing,
+      "FullSearchCoarseGridSpacing", this->GetComponentLabel(), level, 0 );
+    this->SetCoarseGridSpacing( coarseGridSpacing );
+
+    unsigned int numberOfRefinementCandidates = 1;
+    this->GetConfiguration()->ReadParameter( numberOfRefinementCandidates,
+      "FullSearchNumberOfRefinementCandidates", this->GetComponentLabel(), level, 0 );
+    this->SetNumberOfRefinementCandidates( numberOfRefinementCandidates );
+
+    /** A coarse-to-fine search does not visit all nodes. */
+    if( this->GetCoarseGridSpacing() > 1 )
+    {
+      this->m_OptimizationSurface->FillBuffer( 0.0f );
+    }
+
     /** Set the name of this image on disk. */
     std::string resultImageFormat = "mhd";
     this->m_Configuration->ReadParameter(
@@ -193,10 +210,23 @@ FullSearch< TElastix >
       << "." << resultImageFormat;
     this->m_OptimizationSurface->SetOutputFileName( makeString.str().c_str() );
 
-    elxout
-      << "Total number of iterations needed in this resolution: "
-      << this->GetNumberOfIterations()
-      << "." << std::endl;
+    if( this->GetCoarseGridSpacing() > 1 )
+    {
+      elxout
+        << "Coarse-to-fine search with grid spacing "
+        << this->GetCoarseGridSpacing()
+        << " and " << this->GetNumberOfRefinementCandidates()
+        << " refinement candidate(s); at most "
+        << this->GetNumberOfIterations()
+        << " iterations in this resolution." << std::endl;
+    }
+    else
+    {
+      elxout
+        << "Total number of iterations needed in this resolution: "
+        << this->GetNumberOfIterations()
+        << "." << std::endl;
+    }
 
   }
   else
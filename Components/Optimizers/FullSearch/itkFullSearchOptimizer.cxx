@@ -24,6 +24,8 @@
 #include "itkEventObject.h"
 #include "itkExceptionObject.h"
 #include "itkNumericTraits.h"
+#include <algorithm>
+#include <utility>
 
 namespace itk
 {
@@ -45,6 +47,8 @@ FullSearchOptimizer
   m_NumberOfSearchSpaceDimensions = 0;
   m_SearchSpace                   = 0;
   m_LastSearchSpaceChanges        = 0;
+  m_CoarseGridSpacing             = 1;
+  m_NumberOfRefinementCandidates  = 1;
 
 }   //end constructor
 
@@ -80,7 +84,14 @@ FullSearchOptimizer
     m_BestValue = NumericTraits< double >::max();
   }
 
-  this->ResumeOptimization();
+  if( m_CoarseGridSpacing > 1 )
+  {
+    this->CoarseToFineOptimization();
+  }
+  else
+  {
+    this->ResumeOptimization();
+  }
 
 }
 
@@ -101,34 +112,13 @@ FullSearchOptimizer
   while( !m_Stop )
   {
 
-    try
-    {
-      m_Value = m_CostFunction->GetValue( this->GetCurrentPosition() );
-    }
-    catch( ExceptionObject & err )
-    {
-      // An exception has occurred.
-      // Terminate immediately.
-      m_StopCondition = MetricError;
-      StopOptimization();
-
-      // Pass exception to caller
-      throw err;
-    }
+    this->EvaluateCurrentPosition();
 
     if( m_Stop )
     {
       break;
     }
 
-    /** Check if the value is a minimum or maximum */
-    if( ( m_Value < m_BestValue )  ^  m_Maximize )         // ^ = xor, yields true if only one of the expressions is true
-    {
-      m_BestValue              = m_Value;
-      m_BestPointInSearchSpace = m_CurrentPointInSearchSpace;
-      m_BestIndexInSearchSpace = m_CurrentIndexInSearchSpace;
-    }
-
     this->InvokeEvent( IterationEvent() );
 
     /** Prepare for next step */
@@ -149,6 +139,184 @@ FullSearchOptimizer
 }   //end function ResumeOptimization
 
 
+/**
+ * ******************** EvaluateCurrentPosition *****************
+ */
+void
+FullSearchOptimizer
+::EvaluateCurrentPosition( void )
+{
+  try
+  {
+    m_Value = m_CostFunction->GetValue( this->GetCurrentPosition() );
+  }
+  catch( ExceptionObject & err )
+  {
+    // An exception has occurred.
+    // Terminate immediately.
+    m_StopCondition = MetricError;
+    StopOptimization();
+
+    // Pass exception to caller
+    throw err;
+  }
+
+  if( m_Stop )
+  {
+    return;
+  }
+
+  /** Check if the value is a minimum or maximum */
+  if( ( m_Value < m_BestValue )  ^  m_Maximize )         // ^ = xor, yields true if only one of the expressions is true
+  {
+    m_BestValue              = m_Value;
+    m_BestPointInSearchSpace = m_CurrentPointInSearchSpace;
+    m_BestIndexInSearchSpace = m_CurrentIndexInSearchSpace;
+  }
+
+} // end EvaluateCurrentPosition()
+
+
+/**
+ * ******************* CoarseToFineOptimization *****************
+ *
+ * First evaluates every m_CoarseGridSpacing-th node in each dimension,
+ * and then scans the full resolution grid in the neighbourhoods of the
+ * m_NumberOfRefinementCandidates best coarse nodes. Nodes that have
+ * already been evaluated are skipped.
+ */
+void
+FullSearchOptimizer
+::CoarseToFineOptimization( void )
+{
+  itkDebugMacro( "CoarseToFineOptimization" );
+
+  m_Stop = false;
+
+  const unsigned int          searchSpaceDimension = this->GetNumberOfSearchSpaceDimensions();
+  const SearchSpaceSizeType & searchSpaceSize      = this->GetSearchSpaceSize();
+  const unsigned long         numberOfNodes        = this->GetNumberOfIterations();
+  const unsigned long         spacing              = m_CoarseGridSpacing;
+
+  /** Remember which nodes have been evaluated already. */
+  std::vector< bool > evaluated( numberOfNodes, false );
+
+  /** The coarse nodes and their values. The values are negated when
+   * maximizing, such that the best candidates always sort first.
+   */
+  typedef std::pair< double, unsigned long > CandidateType;
+  std::vector< CandidateType > candidates;
+
+  /** The size of the coarse grid. */
+  SearchSpaceSizeType coarseSize( searchSpaceDimension );
+  unsigned long       numberOfCoarseNodes = 1;
+  for( unsigned int ssdim = 0; ssdim < searchSpaceDimension; ssdim++ )
+  {
+    coarseSize[ ssdim ]  = ( searchSpaceSize[ ssdim ] - 1 ) / spacing + 1;
+    numberOfCoarseNodes *= coarseSize[ ssdim ];
+  }
+  candidates.reserve( numberOfCoarseNodes );
+
+  SearchSpaceIndexType index( searchSpaceDimension );
+
+  InvokeEvent( StartEvent() );
+
+  /** Coarse pass. */
+  for( unsigned long c = 0; c < numberOfCoarseNodes; ++c )
+  {
+    unsigned long rest = c;
+    for( unsigned int ssdim = 0; ssdim < searchSpaceDimension; ssdim++ )
+    {
+      index[ ssdim ] = static_cast< IndexValueType >( ( rest % coarseSize[ ssdim ] ) * spacing );
+      rest          /= coarseSize[ ssdim ];
+    }
+
+    this->SetCurrentIndexInSearchSpace( index );
+    this->EvaluateCurrentPosition();
+    if( m_Stop )
+    {
+      return;
+    }
+
+    const unsigned long offset = this->IndexToOffset( index );
+    evaluated[ offset ] = true;
+    candidates.push_back( CandidateType( m_Maximize ? -m_Value : m_Value, offset ) );
+
+    this->InvokeEvent( IterationEvent() );
+    m_CurrentIteration++;
+    if( m_Stop )
+    {
+      return;
+    }
+  }
+
+  /** Select the best coarse nodes. */
+  const unsigned long numberOfCandidates = std::min(
+    static_cast< unsigned long >( m_NumberOfRefinementCandidates ),
+    static_cast< unsigned long >( candidates.size() ) );
+  std::partial_sort( candidates.begin(),
+    candidates.begin() + numberOfCandidates, candidates.end() );
+
+  /** Fine pass: scan the neighbourhood of each selected coarse node. */
+  const IndexValueType radius = static_cast< IndexValueType >( spacing - 1 );
+  SearchSpaceIndexType center( searchSpaceDimension );
+  SearchSpaceIndexType lower( searchSpaceDimension );
+  SearchSpaceIndexType upper( searchSpaceDimension );
+  for( unsigned long k = 0; k < numberOfCandidates; ++k )
+  {
+    this->OffsetToIndex( candidates[ k ].second, center );
+    for( unsigned int ssdim = 0; ssdim < searchSpaceDimension; ssdim++ )
+    {
+      const IndexValueType last
+        = static_cast< IndexValueType >( searchSpaceSize[ ssdim ] ) - 1;
+      lower[ ssdim ] = std::max( center[ ssdim ] - radius, static_cast< IndexValueType >( 0 ) );
+      upper[ ssdim ] = std::min( center[ ssdim ] + radius, last );
+    }
+
+    /** Walk through the neighbourhood; first dimension runs fastest. */
+    index = lower;
+    bool done = false;
+    while( !done )
+    {
+      const unsigned long offset = this->IndexToOffset( index );
+      if( !evaluated[ offset ] )
+      {
+        evaluated[ offset ] = true;
+        this->SetCurrentIndexInSearchSpace( index );
+        this->EvaluateCurrentPosition();
+        if( m_Stop )
+        {
+          return;
+        }
+
+        this->InvokeEvent( IterationEvent() );
+        m_CurrentIteration++;
+        if( m_Stop )
+        {
+          return;
+        }
+      }
+
+      done = true;
+      for( unsigned int ssdim = 0; ssdim < searchSpaceDimension; ssdim++ )
+      {
+        if( index[ ssdim ] < upper[ ssdim ] )
+        {
+          index[ ssdim ]++;
+          done = false;
+          break;
+        }
+        index[ ssdim ] = lower[ ssdim ];
+      }
+    } // end while
+  } // end for candidates
+
+  m_StopCondition = FullRangeSearched;
+  StopOptimization();
+
+} // end CoarseToFineOptimization()
+
+
 /**
  * ************************** Stop optimization ******************
  */
@@ -249,6 +417,59 @@ FullSearchOptimizer
 } // end UpdateCurrentPosition
 
 
+/**
+ * ***************** SetCurrentIndexInSearchSpace ***************
+ */
+void
+FullSearchOptimizer
+::SetCurrentIndexInSearchSpace( const SearchSpaceIndexType & index )
+{
+  m_CurrentIndexInSearchSpace = index;
+  m_CurrentPointInSearchSpace = this->IndexToPoint( index );
+  this->SetCurrentPosition( this->PointToPosition( m_CurrentPointInSearchSpace ) );
+
+} // end SetCurrentIndexInSearchSpace()
+
+
+/**
+ * ************************ IndexToOffset ***********************
+ */
+unsigned long
+FullSearchOptimizer
+::IndexToOffset( const SearchSpaceIndexType & index )
+{
+  const unsigned int          searchSpaceDimension = this->GetNumberOfSearchSpaceDimensions();
+  const SearchSpaceSizeType & searchSpaceSize      = this->GetSearchSpaceSize();
+
+  unsigned long offset = 0;
+  for( int ssdim = static_cast< int >( searchSpaceDimension ) - 1; ssdim >= 0; --ssdim )
+  {
+    offset = offset * searchSpaceSize[ ssdim ] + static_cast< unsigned long >( index[ ssdim ] );
+  }
+  return offset;
+
+} // end IndexToOffset()
+
+
+/**
+ * ************************ OffsetToIndex ***********************
+ */
+void
+FullSearchOptimizer
+::OffsetToIndex( unsigned long offset, SearchSpaceIndexType & index )
+{
+  const unsigned int          searchSpaceDimension = this->GetNumberOfSearchSpaceDimensions();
+  const SearchSpaceSizeType & searchSpaceSize      = this->GetSearchSpaceSize();
+
+  for( unsigned int ssdim = 0; ssdim < searchSpaceDimension; ssdim++ )
+  {
+    index[ ssdim ] = static_cast< IndexValueType >( offset % searchSpaceSize[ ssdim ] );
+    offset        /= searchSpaceSize[ ssdim ];
+  }
+
+} // end OffsetToIndex()
+
+
 /**
  * ********************* ProcessSearchSpaceChanges **************
  */
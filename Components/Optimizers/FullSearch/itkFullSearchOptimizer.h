@@ -24,6 +24,8 @@
 #include "itkImage.h"
 #include "itkArray.h"
 #include "itkFixedArray.h"
+#include "itkNumericTraits.h"
+#include <vector>
 
 namespace itk
 {
@@ -35,6 +37,15 @@ namespace itk
  * Optimizer that scans a subspace of the parameter space
  * and searches for the best parameters.
  *
+ * Optionally, the search is performed coarse-to-fine. When the
+ * CoarseGridSpacing is larger than 1, only every CoarseGridSpacing-th node
+ * in each search space dimension is evaluated first. Subsequently, the full
+ * resolution grid is scanned only in the neighbourhoods (of radius
+ * CoarseGridSpacing-1) of the NumberOfRefinementCandidates best coarse nodes.
+ * This reduces the number of cost function evaluations considerably for
+ * smooth cost functions, at the risk of missing a narrow optimum.
+ * The default (CoarseGridSpacing = 1) performs an exhaustive search.
+ *
  * \todo This optimizer has similar functionality as the recently added
  * itkExhaustiveOptimizer. See if we can replace it by that optimizer,
  * or inherit from it.
@@ -171,6 +182,21 @@ public:
   /** Convert an index to a point */
   virtual SearchSpacePointType IndexToPoint( const SearchSpaceIndexType & index );
 
+  /** Set/Get the spacing, in search space nodes, of the grid that is
+   * evaluated first in a coarse-to-fine search. A value of 1 (default)
+   * disables the coarse-to-fine search and scans the full grid.
+   */
+  itkSetClampMacro( CoarseGridSpacing, unsigned int,
+    1, NumericTraits< unsigned int >::max() );
+  itkGetConstMacro( CoarseGridSpacing, unsigned int );
+
+  /** Set/Get the number of best coarse grid nodes around which the full
+   * resolution grid is scanned in a coarse-to-fine search. Default: 1.
+   */
+  itkSetClampMacro( NumberOfRefinementCandidates, unsigned int,
+    1, NumericTraits< unsigned int >::max() );
+  itkGetConstMacro( NumberOfRefinementCandidates, unsigned int );
+
   /** Get the current iteration number. */
   itkGetConstMacro( CurrentIteration, unsigned long );
 
@@ -215,6 +241,31 @@ protected:
   unsigned long m_LastSearchSpaceChanges;
   virtual void ProcessSearchSpaceChanges( void );
 
+  unsigned int m_CoarseGridSpacing;
+  unsigned int m_NumberOfRefinementCandidates;
+
+  /** Evaluate the cost function at the current position and update
+   * the best value, point and index.
+   */
+  virtual void EvaluateCurrentPosition( void );
+
+  /** Set the CurrentPosition, CurrentPoint and CurrentIndex to the
+   * given index in the search space.
+   */
+  virtual void SetCurrentIndexInSearchSpace( const SearchSpaceIndexType & index );
+
+  /** Perform the coarse-to-fine search. Called by StartOptimization
+   * when the CoarseGridSpacing is larger than 1.
+   */
+  virtual void CoarseToFineOptimization( void );
+
+  /** Conversion between search space indices and offsets, where the first
+   * dimension runs fastest, like in UpdateCurrentPosition.
+   */
+  unsigned long IndexToOffset( const SearchSpaceIndexType & index );
+
+  void OffsetToIndex( unsigned long offset, SearchSpaceIndexType & index );
+
 private:
 
   FullSearchOptimizer( const Self & ); // purposely not implemented
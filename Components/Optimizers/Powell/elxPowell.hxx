@@ -173,6 +173,42 @@ Powell< TElastix >
 } // end SetInitialPosition
 
 
+/**
+ * ******************* StartOptimization ************************
+ */
+
+template< class TElastix >
+void
+Powell< TElastix >
+::StartOptimization( void )
+{
+  const unsigned int numberOfStartingPoints = this->GetNumberOfStartingPoints();
+  if( numberOfStartingPoints < 2 )
+  {
+    this->Superclass1::StartOptimization();
+    return;
+  }
+
+  this->SetCurrentPosition( this->StartMultiStartOptimization() );
+
+} // end StartOptimization()
+
+
+/**
+ * ******************* StartSingleOptimization ************************
+ */
+
+template< class TElastix >
+double
+Powell< TElastix >
+::StartSingleOptimization( void )
+{
+  this->Superclass1::StartOptimization();
+  return this->GetValue();
+
+} // end StartSingleOptimization()
+
+
 } // end namespace elastix
 
 #endif // end #ifndef __elxPowell_hxx
@@ -177,7 +177,7 @@ protected:
    * is printed, but ignored further. The optimizer stops, but elastix
    * just goes on to the next resolution. */
   virtual void LineSearch(
-    const ParametersType searchDir,
+    const ParametersType & searchDir,
     double & step,
     ParametersType & x,
     MeasureType & f,
@@ -115,7 +115,7 @@ QuasiNewtonLBFGS< TElastix >::StartOptimization( void )
 template< class TElastix >
 void
 QuasiNewtonLBFGS< TElastix >::LineSearch(
-  const ParametersType searchDir,
+  const ParametersType & searchDir,
   double & step,
   ParametersType & x,
   MeasureType & f,
@@ -21,6 +21,7 @@
 
 #include "itkQuasiNewtonLBFGSOptimizer.h"
 #include "itkArray.h"
+#include "itkOptimizerVectorKernels.h"
 #include "vnl/vnl_math.h"
 
 namespace itk
@@ -80,10 +81,10 @@ QuasiNewtonLBFGSOptimizer::StartOptimization()
   this->m_CurrentGradient.SetSize( numberOfParameters );
   this->m_CurrentGradient.Fill( 0.0 );
 
-  /** Resize Rho, Alpha, S and Y. */
+  /** Resize Rho, S and Y. */
   this->m_Rho.SetSize( this->GetMemory() );
-  this->m_S.resize( this->GetMemory() );
-  this->m_Y.resize( this->GetMemory() );
+  this->m_S.SetSize( this->GetMemory(), numberOfParameters );
+  this->m_Y.SetSize( this->GetMemory(), numberOfParameters );
 
   /** Initialize the scaledCostFunction with the currently set scales */
   this->InitializeScales();
@@ -172,13 +173,7 @@ QuasiNewtonLBFGSOptimizer::ResumeOptimization()
      * compute the search direction in the next iterations */
     if( this->GetMemory() > 0 )
     {
-      ParametersType s;
-      DerivativeType y;
-      s = this->GetCurrentStepLength() * searchDir;
-      y = this->GetCurrentGradient() - previousGradient;
-      this->StoreCurrentPoint( s, y );
-      s.clear();
-      y.clear();
+      this->StoreCurrentPoint( searchDir, previousGradient );
     }
 
     /** Number of valid entries in m_S and m_Y */
@@ -244,9 +239,9 @@ QuasiNewtonLBFGSOptimizer::ComputeDiagonalMatrix( DiagonalMatrixType & diag_H0 )
 
   if( this->m_Bound > 0 )
   {
-    const DerivativeType & y  = this->m_Y[ this->m_PreviousPoint ];
-    const double           ys = 1.0 / this->m_Rho[ this->m_PreviousPoint ];
-    const double           yy = y.squared_magnitude();
+    const double * y  = this->m_Y[ this->m_PreviousPoint ];
+    const double   ys = 1.0 / this->m_Rho[ this->m_PreviousPoint ];
+    const double   yy = OptimizerVectorKernels::InnerProduct( y, y, this->m_Y.cols() );
     fill_value = ys / yy;
     if( fill_value <= 0. )
     {
@@ -277,56 +272,75 @@ QuasiNewtonLBFGSOptimizer::ComputeSearchDirection(
   AlphaType alpha( this->GetMemory() );
 
   const unsigned int numberOfParameters = gradient.GetSize();
+  const unsigned int memory             = this->GetMemory();
   DiagonalMatrixType H0;
   this->ComputeDiagonalMatrix( H0 );
 
-  searchDir = -gradient;
-
-  int cp = static_cast< int >( this->m_Point );
-
+  searchDir = gradient;
+  OptimizerVectorKernels::Scale( -1.0, searchDir );
+  double * q = searchDir.data_block();
+
+  /** First loop, from the newest to the oldest entry:
+   *   alpha_i = rho_i s_i^T q, q = q - alpha_i y_i.
+   * The update of q is fused with the inner product of the next entry,
+   * so that q is traversed once per history entry.
+   */
+  unsigned int cp = this->m_Point;
+  double       sq = 0.0;
   for( unsigned int i = 0; i < this->m_Bound; ++i )
   {
-    --cp;
-    if( cp == -1 )
+    cp = ( cp == 0 ) ? memory - 1 : cp - 1;
+    if( i == 0 )
     {
-      cp = this->GetMemory() - 1;
+      sq = OptimizerVectorKernels::InnerProduct( this->m_S[ cp ], q, numberOfParameters );
     }
-    const double sq = inner_product( this->m_S[ cp ], searchDir );
     alpha[ cp ] = this->m_Rho[ cp ] * sq;
-    const double &         alpha_cp = alpha[ cp ];
-    const DerivativeType & y        = this->m_Y[ cp ];
-    for( unsigned int j = 0; j < numberOfParameters; ++j )
+
+    if( i + 1 < this->m_Bound )
     {
-      searchDir[ j ] -= alpha_cp * y[ j ];
+      const unsigned int next = ( cp == 0 ) ? memory - 1 : cp - 1;
+      sq = OptimizerVectorKernels::AxpyAndInnerProduct(
+        -alpha[ cp ], this->m_Y[ cp ], q, this->m_S[ next ], numberOfParameters );
+    }
+    else
+    {
+      OptimizerVectorKernels::Axpy( -alpha[ cp ], this->m_Y[ cp ], q, numberOfParameters );
     }
   }
 
-  for( unsigned int j = 0; j < numberOfParameters; ++j )
-  {
-    searchDir[ j ] *= H0[ j ];
-  }
+  OptimizerVectorKernels::ElementWiseMultiply( H0, searchDir );
 
+  /** Second loop, from the oldest to the newest entry:
+   *   beta = rho_i y_i^T r, r = r + ( alpha_i - beta ) s_i.
+   * Fused in the same way as the first loop.
+   */
+  double yr = 0.0;
   for( unsigned int i = 0; i < this->m_Bound; ++i )
   {
-    const double           yr             = inner_product( this->m_Y[ cp ], searchDir );
-    const double           beta           = this->m_Rho[ cp ] * yr;
-    const double           alpha_min_beta = alpha[ cp ] - beta;
-    const ParametersType & s              = this->m_S[ cp ];
-    for( unsigned int j = 0; j < numberOfParameters; ++j )
+    if( i == 0 )
     {
-      searchDir[ j ] += alpha_min_beta * s[ j ];
+      yr = OptimizerVectorKernels::InnerProduct( this->m_Y[ cp ], q, numberOfParameters );
     }
-    ++cp;
-    if( static_cast< unsigned int >( cp ) == this->GetMemory() )
+    const double beta = this->m_Rho[ cp ] * yr;
+
+    const unsigned int next = ( cp + 1 == memory ) ? 0 : cp + 1;
+    if( i + 1 < this->m_Bound )
     {
-      cp = 0;
+      yr = OptimizerVectorKernels::AxpyAndInnerProduct(
+        alpha[ cp ] - beta, this->m_S[ cp ], q, this->m_Y[ next ], numberOfParameters );
     }
+    else
+    {
+      OptimizerVectorKernels::Axpy( alpha[ cp ] - beta, this->m_S[ cp ], q, numberOfParameters );
+    }
+    cp = next;
   }
 
   /** Normalize if no information about previous steps is available yet */
   if( this->m_Bound == 0 )
   {
-    searchDir /= gradient.magnitude();
+    OptimizerVectorKernels::Scale(
+      1.0 / OptimizerVectorKernels::Magnitude( gradient ), searchDir );
   }
 
 } // end ComputeSearchDirection
@@ -342,7 +356,7 @@ QuasiNewtonLBFGSOptimizer::ComputeSearchDirection(
 
 void
 QuasiNewtonLBFGSOptimizer::LineSearch(
-  const ParametersType searchDir,
+  const ParametersType & searchDir,
   double & step,
   ParametersType & x,
   MeasureType & f,
@@ -402,14 +416,23 @@ QuasiNewtonLBFGSOptimizer::LineSearch(
 
 void
 QuasiNewtonLBFGSOptimizer::StoreCurrentPoint(
-  const ParametersType & step,
-  const DerivativeType & grad_dif )
+  const ParametersType & searchDir,
+  const DerivativeType & previousGradient )
 {
   itkDebugMacro( "StoreCurrentPoint" );
 
-  this->m_S[ this->m_Point ]   = step;                                  // s
-  this->m_Y[ this->m_Point ]   = grad_dif;                              // y
-  this->m_Rho[ this->m_Point ] = 1.0 / inner_product( step, grad_dif ); // 1/ys
+  /** Write s and y directly into the ring buffer. */
+  const unsigned int numberOfParameters = searchDir.GetSize();
+  double *           s                  = this->m_S[ this->m_Point ];
+  double *           y                  = this->m_Y[ this->m_Point ];
+
+  /** s = step * searchDir, y = g_k - g_k-1, rho = 1/ys. */
+  OptimizerVectorKernels::Scale( this->GetCurrentStepLength(),
+    searchDir.data_block(), s, numberOfParameters );
+  OptimizerVectorKernels::ScaledUpdate( this->GetCurrentGradient().data_block(),
+    -1.0, previousGradient.data_block(), y, numberOfParameters );
+  this->m_Rho[ this->m_Point ] = 1.0
+    / OptimizerVectorKernels::InnerProduct( s, y, numberOfParameters );
 
 } // end StoreCurrentPoint
 
@@ -441,8 +464,8 @@ QuasiNewtonLBFGSOptimizer::TestConvergence( bool firstLineSearchDone )
   }
 
   /** Check for convergence of gradient magnitude */
-  const double gnorm = this->GetCurrentGradient().magnitude();
-  const double xnorm = this->GetScaledCurrentPosition().magnitude();
+  const double gnorm = OptimizerVectorKernels::Magnitude( this->GetCurrentGradient() );
+  const double xnorm = OptimizerVectorKernels::Magnitude( this->GetScaledCurrentPosition() );
   if( gnorm / vnl_math_max( 1.0, xnorm ) <= this->GetGradientMagnitudeTolerance() )
   {
     this->m_StopCondition = GradientMagnitudeTolerance;
@@ -21,7 +21,7 @@
 
 #include "itkScaledSingleValuedNonLinearOptimizer.h"
 #include "itkLineSearchOptimizer.h"
-#include <vector>
+#include "itkArray2D.h"
 
 namespace itk
 {
@@ -74,11 +74,14 @@ public:
   typedef Superclass::MeasureType            MeasureType;
   typedef Superclass::ScalesType             ScalesType;
 
-  typedef Array< double >               RhoType;
-  typedef std::vector< ParametersType > SType;
-  typedef std::vector< DerivativeType > YType;
-  typedef Array< double >               DiagonalMatrixType;
-  typedef LineSearchOptimizer           LineSearchOptimizerType;
+  /** The history of steps s and gradient differences y is stored as a
+   * ring buffer of Memory rows, each row containing one vector.
+   */
+  typedef Array< double >     RhoType;
+  typedef Array2D< double >   SType;
+  typedef Array2D< double >   YType;
+  typedef Array< double >     DiagonalMatrixType;
+  typedef LineSearchOptimizer LineSearchOptimizerType;
 
   typedef LineSearchOptimizerType::Pointer LineSearchOptimizerPointer;
 
@@ -178,17 +181,17 @@ protected:
    * the derivative. On return the step, x (new position), f (value at x), and g
    * (derivative at x) are updated. */
   virtual void LineSearch(
-    const ParametersType searchDir,
+    const ParametersType & searchDir,
     double & step,
     ParametersType & x,
     MeasureType & f,
     DerivativeType & g );
 
-  /** Store s = x_k - x_k-1 and y = g_k - g_k-1 in m_S and m_Y,
-   * and store 1/(ys) in m_Rho. */
+  /** Store s = x_k - x_k-1 = step * searchDir and y = g_k - g_k-1
+   * in row m_Point of m_S and m_Y, and store 1/(ys) in m_Rho. */
   virtual void StoreCurrentPoint(
-    const ParametersType & step,
-    const DerivativeType & grad_dif );
+    const ParametersType & searchDir,
+    const DerivativeType & previousGradient );
 
   /** Check if convergence has occured;
    * The firstLineSearchDone bool allows the implementation of TestConvergence to
@@ -20,6 +20,7 @@
 #define __itkRSGDEachParameterApartBaseOptimizer_cxx
 
 #include "itkRSGDEachParameterApartBaseOptimizer.h"
+#include "itkOptimizerVectorKernels.h"
 #include "itkCommand.h"
 #include "itkEventObject.h"
 #include "vnl/vnl_math.h"
@@ -202,14 +203,7 @@ RSGDEachParameterApartBaseOptimizer
       = m_PreviousGradient[ i ] / scales[ i ];
   }
 
-  double magnitudeSquare = 0;
-  for( unsigned int dim = 0; dim < spaceDimension; dim++ )
-  {
-    const double weighted = transformedGradient[ dim ];
-    magnitudeSquare += weighted * weighted;
-  }
-
-  m_GradientMagnitude = vcl_sqrt( magnitudeSquare );
+  m_GradientMagnitude = OptimizerVectorKernels::Magnitude( transformedGradient );
 
   if( m_GradientMagnitude < m_GradientMagnitudeTolerance )
   {
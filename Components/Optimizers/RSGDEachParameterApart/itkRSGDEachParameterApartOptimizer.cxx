@@ -20,6 +20,7 @@
 #define __itkRSGDEachParameterApartOptimizer_cxx
 
 #include "itkRSGDEachParameterApartOptimizer.h"
+#include "itkOptimizerVectorKernels.h"
 #include "itkCommand.h"
 #include "itkEventObject.h"
 
@@ -38,21 +39,14 @@ RSGDEachParameterApartOptimizer
 
   itkDebugMacro( << "factor = " << factor << "  transformedGradient= " << transformedGradient );
 
-  const unsigned int spaceDimension
-    = m_CostFunction->GetNumberOfParameters();
-
-  ParametersType newPosition( spaceDimension );
-  ParametersType currentPosition = this->GetCurrentPosition();
-
-  for( unsigned int j = 0; j < spaceDimension; j++ )
-  {
-    /** Each parameters has its own factor! */
-    newPosition[ j ] = currentPosition[ j ] + transformedGradient[ j ] * factor[ j ];
-  }
+  /** Update the current position in place. Each parameters has its own factor! */
+  ParametersType & newPosition = this->m_CurrentPosition;
+  OptimizerVectorKernels::ElementWiseUpdate(
+    newPosition, transformedGradient, factor, newPosition );
 
   itkDebugMacro( << "new position = " << newPosition );
 
-  this->SetCurrentPosition( newPosition );
+  this->Modified();
 
 }
 
@@ -99,6 +99,15 @@ public:
    * array have the same size. */
   virtual void SetInitialPosition( const ParametersType & param );
 
+  /** Start the optimization. If more than one starting point is requested
+   * (see OptimizerBase), the optimization is repeated from each of them
+   * and the position with the lowest metric value is kept.
+   */
+  virtual void StartOptimization( void );
+
+  /** Run the ITK optimizer once, for the multi-start optimization. */
+  virtual double StartSingleOptimization( void );
+
 protected:
 
   Simplex(){}
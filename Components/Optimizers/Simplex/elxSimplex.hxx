@@ -185,6 +185,42 @@ Simplex< TElastix >
 } // end SetInitialPosition()
 
 
+/**
+ * ******************* StartOptimization ************************
+ */
+
+template< class TElastix >
+void
+Simplex< TElastix >
+::StartOptimization( void )
+{
+  const unsigned int numberOfStartingPoints = this->GetNumberOfStartingPoints();
+  if( numberOfStartingPoints < 2 )
+  {
+    this->Superclass1::StartOptimization();
+    return;
+  }
+
+  this->SetCurrentPosition( this->StartMultiStartOptimization() );
+
+} // end StartOptimization()
+
+
+/**
+ * ******************* StartSingleOptimization ************************
+ */
+
+template< class TElastix >
+double
+Simplex< TElastix >
+::StartSingleOptimization( void )
+{
+  this->Superclass1::StartOptimization();
+  return this->GetCachedValue();
+
+} // end StartSingleOptimization()
+
+
 } // end namespace elastix
 
 #endif // end #ifndef __elxSimplex_hxx
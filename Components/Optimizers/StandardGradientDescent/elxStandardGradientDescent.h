@@ -59,6 +59,17 @@ namespace elastix
 *   SP_alpha can be defined for each resolution. \n
 *   example: <tt>(SP_alpha 0.602 0.602 0.602)</tt> \n
 *   The default/recommended value is 0.602.
+* \parameter ConvergenceWindowSize: The number of iterations W over which the optimizer
+*   tests for convergence. If the magnitude of the summed gradients of a window is below
+*   ConvergenceTolerance times its value expected for purely random gradients, the
+*   optimization stops before MaximumNumberOfIterations is reached.
+*   ConvergenceWindowSize can be defined for each resolution. \n
+*   example: <tt>(ConvergenceWindowSize 100 100 200)</tt> \n
+*   The default value is 0, which disables the test.
+* \parameter ConvergenceTolerance: The tolerance of the convergence test, see ConvergenceWindowSize.
+*   ConvergenceTolerance can be defined for each resolution. \n
+*   example: <tt>(ConvergenceTolerance 1.5 1.5 1.0)</tt> \n
+*   The default value is 1.5.
 *
 * \sa StandardGradientDescentOptimizer
 * \ingroup Optimizers
@@ -92,6 +92,16 @@ StandardGradientDescent< TElastix >
   this->SetParam_A( A );
   this->SetParam_alpha( alpha );
 
+  /** Set the convergence test. */
+  unsigned long convergenceWindowSize = 0;
+  double        convergenceTolerance  = 1.5;
+  this->GetConfiguration()->ReadParameter( convergenceWindowSize,
+    "ConvergenceWindowSize", this->GetComponentLabel(), level, 0 );
+  this->GetConfiguration()->ReadParameter( convergenceTolerance,
+    "ConvergenceTolerance", this->GetComponentLabel(), level, 0 );
+  this->SetConvergenceWindowSize( convergenceWindowSize );
+  this->SetConvergenceTolerance( convergenceTolerance );
+
   /** Set the MaximumNumberOfSamplingAttempts. */
   unsigned int maximumNumberOfSamplingAttempts = 0;
   this->GetConfiguration()->ReadParameter( maximumNumberOfSamplingAttempts,
@@ -144,7 +154,8 @@ StandardGradientDescent< TElastix >
 ::AfterEachResolution( void )
 {
   /**
-   * enum   StopConditionType {  MaximumNumberOfIterations, MetricError }
+   * enum   StopConditionType {  MaximumNumberOfIterations, MetricError,
+   *   MinimumStepSize, ConvergenceDetected }
    */
   std::string stopcondition;
   switch( this->GetStopCondition() )
@@ -158,6 +169,10 @@ StandardGradientDescent< TElastix >
       stopcondition = "Error in metric";
       break;
 
+    case ConvergenceDetected:
+      stopcondition = "Convergence of the stochastic gradient has been detected";
+      break;
+
     default:
       stopcondition = "Unknown";
       break;
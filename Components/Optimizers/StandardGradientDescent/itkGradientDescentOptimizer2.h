@@ -78,12 +78,13 @@ public:
   typedef Superclass::ScaledCostFunctionPointer ScaledCostFunctionPointer;
 
   /** Codes of stopping conditions
-   * The MinimumStepSize stopcondition never occurs, but may
-   * be implemented in inheriting classes */
+   * The MinimumStepSize and ConvergenceDetected stopconditions never
+   * occur, but may be implemented in inheriting classes */
   typedef enum {
     MaximumNumberOfIterations,
     MetricError,
-    MinimumStepSize
+    MinimumStepSize,
+    ConvergenceDetected
   } StopConditionType;
 
   /** Advance one step following the gradient direction. */
@@ -136,12 +137,6 @@ public:
     this->m_Threader->SetNumberOfThreads( numberOfThreads );
   }
 
-
-  //itkGetConstReferenceMacro( NumberOfThreads, ThreadIdType );
-  itkSetMacro( UseMultiThread, bool );
-  itkSetMacro( UseOpenMP, bool );
-  itkSetMacro( UseEigen, bool );
-
 protected:
 
   GradientDescentOptimizer2();
@@ -170,23 +165,6 @@ private:
   GradientDescentOptimizer2( const Self & ); // purposely not implemented
   void operator=( const Self & );            // purposely not implemented
 
-  // multi-threaded AdvanceOneStep:
-  bool m_UseMultiThread;
-  struct MultiThreaderParameterType
-  {
-    ParametersType * t_NewPosition;
-    Self *           t_Optimizer;
-  };
-
-  bool m_UseOpenMP;
-  bool m_UseEigen;
-
-  /** The callback function. */
-  static ITK_THREAD_RETURN_TYPE AdvanceOneStepThreaderCallback( void * arg );
-
-  /** The threaded implementation of AdvanceOneStep(). */
-  inline void ThreadedAdvanceOneStep( ThreadIdType threadId, ParametersType & newPosition );
-
 };
 
 } // end namespace itk
@@ -20,6 +20,7 @@
 #define __itkStandardGradientDescentOptimizer_cxx
 
 #include "itkStandardGradientDescentOptimizer.h"
+#include "itkOptimizerVectorKernels.h"
 #include "vnl/vnl_math.h"
 
 namespace itk
@@ -40,6 +41,11 @@ StandardGradientDescentOptimizer
   this->m_InitialTime     = 0.0;
   this->m_UseConstantStep = false;
 
+  this->m_ConvergenceWindowSize      = 0;
+  this->m_ConvergenceTolerance       = 1.5;
+  this->m_NumberOfIterationsInWindow = 0;
+  this->m_WindowGradientMagnitudeSum = 0.0;
+
 } // end Constructor
 
 
@@ -50,7 +56,10 @@ StandardGradientDescentOptimizer
 void
 StandardGradientDescentOptimizer::StartOptimization( void )
 {
-  this->m_CurrentTime = this->m_InitialTime;
+  this->m_CurrentTime                = this->m_InitialTime;
+  this->m_NumberOfIterationsInWindow = 0;
+  this->m_WindowGradientMagnitudeSum = 0.0;
+  this->m_WindowGradientSum.SetSize( 0 );
   this->Superclass::StartOptimization();
 } // end StartOptimization()
 
@@ -77,9 +86,62 @@ StandardGradientDescentOptimizer
 
   this->UpdateCurrentTime();
 
+  /** Stop if the gradient has become dominated by noise. */
+  if( this->TestConvergence() )
+  {
+    this->m_StopCondition = ConvergenceDetected;
+    this->StopOptimization();
+  }
+
 } // end AdvanceOneStep()
 
 
+/**
+ * ************************** TestConvergence *******************
+ */
+
+bool
+StandardGradientDescentOptimizer
+::TestConvergence( void )
+{
+  if( this->m_ConvergenceWindowSize == 0 )
+  {
+    return false;
+  }
+
+  /** Start a new window. */
+  if( this->m_NumberOfIterationsInWindow == 0 )
+  {
+    this->m_WindowGradientSum.SetSize( this->m_Gradient.GetSize() );
+    this->m_WindowGradientSum.Fill( 0.0 );
+    this->m_WindowGradientMagnitudeSum = 0.0;
+  }
+
+  /** Accumulate the gradient and its magnitude. */
+  OptimizerVectorKernels::Axpy( 1.0, this->m_Gradient, this->m_WindowGradientSum );
+  this->m_WindowGradientMagnitudeSum
+    += OptimizerVectorKernels::Magnitude( this->m_Gradient );
+  ++this->m_NumberOfIterationsInWindow;
+
+  if( this->m_NumberOfIterationsInWindow < this->m_ConvergenceWindowSize )
+  {
+    return false;
+  }
+
+  /** End of the window: compare the magnitude of the summed gradients
+   * with its expected value for purely random gradients.
+   */
+  this->m_NumberOfIterationsInWindow = 0;
+  const double sumMagnitude
+    = OptimizerVectorKernels::Magnitude( this->m_WindowGradientSum );
+  const double noiseMagnitude = this->m_WindowGradientMagnitudeSum
+    / vcl_sqrt( static_cast< double >( this->m_ConvergenceWindowSize ) );
+
+  return sumMagnitude < this->m_ConvergenceTolerance * noiseMagnitude;
+
+} // end TestConvergence()
+
+
 /**
  * ************************** Compute_a *************************
  */
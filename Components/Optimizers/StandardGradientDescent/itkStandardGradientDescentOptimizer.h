@@ -55,6 +55,20 @@ namespace itk
  * "Evaluation of Optimization Methods for Nonrigid Medical Image Registration using Mutual Information and B-Splines"
  * IEEE Transactions on Image Processing, 2007, nr. 16(12), December.
  *
+ * Optionally, the optimization is stopped before the maximum number of
+ * iterations is reached, when the gradient is dominated by noise. The
+ * iterations are divided into windows of ConvergenceWindowSize iterations.
+ * At the end of each window the magnitude of the summed gradients is compared
+ * to the sum of the gradient magnitudes. For purely random gradients
+ * the ratio of the two is about \f$1/\sqrt{W}\f$, with \f$W\f$ the window size,
+ * while it approaches 1 for a consistent descent direction. Convergence is
+ * declared if
+ *
+ *     \f[ \| \sum_k g_k \| < \tau \sum_k \| g_k \| / \sqrt{W} \f],
+ *
+ * with \f$\tau\f$ the ConvergenceTolerance. A window size of 0 (default)
+ * disables this test.
+ *
  * This class also serves as a base class for other GradientDescent type
  * algorithms, like the AcceleratedGradientDescentOptimizer.
  *
@@ -106,6 +120,15 @@ public:
    * implementation, and updates the current time. */
   virtual void AdvanceOneStep( void );
 
+  /** Set/Get the number of iterations over which convergence is tested.
+   * Default: 0, which disables the convergence test. */
+  itkSetMacro( ConvergenceWindowSize, unsigned long );
+  itkGetConstMacro( ConvergenceWindowSize, unsigned long );
+
+  /** Set/Get the tolerance of the convergence test. Default: 1.5 */
+  itkSetMacro( ConvergenceTolerance, double );
+  itkGetConstMacro( ConvergenceTolerance, double );
+
   /** Set current time to 0 and call superclass' implementation. */
   virtual void StartOptimization( void );
 
@@ -150,6 +173,10 @@ protected:
   /** Constant step size or others, different value of k. */
   bool m_UseConstantStep;
 
+  /** Accumulate the current gradient in the convergence window, and
+   * return true if convergence has been detected at the end of a window. */
+  virtual bool TestConvergence( void );
+
 private:
 
   StandardGradientDescentOptimizer( const Self & ); // purposely not implemented
@@ -163,6 +190,13 @@ private:
   /** Settings */
   double m_InitialTime;
 
+  /** Convergence test settings and window statistics. */
+  unsigned long  m_ConvergenceWindowSize;
+  double         m_ConvergenceTolerance;
+  unsigned long  m_NumberOfIterationsInWindow;
+  DerivativeType m_WindowGradientSum;
+  double         m_WindowGradientMagnitudeSum;
+
 };
 
 } // end namespace itk
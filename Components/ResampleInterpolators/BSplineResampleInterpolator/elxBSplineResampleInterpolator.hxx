@@ -44,6 +44,12 @@ BSplineResampleInterpolator< TElastix >
   /** Set the splineOrder in the superclass. */
   this->SetSplineOrder( splineOrder );
 
+  /** Check if the coefficients may be shared through the cache. */
+  bool useCache = false;
+  this->m_Configuration->ReadParameter( useCache,
+    "UseBSplineCoefficientCache", 0, false );
+  this->SetUseCoefficientCache( useCache );
+
 } // end BeforeRegistration()
 
 
@@ -71,6 +77,12 @@ BSplineResampleInterpolator< TElastix >
   /** Set the splineOrder in the superclass. */
   this->SetSplineOrder( splineOrder );
 
+  /** Check if the coefficients may be shared through the cache. */
+  bool useCache = false;
+  this->m_Configuration->ReadParameter( useCache,
+    "UseBSplineCoefficientCache", 0, false );
+  this->SetUseCoefficientCache( useCache );
+
 } // end ReadFromFile()
 
 
@@ -19,7 +19,7 @@
 #define __elxBSplineResampleInterpolatorFloat_h
 
 #include "elxIncludes.h" // include first to avoid MSVS warning
-#include "itkBSplineInterpolateImageFunction.h"
+#include "itkCachedBSplineInterpolateImageFunction.h"
 
 namespace elastix
 {
@@ -39,6 +39,12 @@ namespace elastix
 *    the deformed moving image; possible values: (0-5) \n
 *    example: <tt>(FinalBSplineInterpolationOrder 3 ) </tt> \n
 *    Default: 3.
+* \parameter UseBSplineCoefficientCache: whether the B-spline coefficients of the
+*    moving image are shared with the final resamplers of the next parameter files,
+*    which use the same moving image, instead of being computed again. The metrics
+*    interpolate the moving pyramid images, so they do not share with the resampler.
+*    example: <tt>(UseBSplineCoefficientCache "true")</tt> \n
+*    Default: "false". Cached coefficients are released when their image is deleted.
 *
 * The transform parameters necessary for transformix, additionally defined by this class, are:
 * \transformparameter FinalBSplineInterpolationOrder: the order of the B-spline used to resample
@@ -53,7 +59,7 @@ namespace elastix
 template< class TElastix >
 class BSplineResampleInterpolatorFloat :
   public
-  itk::BSplineInterpolateImageFunction<
+  itk::CachedBSplineInterpolateImageFunction<
   typename ResampleInterpolatorBase< TElastix >::InputImageType,
   typename ResampleInterpolatorBase< TElastix >::CoordRepType,
   float >,   //CoefficientType
@@ -63,7 +69,7 @@ public:
 
   /** Standard ITK-stuff. */
   typedef BSplineResampleInterpolatorFloat Self;
-  typedef itk::BSplineInterpolateImageFunction<
+  typedef itk::CachedBSplineInterpolateImageFunction<
     typename ResampleInterpolatorBase< TElastix >::InputImageType,
     typename ResampleInterpolatorBase< TElastix >::CoordRepType,
     float >                                     Superclass1;
@@ -75,7 +81,7 @@ public:
   itkNewMacro( Self );
 
   /** Run-time type information (and related methods). */
-  itkTypeMacro( BSplineResampleInterpolatorFloat, BSplineInterpolateImageFunction );
+  itkTypeMacro( BSplineResampleInterpolatorFloat, CachedBSplineInterpolateImageFunction );
 
   /** Name of this class.
   * Use this name in the parameter file to select this specific resample interpolator. \n
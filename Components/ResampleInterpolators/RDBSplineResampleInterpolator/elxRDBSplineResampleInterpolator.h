@@ -35,6 +35,12 @@ namespace elastix
 *    the deformed moving image; possible values: (0-5) \n
 *    example: <tt>(FinalReducedDimensionBSplineInterpolationOrder 3) </tt> \n
 *    Default: 3.
+* \parameter UseBSplineCoefficientCache: whether the B-spline coefficients of the
+*    moving image are shared with the final resamplers of the next parameter files,
+*    which use the same moving image, instead of being computed again. The metrics
+*    interpolate the moving pyramid images, so they do not share with the resampler.
+*    example: <tt>(UseBSplineCoefficientCache "true")</tt> \n
+*    Default: "false". Cached coefficients are released when their image is deleted.
 *
 * The transform parameters necessary for transformix, additionally defined by this class, are:
 * \transformparameter FinalReducedDimensionBSplineInterpolationOrder: the order of the B-spline used to resample
@@ -51,6 +51,12 @@ ReducedDimensionBSplineResampleInterpolator< TElastix >
   /** Set the splineOrder in the superclass. */
   this->SetSplineOrder( splineOrder );
 
+  /** Check if the coefficients may be shared through the cache. */
+  bool useCache = false;
+  this->m_Configuration->ReadParameter( useCache,
+    "UseBSplineCoefficientCache", 0, false );
+  this->SetUseCoefficientCache( useCache );
+
 } // end BeforeRegistration()
 
 
@@ -85,6 +91,12 @@ ReducedDimensionBSplineResampleInterpolator< TElastix >
   /** Set the splineOrder in the superclass. */
   this->SetSplineOrder( splineOrder );
 
+  /** Check if the coefficients may be shared through the cache. */
+  bool useCache = false;
+  this->m_Configuration->ReadParameter( useCache,
+    "UseBSplineCoefficientCache", 0, false );
+  this->SetUseCoefficientCache( useCache );
+
 } // end ReadFromFile()
 
 
@@ -99,6 +99,9 @@ AdvancedBSplineTransform< TElastix >
   this->m_GridUpsampler = GridUpsamplerType::New();
   this->m_GridUpsampler->SetBSplineOrder( this->m_SplineOrder );
 
+  /** Evaluate the displacement using single precision coefficients. */
+  this->m_BSplineTransform->SetUseFloatCoefficients( this->m_UseFloatCoefficients );
+
   return 0;
 } // end InitializeBSplineTransform()
 
@@ -112,13 +115,16 @@ int
 AdvancedBSplineTransform< TElastix >
 ::BeforeAll( void )
 {
-  /** Read spline order and periodicity setting from configuration file. */
+  /** Read spline order, periodicity and precision setting from configuration file. */
   this->m_SplineOrder = 3;
   this->GetConfiguration()->ReadParameter( this->m_SplineOrder,
     "BSplineTransformSplineOrder", this->GetComponentLabel(), 0, 0, true );
   this->m_Cyclic = false;
   this->GetConfiguration()->ReadParameter( this->m_Cyclic,
     "UseCyclicTransform", this->GetComponentLabel(), 0, 0, true );
+  this->m_UseFloatCoefficients = false;
+  this->GetConfiguration()->ReadParameter( this->m_UseFloatCoefficients,
+    "BSplineTransformUseFloatCoefficients", this->GetComponentLabel(), 0, 0, false );
 
   return this->InitializeBSplineTransform();
 } // end BeforeAll()
@@ -487,13 +493,16 @@ void
 AdvancedBSplineTransform< TElastix >
 ::ReadFromFile( void )
 {
-  /** Read spline order and periodicity settings and initialize BSplineTransform. */
+  /** Read spline order, periodicity and precision settings and initialize BSplineTransform. */
   this->m_SplineOrder = 3;
   this->GetConfiguration()->ReadParameter( this->m_SplineOrder,
     "BSplineTransformSplineOrder", this->GetComponentLabel(), 0, 0 );
   this->m_Cyclic = false;
   this->GetConfiguration()->ReadParameter( this->m_Cyclic,
     "UseCyclicTransform", this->GetComponentLabel(), 0, 0 );
+  this->m_UseFloatCoefficients = false;
+  this->GetConfiguration()->ReadParameter( this->m_UseFloatCoefficients,
+    "BSplineTransformUseFloatCoefficients", this->GetComponentLabel(), 0, 0, false );
   this->InitializeBSplineTransform();
 
   /** Read and Set the Grid: this is a BSplineTransform specific task. */
@@ -616,7 +625,7 @@ AdvancedBSplineTransform< TElastix >
   }
   xout[ "transpar" ] << ")" << std::endl;
 
-  /** Write the spline order and periodicity of this transform. */
+  /** Write the spline order, periodicity and precision of this transform. */
   xout[ "transpar" ] << "(BSplineTransformSplineOrder " << m_SplineOrder << ")" << std::endl;
   std::string m_CyclicString = "false";
   if( m_Cyclic )
@@ -624,6 +633,8 @@ AdvancedBSplineTransform< TElastix >
     m_CyclicString = "true";
   }
   xout[ "transpar" ] << "(UseCyclicTransform \"" << m_CyclicString << "\")" << std::endl;
+  xout[ "transpar" ] << "(BSplineTransformUseFloatCoefficients \""
+                     << ( this->m_UseFloatCoefficients ? "true" : "false" ) << "\")" << std::endl;
 
   /** Set the precision back to default value. */
   xout[ "transpar" ] << std::setprecision(
@@ -736,6 +747,11 @@ AdvancedBSplineTransform< TElastix >
   paramsMap->insert( make_pair( parameterName, parameterValues ) );
   parameterValues.clear();
 
+  parameterName = "BSplineTransformUseFloatCoefficients";
+  parameterValues.push_back( this->m_UseFloatCoefficients ? "true" : "false" );
+  paramsMap->insert( make_pair( parameterName, parameterValues ) );
+  parameterValues.clear();
+
   /** Set the precision back to default value. */
 //  xout["transpar"] << std::setprecision(
 //  this->m_Elastix->GetDefaultOutputPrecision() );
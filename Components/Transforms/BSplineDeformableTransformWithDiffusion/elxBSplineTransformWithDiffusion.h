@@ -259,18 +259,12 @@ public:
   typedef typename ElastixType::MovingImageType MovingImageELXType;
 
   /** Other typedef's.*/
-  typedef itk::Image< short,
-    itkGetStaticConstMacro( SpaceDimension ) >      DummyImageType;
-  typedef itk::ImageRegionConstIterator<
-    DummyImageType >                                DummyIteratorType;
   typedef typename BSplineTransformType::Pointer BSplineTransformPointer;
   typedef typename Superclass1::Superclass       GenericDeformationFieldRegulizer;
 
   /** Typedef's for the diffusion of the deformation field. */
   typedef itk::ImageFileReader< VectorImageType > VectorReaderType;
   typedef typename VectorImageType::PixelType     VectorType;
-  typedef itk::ImageRegionIterator<
-    VectorImageType >                               VectorImageIteratorType;
   typedef FixedImageELXType                      GrayValueImageType;
   typedef typename GrayValueImageType::Pointer   GrayValueImagePointer;
   typedef typename GrayValueImageType::PixelType GrayValuePixelType;
@@ -279,6 +273,7 @@ public:
   typedef itk::MaximumImageFilter<
     GrayValueImageType, GrayValueImageType,
     GrayValueImageType >                            MaximumImageFilterType;
+  typedef typename MaximumImageFilterType::Pointer MaximumImageFilterPointer;
   typedef itk::VectorMeanDiffusionImageFilter<
     VectorImageType, GrayValueImageType >           DiffusionFilterType;
   typedef typename DiffusionFilterType::Pointer DiffusionFilterPointer;
@@ -390,6 +385,7 @@ private:
   std::string                 m_FixedSegmentationFileName;
   ResamplerPointer1           m_Resampler1;
   ResamplerPointer2           m_Resampler2;
+  MaximumImageFilterPointer   m_MaximumImageFilter;
   InterpolatorPointer         m_Interpolator;
   RegionType                  m_DeformationRegion;
   OriginType                  m_DeformationOrigin;
@@ -58,6 +58,7 @@ BSplineTransformWithDiffusion< TElastix >
   this->m_MovingSegmentationFileName = "";
   this->m_FixedSegmentationFileName  = "";
   this->m_Resampler1                 = 0;
+  this->m_MaximumImageFilter         = 0;
   this->m_Resampler2                 = 0;
   this->m_WriteDiffusionFiles        = false;
   this->m_AlsoFixed                  = true;
@@ -575,6 +576,7 @@ BSplineTransformWithDiffusion< TElastix >
   this->m_MovingSegmentationImage  = 0;
   this->m_FixedSegmentationImage   = 0;
   this->m_Diffusion                = 0;
+  this->m_MaximumImageFilter       = 0;
 
   /** In the very last iteration of the registration in the function
    * DiffuseDeformationField() the intermediary deformation field is updated:
@@ -1138,42 +1140,35 @@ BSplineTransformWithDiffusion< TElastix >
 
   /** ------------- 1: Create deformationField. ------------- */
 
-  /** First, create a dummyImage with the right region info, so
-   * that the TransformIndexToPhysicalPoint-functions will be right.
+  /** The deformation field is preallocated in BeforeRegistration(), with
+   * the region, origin and spacing of the fixed image. Its buffer is reused
+   * for every diffusion step. TransformPoint() is thread safe, so the field
+   * can be filled in parallel, directly into the buffer.
    */
-  typename DummyImageType::Pointer dummyImage = DummyImageType::New();
-  dummyImage->SetRegions( this->m_DeformationRegion );
-  dummyImage->SetOrigin( this->m_DeformationOrigin );
-  dummyImage->SetSpacing( this->m_DeformationSpacing );
-
-  /** Setup an iterator over dummyImage and outputImage. */
-  DummyIteratorType       iter( dummyImage, this->m_DeformationRegion );
-  VectorImageIteratorType iterout( this->m_DeformationField, this->m_DeformationRegion );
-
-  /** Declare stuff. */
-  InputPointType  inputPoint;
-  OutputPointType outputPoint;
-  VectorType      diff_point;
-  IndexType       inputIndex;
+  VectorImageType * deformationField = this->m_DeformationField;
+  VectorType *      fieldBuffer      = deformationField->GetBufferPointer();
+  const long        numberOfPixels
+    = static_cast< long >( this->m_DeformationRegion.GetNumberOfPixels() );
 
   /** Calculate the TransformPoint of all voxels of the image. */
-  iter.GoToBegin();
-  iterout.GoToBegin();
-  while( !iter.IsAtEnd() )
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for schedule( static )
+#endif
+  for( long offset = 0; offset < numberOfPixels; ++offset )
   {
-    inputIndex = iter.GetIndex();
-    /** Transform the points to physical space. */
-    dummyImage->TransformIndexToPhysicalPoint( inputIndex, inputPoint );
-    /** Call TransformPoint. */
-    outputPoint = this->TransformPoint( inputPoint );
-    /** Calculate the difference. */
+    /** Transform the index to physical space. */
+    const IndexType inputIndex = deformationField->ComputeIndex( offset );
+    InputPointType  inputPoint;
+    deformationField->TransformIndexToPhysicalPoint( inputIndex, inputPoint );
+
+    /** Call TransformPoint and store the difference. */
+    const OutputPointType outputPoint = this->TransformPoint( inputPoint );
+    VectorType            diff_point;
     for( unsigned int i = 0; i < this->FixedImageDimension; i++ )
     {
       diff_point[ i ] = outputPoint[ i ] - inputPoint[ i ];
     }
-    iterout.Set( diff_point );
-    ++iter;
-    ++iterout;
+    fieldBuffer[ offset ] = diff_point;
   }
 
   /** ------------- 2: Update the intermediary deformationFieldTransform. ------------- */
@@ -1221,14 +1216,17 @@ BSplineTransformWithDiffusion< TElastix >
     /** If wanted also take the fixed image into account
      * for the derivation of the GrayValueImage, by taking the maximum.
      */
-    typename MaximumImageFilterType::Pointer maximumImageFilter;
     if( this->m_AlsoFixed )
     {
-      maximumImageFilter = MaximumImageFilterType::New();
-      maximumImageFilter->SetInput( 0, this->m_GrayValueImage1 );
-      maximumImageFilter->SetInput( 1, dynamic_cast< FixedImageELXType * >(
+      if( this->m_MaximumImageFilter.IsNull() )
+      {
+        this->m_MaximumImageFilter = MaximumImageFilterType::New();
+      }
+      this->m_MaximumImageFilter->SetInput( 0, this->m_GrayValueImage1 );
+      this->m_MaximumImageFilter->SetInput( 1, dynamic_cast< FixedImageELXType * >(
           this->m_Elastix->GetFixedImage() ) );
-      this->m_GrayValueImage2 = maximumImageFilter->GetOutput();
+      this->m_MaximumImageFilter->Modified();
+      this->m_GrayValueImage2 = this->m_MaximumImageFilter->GetOutput();
 
       /** Do the maximum (OR filter). */
       try
@@ -1268,14 +1266,17 @@ BSplineTransformWithDiffusion< TElastix >
   /** In case we do use a segmentation of the moving image: */
   else
   {
-    typename MaximumImageFilterType::Pointer maximumImageFilter;
     /** Check if we also want to use a segmentation of the fixed image. */
     if( this->m_UseFixedSegmentation )
     {
-      maximumImageFilter = MaximumImageFilterType::New();
-      maximumImageFilter->SetInput( 0, this->m_GrayValueImage1 );
-      maximumImageFilter->SetInput( 1, this->m_FixedSegmentationImage );
-      this->m_GrayValueImage2 = maximumImageFilter->GetOutput();
+      if( this->m_MaximumImageFilter.IsNull() )
+      {
+        this->m_MaximumImageFilter = MaximumImageFilterType::New();
+      }
+      this->m_MaximumImageFilter->SetInput( 0, this->m_GrayValueImage1 );
+      this->m_MaximumImageFilter->SetInput( 1, this->m_FixedSegmentationImage );
+      this->m_MaximumImageFilter->Modified();
+      this->m_GrayValueImage2 = this->m_MaximumImageFilter->GetOutput();
 
       /** Do the maximum (OR filter). */
       try
@@ -77,15 +77,22 @@ DeformationVectorFieldTransform< TScalarType, NDimensions >
   typedef ImageRegionIterator< CoefficientImageType >            IteratorType;
 
   /** Create array of images representing the B-spline
-   * coefficients in each dimension.
+   * coefficients in each dimension. The images of a previous call
+   * are reused if the region did not change.
    */
+  const typename CoefficientVectorImageType::RegionType region
+    = vecImage->GetLargestPossibleRegion();
   for( unsigned int i = 0; i < SpaceDimension; i++ )
   {
-    this->m_Images[ i ] = CoefficientImageType::New();
-    this->m_Images[ i ]->SetRegions( vecImage->GetLargestPossibleRegion() );
+    if( this->m_Images[ i ].IsNull()
+      || this->m_Images[ i ]->GetLargestPossibleRegion() != region )
+    {
+      this->m_Images[ i ] = CoefficientImageType::New();
+      this->m_Images[ i ]->SetRegions( region );
+      this->m_Images[ i ]->Allocate();
+    }
     this->m_Images[ i ]->SetOrigin( vecImage->GetOrigin() );
     this->m_Images[ i ]->SetSpacing( vecImage->GetSpacing() );
-    this->m_Images[ i ]->Allocate();
   }
 
   /** Setup the iterators. */
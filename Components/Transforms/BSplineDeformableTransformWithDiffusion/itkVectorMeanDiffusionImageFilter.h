@@ -140,6 +140,9 @@ protected:
    */
   void GenerateData( void );
 
+  /** Perform one iteration of the diffusion, from source to destination. */
+  void DiffuseOnce( InputImageType * source, InputImageType * destination ) const;
+
 private:
 
   VectorMeanDiffusionImageFilter( const Self & );  // purposely not implemented
@@ -153,6 +156,9 @@ private:
   GrayValueImagePointer m_GrayValueImage;
   DoubleImagePointer    m_Cx;
 
+  /** Temporary image for the iterations, reused between calls. */
+  typename InputImageType::Pointer m_TemporaryOutput;
+
   RescaleImageFilterPointer m_RescaleFilter;
 
   /** For calculating a feature image from the input m_GrayValueImage. */
@@ -21,11 +21,12 @@
 
 #include "itkVectorMeanDiffusionImageFilter.h"
 
-#include "itkNeighborhoodIterator.h"
+#include "itkConstNeighborhoodIterator.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionConstIterator.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 #include "itkProgressReporter.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -41,9 +42,10 @@ VectorMeanDiffusionImageFilter< TInputImage, TGrayValueImage >
   /** Initialize things for the filter. */
   this->m_NumberOfIterations = 0;
   this->m_Radius.Fill( 1 );
-  this->m_RescaleFilter  = 0;
-  this->m_GrayValueImage = 0;
-  this->m_Cx             = 0;
+  this->m_RescaleFilter   = 0;
+  this->m_GrayValueImage  = 0;
+  this->m_Cx              = 0;
+  this->m_TemporaryOutput = 0;
 
 } // end Constructor
 
@@ -115,31 +117,14 @@ void
 VectorMeanDiffusionImageFilter< TInputImage, TGrayValueImage >
 ::GenerateData( void )
 {
-  // \todo to avoid all the copying we can create a vector of
-  // outputs of size this->GetNumberOfIterations(). The last
-  // output should point to this->GetOutput(). In order to avoid
-  // a big memory footprint, at some iteration k, memory of the
-  // former iteration should be released: output[ k - 1 ] = 0,
-  // and memory of the current iteration should only now be created:
-  // output[ k ] = InputImageType::New(); ...; output[ k ]->Allocate().
-  // Only for the last iteration: output[ k ]( this->GetOutput() ).
-
   /** Create feature image. */
   this->FilterGrayValueImage();
 
-  /** Declare things. */
-  unsigned int                                        i, j;
-  ZeroFluxNeumannBoundaryCondition< InputImageType >  nbc;
-  ZeroFluxNeumannBoundaryCondition< DoubleImageType > nbc2;
-  NeighborhoodIterator< InputImageType >              nit;
-  NeighborhoodIterator< DoubleImageType >             nit2;
-  VectorRealType                                      sum;
-
   /** Allocate output. */
   typename InputImageType::ConstPointer input( this->GetInput() );
   typename InputImageType::Pointer      output( this->GetOutput() );
-  typename InputImageType::Pointer outputtmp = InputImageType::New();
-  output->SetRegions( input->GetLargestPossibleRegion() );
+  const InputImageRegionType            region = input->GetLargestPossibleRegion();
+  output->SetRegions( region );
 
   try
   {
@@ -155,151 +140,143 @@ VectorMeanDiffusionImageFilter< TInputImage, TGrayValueImage >
     throw excp;
   }
 
-  /** Allocate a temporary output image. */
-  outputtmp->SetSpacing( input->GetSpacing() );
-  outputtmp->SetOrigin( input->GetOrigin() );
-  outputtmp->SetRegions( input->GetLargestPossibleRegion() );
-
-  try
-  {
-    outputtmp->Allocate();
-  }
-  catch( itk::ExceptionObject & excp )
+  /** Allocate a temporary output image. It is kept between calls,
+   * so that repeated diffusion of a field of the same size does not
+   * allocate new memory.
+   */
+  if( this->m_TemporaryOutput.IsNull()
+    || this->m_TemporaryOutput->GetBufferedRegion() != region )
   {
-    /** Add information to the exception and throw again. */
-    excp.SetLocation( "VectorMeanDiffusionImageFilter - GenerateData()" );
-    std::string err_str = excp.GetDescription();
-    err_str += "\nError occurred while allocating a temporary copy.\n";
-    excp.SetDescription( err_str );
-    throw excp;
-  }
+    this->m_TemporaryOutput = InputImageType::New();
+    this->m_TemporaryOutput->SetRegions( region );
 
-  // support progress methods/callbacks
-  //ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
+    try
+    {
+      this->m_TemporaryOutput->Allocate();
+    }
+    catch( itk::ExceptionObject & excp )
+    {
+      /** Add information to the exception and throw again. */
+      excp.SetLocation( "VectorMeanDiffusionImageFilter - GenerateData()" );
+      std::string err_str = excp.GetDescription();
+      err_str += "\nError occurred while allocating a temporary copy.\n";
+      excp.SetDescription( err_str );
+      throw excp;
+    }
+  }
+  this->m_TemporaryOutput->SetSpacing( input->GetSpacing() );
+  this->m_TemporaryOutput->SetOrigin( input->GetOrigin() );
 
   /** Copy input to output. */
-  ImageRegionConstIterator< InputImageType > in_it(
-  input, input->GetLargestPossibleRegion() );
-  ImageRegionIterator< InputImageType > out_it(
-  output, input->GetLargestPossibleRegion() );
-  in_it.GoToBegin();
-  out_it.GoToBegin();
-  while( !in_it.IsAtEnd() )
+  const unsigned long numberOfPixels = region.GetNumberOfPixels();
+  std::copy( input->GetBufferPointer(),
+    input->GetBufferPointer() + numberOfPixels, output->GetBufferPointer() );
+
+  /** The iterations alternate between the output and the temporary image,
+   * so that the result of an iteration need not be copied back.
+   */
+  InputImageType * source      = output;
+  InputImageType * destination = this->m_TemporaryOutput;
+  for( unsigned int k = 0; k < this->GetNumberOfIterations(); k++ )
   {
-    out_it.Set( in_it.Get() );
-    ++in_it;
-    ++out_it;
+    this->DiffuseOnce( source, destination );
+    std::swap( source, destination );
   }
 
-  /** Setup neighborhood iterator for the output deformation image. */
-  nit = NeighborhoodIterator< InputImageType >(
-    this->m_Radius, output, output->GetLargestPossibleRegion() );
-  unsigned int neighborhoodSize = nit.Size();
-  nit.OverrideBoundaryCondition( &nbc );
+  /** After an odd number of iterations the result is in the temporary image.
+   * Exchange the buffers instead of copying the result.
+   */
+  if( source != output.GetPointer() )
+  {
+    typename InputImageType::PixelContainerPointer resultContainer
+      = this->m_TemporaryOutput->GetPixelContainer();
+    this->m_TemporaryOutput->SetPixelContainer( output->GetPixelContainer() );
+    output->SetPixelContainer( resultContainer );
+  }
 
-  /** Setup neighborhood iterator for the "stiffness coefficient" image. */
-  nit2 = NeighborhoodIterator< DoubleImageType >(
-    this->m_Radius, this->m_Cx, this->m_Cx->GetLargestPossibleRegion() );
-  nit2.OverrideBoundaryCondition( &nbc2 );
+} // end GenerateData()
 
-  /** Setup iterator over outputtmp. */
-  ImageRegionIterator< InputImageType > oit(
-  outputtmp, input->GetLargestPossibleRegion() );
 
-  /** Initialize c and ci. */
-  double c  = 0.0;
-  double ci = 0.0;
+/**
+ * ********************** DiffuseOnce **************************
+ */
 
-  /** Loop over the number of iterations. */
-  for( unsigned int k = 0; k < this->GetNumberOfIterations(); k++ )
+template< class TInputImage, class TGrayValueImage >
+void
+VectorMeanDiffusionImageFilter< TInputImage, TGrayValueImage >
+::DiffuseOnce( InputImageType * source, InputImageType * destination ) const
+{
+  /** The image is processed slice by slice along the last dimension.
+   * The slices are independent, so they can be processed in parallel.
+   */
+  const InputImageRegionType region     = source->GetLargestPossibleRegion();
+  const unsigned int         splitDim   = InputImageDimension - 1;
+  const long                 firstSlice = region.GetIndex()[ splitDim ];
+  const long                 nrOfSlices = static_cast< long >( region.GetSize()[ splitDim ] );
+
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for schedule( dynamic )
+#endif
+  for( long slice = 0; slice < nrOfSlices; ++slice )
   {
-    /** Reset the iterators. */
-    nit.GoToBegin();
-    nit2.GoToBegin();
-    oit.GoToBegin();
-
-    /** The actual work. */
-    while( !nit.IsAtEnd() )
+    InputImageRegionType sliceRegion = region;
+    sliceRegion.SetIndex( splitDim, firstSlice + slice );
+    sliceRegion.SetSize( splitDim, 1 );
+
+    /** Setup neighborhood iterators for the source deformation image and
+     * the "stiffness coefficient" image, and an iterator over the destination.
+     */
+    ZeroFluxNeumannBoundaryCondition< InputImageType >  nbc;
+    ZeroFluxNeumannBoundaryCondition< DoubleImageType > nbc2;
+    ConstNeighborhoodIterator< InputImageType >  nit( this->m_Radius, source, sliceRegion );
+    ConstNeighborhoodIterator< DoubleImageType > nit2( this->m_Radius, this->m_Cx, sliceRegion );
+    nit.OverrideBoundaryCondition( &nbc );
+    nit2.OverrideBoundaryCondition( &nbc2 );
+    ImageRegionIterator< InputImageType > oit( destination, sliceRegion );
+    const unsigned int                    neighborhoodSize = nit.Size();
+
+    for( nit.GoToBegin(), nit2.GoToBegin(), oit.GoToBegin(); !nit.IsAtEnd(); ++nit, ++nit2, ++oit )
     {
       /** Speed up: do not filter locations where c(x) = 0. */
-      if( nit2.GetCenterPixel() < 0.000001 )
+      const double c = nit2.GetCenterPixel();
+      if( c < 0.000001 )
       {
         /** Just copy input to output. */
         oit.Set( nit.GetCenterPixel() );
+        continue;
       }
-      else
-      {
-        /** Initialize the sum to 0. */
-        for( j = 0; j < InputImageDimension; j++ )
-        {
-          sum[ j ] = NumericTraits< double >::Zero;
-        }
 
-        /** Initialize sumc. */
-        double sumc = 0.0;
-
-        /** Calculate the weighted mean over the neighborhood.
-         * mean = SUthis->m_i{ ci * x_i } / SUthis->m_i{ ci }
-         */
-        for( i = 0; i < neighborhoodSize; ++i )
-        {
-          /** Get current pixel in this neighborhood. */
-          InputPixelType pix = nit.GetPixel( i );
-
-          /** Get ci-value on current index. */
-          ci = nit2.GetPixel( i );
-
-          /** Calculate SUthis->m_i{ ci } and SUthis->m_i{ ci * x_i }. */
-          sumc += ci;
-          for( j = 0; j < InputImageDimension; j++ )
-          {
-            sum[ j ] += ci * static_cast< double >( pix[ j ] );
-          }
-        }
-
-        /** Get the mean value by dividing by sumc. */
-        InputPixelType mean;
-        for( j = 0; j < InputImageDimension; j++ )
+      /** Calculate the weighted mean over the neighborhood.
+       * mean = SUM_i{ ci * x_i } / SUM_i{ ci }
+       */
+      VectorRealType sum;
+      sum.Fill( NumericTraits< double >::Zero );
+      double sumc = 0.0;
+      for( unsigned int i = 0; i < neighborhoodSize; ++i )
+      {
+        const double         ci  = nit2.GetPixel( i );
+        const InputPixelType pix = nit.GetPixel( i );
+        sumc += ci;
+        for( unsigned int j = 0; j < InputImageDimension; j++ )
         {
-          if( sumc < 0.00001 ) { mean[ j ] = 0.0; }
-          else { mean[ j ] = static_cast< ValueType >( sum[ j ] / sumc ); }
+          sum[ j ] += ci * static_cast< double >( pix[ j ] );
         }
+      }
 
-        /** Get c. */
-        c = nit2.GetCenterPixel();
-
-        /** Set 'y = (1 - c) * x + c * mean' to the temporary output. */
-        InputPixelType value = nit.GetCenterPixel() * ( 1.0 - c ) + mean * c;
-
-        /** Set it. */
-        oit.Set( value );
-
-      } // end if c < 0.000001
-
-      /** Increase all iterators. */
-      ++nit;
-      ++nit2;
-      ++oit;
-      //progress.CompletedPixel();
-
-    } // end while
-
-    /** Copy outputtmp to output. */
-    if( this->GetNumberOfIterations() > 0 )
-    {
-      out_it.GoToBegin();
-      oit.GoToBegin();
-      while( !out_it.IsAtEnd() )
+      /** Get the mean value by dividing by sumc. */
+      InputPixelType mean;
+      for( unsigned int j = 0; j < InputImageDimension; j++ )
       {
-        out_it.Set( oit.Get() );
-        ++out_it;
-        ++oit;
+        if( sumc < 0.00001 ) { mean[ j ] = 0.0; }
+        else { mean[ j ] = static_cast< ValueType >( sum[ j ] / sumc ); }
       }
-    } // end if GetNumberOfIterations() > 0
 
-  } // end for NumberOfIterations
+      /** Set 'y = (1 - c) * x + c * mean' to the destination. */
+      oit.Set( nit.GetCenterPixel() * ( 1.0 - c ) + mean * c );
+    }
+  }
 
-} // end GenerateData()
+} // end DiffuseOnce()
 
 
 /**
@@ -353,16 +330,18 @@ VectorMeanDiffusionImageFilter< TInputImage, TGrayValueImage >
    * a double image. No thresholding is performed.
    */
 
-  /** Create this->m_Cx. */
-  this->m_Cx = DoubleImageType::New();
-
   /** Rescale intensity of this->m_GrayValueImage to values between
-   * 0.0 and 1.0.
+   * 0.0 and 1.0. The filter is kept between calls, so that its output
+   * buffer is reused.
    */
-  this->m_RescaleFilter = RescaleImageFilterType::New();
-  this->m_RescaleFilter->SetOutputMinimum( 0.000001 );
-  this->m_RescaleFilter->SetOutputMaximum( 0.999999 );
+  if( this->m_RescaleFilter.IsNull() )
+  {
+    this->m_RescaleFilter = RescaleImageFilterType::New();
+    this->m_RescaleFilter->SetOutputMinimum( 0.000001 );
+    this->m_RescaleFilter->SetOutputMaximum( 0.999999 );
+  }
   this->m_RescaleFilter->SetInput( this->m_GrayValueImage );
+  this->m_RescaleFilter->Modified();
 
   /** First set this->m_Cx = rescaleFilter->GetOutput(). */
   this->m_Cx = this->m_RescaleFilter->GetOutput();
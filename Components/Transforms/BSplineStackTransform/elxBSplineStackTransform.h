@@ -23,7 +23,7 @@
 /** Include itk transforms needed. */
 #include "itkAdvancedCombinationTransform.h"
 #include "itkAdvancedBSplineDeformableTransform.h"
-#include "itkStackTransform.h"
+#include "itkBSplineStackTransform.h"
 
 /** Include grid schedule computer and upsample filter. */
 #include "itkGridScheduleComputer.h"
@@ -159,9 +159,8 @@ public:
   typedef typename ReducedDimensionBSplineTransformBaseType::Pointer ReducedDimensionBSplineTransformBasePointer;
 
   /** Typedef for stack transform. */
-  typedef itk::StackTransform<
+  typedef itk::BSplineStackTransform<
     typename elx::TransformBase< TElastix >::CoordRepType,
-    itkGetStaticConstMacro( SpaceDimension ),
     itkGetStaticConstMacro( SpaceDimension ) >            BSplineStackTransformType;
   typedef typename BSplineStackTransformType::Pointer BSplineStackTransformPointer;
 
@@ -30,6 +30,11 @@ namespace itk
  *
  * Detailed explanation ...
  *
+ * The normal transform and the label transforms share the same B-spline
+ * grid. For each label, a fused transform with the summed coefficients is
+ * maintained, so that evaluating a point requires a single B-spline
+ * evaluation, and the interpolation weights are computed only once.
+ *
  * \author Vivien Delmon
  *
  * \ingroup Transforms
@@ -489,6 +494,14 @@ protected:
   ImageVectorPointer                             m_LabelsNormals;
   std::vector< typename TransformType::Pointer > m_Trans;
   std::vector< ParametersType >                  m_Para;
+
+  /** For each label l, a B-spline transform with the summed coefficients
+   * of m_Trans[ 0 ] and m_Trans[ l ]. Since all transforms share the grid,
+   * this evaluates the displacement (and its spatial derivatives) of a
+   * point in label l with a single B-spline evaluation. Index 0 is unused.
+   */
+  std::vector< typename TransformType::Pointer > m_FusedTrans;
+  std::vector< ParametersType >                  m_FusedPara;
   mutable int                                    m_LastJacobian;
   ImageBasePointer                               m_LocalBases;
 
@@ -45,6 +45,8 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
   // keep transform 0 to store parameters that are not kept here (GridSize, ...)
   this->m_Trans[ 0 ] = TransformType::New();
   this->m_Para.resize( 0 );
+  this->m_FusedTrans.resize( 0 );
+  this->m_FusedPara.resize( 0 );
   this->m_LastJacobian = -1;
   this->m_LocalBases   = ImageBaseType::New();
 
@@ -100,6 +102,10 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
   for( unsigned i = 0; i <= m_NbLabels; ++i ) \
   { \
     m_Trans[ i ]->FUNC( ARGS ); \
+  } \
+  for( unsigned i = 1; i < m_FusedTrans.size(); ++i ) \
+  { \
+    m_FusedTrans[ i ]->FUNC( ARGS ); \
   }
 
 #define SET_ALL_LABELS( FUNC, TYPE ) \
@@ -168,10 +174,16 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
     this->m_NbLabels = stat->GetMaximum() + 1;
     this->m_Trans.resize( this->m_NbLabels + 1 );
     this->m_Para.resize( this->m_NbLabels + 1 );
+    this->m_FusedTrans.resize( this->m_NbLabels + 1 );
+    this->m_FusedPara.resize( this->m_NbLabels + 1 );
     for( unsigned i = 0; i <= this->m_NbLabels; ++i )
     {
       this->m_Trans[ i ] = TransformType::New();
     }
+    for( unsigned i = 1; i <= this->m_NbLabels; ++i )
+    {
+      this->m_FusedTrans[ i ] = TransformType::New();
+    }
     this->m_LabelsInterpolator = ImageLabelInterpolator::New();
     this->m_LabelsInterpolator->SetInputImage( this->m_Labels );
     // Restore settings
@@ -527,6 +539,15 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
   {
     m_Trans[ i ]->SetParameters( m_Para[ i ] );
   }
+
+  // The normal and label transforms share the B-spline grid, so their sum
+  // is again a B-spline transform, with summed coefficients. Evaluating
+  // this fused transform costs a single B-spline evaluation per point.
+  for( unsigned l = 1; l <= m_NbLabels; ++l )
+  {
+    m_FusedPara[ l ] = m_Para[ 0 ] + m_Para[ l ];
+    m_FusedTrans[ l ]->SetParameters( m_FusedPara[ l ] );
+  }
 }
 
 
@@ -682,8 +703,7 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
     return point;
   }
 
-  OutputPointType res = m_Trans[ 0 ]->TransformPoint( point ) + ( m_Trans[ lidx ]->TransformPoint( point ) - point );
-  return res;
+  return m_FusedTrans[ lidx ]->TransformPoint( point );
 }
 
 
@@ -752,50 +772,48 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
     return;
   }
 
-  JacobianType njac, ljac;
-  njac.SetSize( SpaceDimension, nnzji );
-  ljac.SetSize( SpaceDimension, nnzji );
-
-  // nzji should be the same so keep only one
-  m_Trans[ 0 ]->GetJacobian( ipp, njac, nonZeroJacobianIndices );
-  m_Trans[ lidx ]->GetJacobian( ipp, ljac, nonZeroJacobianIndices );
-
-  // Convert the physical point to a continuous index, which
-  // is needed for the 'Evaluate()' functions below.
+  // The normal and label transforms share the B-spline grid, so their
+  // interpolation weights and support region are equal: compute them once.
   typename TransformType::ContinuousIndexType cindex;
-  m_Trans[ lidx ]->TransformPointToContinuousGridIndex( ipp, cindex );
+  m_Trans[ 0 ]->TransformPointToContinuousGridIndex( ipp, cindex );
 
   // NOTE: if the support region does not lie totally within the grid
   // we assume zero displacement and zero Jacobian
-  if( !m_Trans[ lidx ]->InsideValidRegion( cindex ) )
+  if( !m_Trans[ 0 ]->InsideValidRegion( cindex ) )
   {
     // Return some dummy
-    nonZeroJacobianIndices.resize( m_Trans[ lidx ]->GetNumberOfNonZeroJacobianIndices() );
-    for( unsigned int i = 0; i < m_Trans[ lidx ]->GetNumberOfNonZeroJacobianIndices(); ++i )
+    nonZeroJacobianIndices.resize( m_Trans[ 0 ]->GetNumberOfNonZeroJacobianIndices() );
+    for( unsigned int i = 0; i < m_Trans[ 0 ]->GetNumberOfNonZeroJacobianIndices(); ++i )
     {
       nonZeroJacobianIndices[ i ] = i;
     }
     return;
   }
 
+  const unsigned nweights = this->GetNumberOfWeights();
+  typename WeightsType::ValueType weightsArray[ WeightsFunctionType::NumberOfWeights ];
+  WeightsType weights( weightsArray, nweights, false );
+
+  IndexType supportIndex;
+  m_Trans[ 0 ]->m_WeightsFunction->ComputeStartIndex( cindex, supportIndex );
+  m_Trans[ 0 ]->m_WeightsFunction->Evaluate( cindex, supportIndex, weights );
+
+  RegionType supportRegion;
+  supportRegion.SetSize( m_Trans[ 0 ]->m_SupportSize );
+  supportRegion.SetIndex( supportIndex );
+  m_Trans[ 0 ]->ComputeNonZeroJacobianIndices( nonZeroJacobianIndices, supportRegion );
+
   typedef typename ImageBaseType::PixelContainer BaseContainer;
   const BaseContainer & bases = *m_LocalBases->GetPixelContainer();
 
-  const unsigned nweights = this->GetNumberOfWeights();
   for( unsigned i = 0; i < nweights; ++i )
   {
-    VectorType tmp = bases[ nonZeroJacobianIndices[ i ] ][ 0 ];
-    for( unsigned j = 0; j < SpaceDimension; ++j )
-    {
-      jacobian[ j ][ i ] = tmp[ j ] * njac[ j ][ i + j * nweights ];
-    }
-
-    for( unsigned d = 1; d < SpaceDimension; ++d )
+    const BaseType & base = bases[ nonZeroJacobianIndices[ i ] ];
+    for( unsigned d = 0; d < SpaceDimension; ++d )
     {
-      tmp = bases[ nonZeroJacobianIndices[ i ] ][ d ];
       for( unsigned j = 0; j < SpaceDimension; ++j )
       {
-        jacobian[ j ][ i + d * nweights ] = tmp[ j ] * ljac[ j ][ i + j * nweights ];
+        jacobian[ j ][ i + d * nweights ] = base[ d ][ j ] * weights[ i ];
       }
     }
   }
@@ -841,10 +859,7 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
     sj.SetIdentity();
     return;
   }
-  SpatialJacobianType nsj;
-  m_Trans[ 0 ]->GetSpatialJacobian( ipp, nsj );
-  m_Trans[ lidx ]->GetSpatialJacobian( ipp, sj );
-  sj += nsj;
+  m_FusedTrans[ lidx ]->GetSpatialJacobian( ipp, sj );
 }
 
 
@@ -881,19 +896,7 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
     return;
   }
 
-  SpatialHessianType nsh, lsh;
-  m_Trans[ 0 ]->GetSpatialHessian( ipp, nsh );
-  m_Trans[ lidx ]->GetSpatialHessian( ipp, lsh );
-  for( unsigned i = 0; i < SpaceDimension; ++i )
-  {
-    for( unsigned j = 0; j < SpaceDimension; ++j )
-    {
-      for( unsigned k = 0; k < SpaceDimension; ++k )
-      {
-        sh[ i ][ j ][ k ] = lsh[ i ][ j ][ k ] + nsh[ i ][ j ][ k ];
-      }
-    }
-  }
+  m_FusedTrans[ lidx ]->GetSpatialHessian( ipp, sh );
 }
 
 
@@ -961,12 +964,11 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
     return;
   }
 
-  SpatialJacobianType           nsj, lsj;
-  JacobianOfSpatialJacobianType njsj, ljsj;
-
-  // nzji should be the same so keep only one
-  m_Trans[ 0 ]->GetJacobianOfSpatialJacobian( ipp, nsj, njsj, nonZeroJacobianIndices );
-  m_Trans[ lidx ]->GetJacobianOfSpatialJacobian( ipp, lsj, ljsj, nonZeroJacobianIndices );
+  // The Jacobian of the spatial Jacobian of a B-spline transform does not
+  // depend on its coefficients, so a single evaluation on the fused transform
+  // yields both the summed spatial Jacobian and the shared jsj.
+  JacobianOfSpatialJacobianType fjsj;
+  m_FusedTrans[ lidx ]->GetJacobianOfSpatialJacobian( ipp, sj, fjsj, nonZeroJacobianIndices );
 
   typedef typename ImageBaseType::PixelContainer BaseContainer;
   const BaseContainer & bases = *m_LocalBases->GetPixelContainer();
@@ -974,27 +976,18 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
   const unsigned nweights = this->GetNumberOfWeights();
   for( unsigned i = 0; i < nweights; ++i )
   {
-    VectorType tmp = bases[ nonZeroJacobianIndices[ i ] ][ 0 ];
-    for( unsigned j = 0; j < SpaceDimension; ++j )
+    const BaseType & base = bases[ nonZeroJacobianIndices[ i ] ];
+    for( unsigned d = 0; d < SpaceDimension; ++d )
     {
-      for( unsigned k = 0; k < SpaceDimension; ++k )
-      {
-        jsj[ j ][ i ][ k ] = tmp[ j ] * njsj[ j ][ i + j * nweights ][ k ];
-      }
-    }
-
-    for( unsigned d = 1; d < SpaceDimension; ++d )
-    {
-      tmp = bases[ nonZeroJacobianIndices[ i ] ][ d ];
+      SpatialJacobianType & jsjd = jsj[ i + d * nweights ];
       for( unsigned j = 0; j < SpaceDimension; ++j )
       {
         for( unsigned k = 0; k < SpaceDimension; ++k )
         {
-          jsj[ j ][ i + d * nweights ][ k ] = tmp[ j ] * ljsj[ j ][ i + j * nweights ][ k ];
+          jsjd[ j ][ k ] = base[ d ][ j ] * fjsj[ i + j * nweights ][ j ][ k ];
         }
       }
     }
-    sj = nsj + lsj;
   }
 
   // move non zero indices to match label positions
@@ -1070,12 +1063,10 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
     return;
   }
 
-  SpatialHessianType           nsh, lsh;
-  JacobianOfSpatialHessianType njsh, ljsh;
-
-  // nzji should be the same so keep only one
-  m_Trans[ 0 ]->GetJacobianOfSpatialHessian( ipp, nsh, njsh, nonZeroJacobianIndices );
-  m_Trans[ lidx ]->GetJacobianOfSpatialHessian( ipp, lsh, ljsh, nonZeroJacobianIndices );
+  // As for the Jacobian of the spatial Jacobian, a single evaluation on the
+  // fused transform yields both the summed spatial Hessian and the shared jsh.
+  JacobianOfSpatialHessianType fjsh;
+  m_FusedTrans[ lidx ]->GetJacobianOfSpatialHessian( ipp, sh, fjsh, nonZeroJacobianIndices );
 
   typedef typename ImageBaseType::PixelContainer BaseContainer;
   const BaseContainer & bases = *m_LocalBases->GetPixelContainer();
@@ -1083,41 +1074,13 @@ MultiBSplineDeformableTransformWithNormal< TScalarType, NDimensions, VSplineOrde
   const unsigned nweights = this->GetNumberOfWeights();
   for( unsigned i = 0; i < nweights; ++i )
   {
-    VectorType tmp = bases[ nonZeroJacobianIndices[ i ] ][ 0 ];
-    for( unsigned j = 0; j < SpaceDimension; ++j )
+    const BaseType & base = bases[ nonZeroJacobianIndices[ i ] ];
+    for( unsigned d = 0; d < SpaceDimension; ++d )
     {
-      for( unsigned k = 0; k < SpaceDimension; ++k )
-      {
-        for( unsigned l = 0; l < SpaceDimension; ++l )
-        {
-          jsh[ j ][ i ][ k ][ l ] = tmp[ j ] * njsh[ j ][ i + j * nweights ][ k ][ l ];
-        }
-      }
-    }
-
-    for( unsigned l = 1; l <= m_NbLabels; ++l )
-    {
-      VectorType tmp = bases[ nonZeroJacobianIndices[ i ] ][ l ];
+      SpatialHessianType & jshd = jsh[ i + d * nweights ];
       for( unsigned j = 0; j < SpaceDimension; ++j )
       {
-        for( unsigned k = 0; k < SpaceDimension; ++k )
-        {
-          for( unsigned l = 0; l < SpaceDimension; ++l )
-          {
-            jsh[ j ][ i + l * nweights ][ k ][ l ] = tmp[ j ] * ljsh[ j ][ i + j * nweights ][ k ][ l ];
-          }
-        }
-      }
-    }
-  }
-
-  for( unsigned i = 0; i < SpaceDimension; ++i )
-  {
-    for( unsigned j = 0; j < SpaceDimension; ++j )
-    {
-      for( unsigned k = 0; k < SpaceDimension; ++k )
-      {
-        sh[ i ][ j ][ k ] = lsh[ i ][ j ][ k ] + nsh[ i ][ j ][ k ];
+        jshd[ j ] = fjsh[ i + j * nweights ][ j ] * base[ d ][ j ];
       }
     }
   }
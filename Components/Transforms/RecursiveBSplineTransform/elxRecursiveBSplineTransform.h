@@ -76,6 +76,16 @@ namespace elastix
  *   <em>Nonrigid registration of dynamic medical imaging data using nD+t B-splines and a
  *   groupwise optimization approach</em>, C.T. Metz, S. Klein, M. Schaap, T. van Walsum and
  *   W.J. Niessen, Medical Image Analysis, in press.
+ * \parameter BSplineTransformUseFloatCoefficients: evaluate the displacement using a
+ *   single precision copy of the B-spline coefficients. This reduces the memory traffic
+ *   of transforming points on large grids, at the cost of a small loss of accuracy.
+ *   Only TransformPoint() uses the single precision copy; the transform parameters,
+ *   the Jacobian and the spatial derivatives remain double precision.
+ *   Every iteration copies all coefficients to single precision, which usually costs
+ *   more than it saves; time it with the BSplineTransformPointPerformanceTest before
+ *   switching it on. \n
+ *   example: <tt>(BSplineTransformUseFloatCoefficients "true")</tt> \n
+ *   Default: "false".
  *
  *
  * The transform parameters necessary for transformix, additionally defined by this class, are:
@@ -99,6 +109,10 @@ namespace elastix
  *   <em>Nonrigid registration of dynamic medical imaging data using nD+t B-splines and a
  *   groupwise optimization approach</em>, C.T. Metz, S. Klein, M. Schaap, T. van Walsum and
  *   W.J. Niessen, Medical Image Analysis, in press.
+ * \transformparameter BSplineTransformUseFloatCoefficients: stores whether the displacement
+ *   is evaluated using a single precision copy of the B-spline coefficients. \n
+ *    example: <tt>(BSplineTransformUseFloatCoefficients "false")</tt>
+ *    Default value: "false".
  *
  * \todo It is unsure what happens when one of the image dimensions has length 1.
  *
@@ -307,9 +321,12 @@ private:
   GridScheduleComputerPointer m_GridScheduleComputer;
   GridUpsamplerPointer        m_GridUpsampler;
 
-  /** Variables to remember order and periodicity of B-spline transform. */
+  /** Variables to remember order, periodicity and coefficient precision
+   * of B-spline transform.
+   */
   unsigned int m_SplineOrder;
   bool         m_Cyclic;
+  bool         m_UseFloatCoefficients;
 
   /** Initialize the right B-spline transform based on the spline order and periodicity. */
   unsigned int InitializeBSplineTransform();
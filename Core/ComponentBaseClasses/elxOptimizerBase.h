@@ -44,6 +44,20 @@ namespace elastix
  *    Choose one from {"true", "false"} for every resolution.\n
  *    example: <tt>(NewSamplesEveryIteration "true" "true" "true")</tt> \n
  *    Default is "false" for every resolution.\n
+ * \parameter NumberOfStartingPoints: the number of starting points of a
+ *    multi-start optimization. The optimization is repeated from each starting
+ *    point and the result with the lowest metric value is kept. Only used by
+ *    optimizers that support it (Powell, Simplex, ConjugateGradientFRPR).
+ *    The starts run one after another, so the optimization takes about
+ *    NumberOfStartingPoints times as long; only the metric evaluations within
+ *    each start are multi-threaded.\n
+ *    example: <tt>(NumberOfStartingPoints 5 3 1)</tt> \n
+ *    Default is 1 for every resolution.\n
+ * \parameter StartingPointRadius: the distance, in scaled parameter units,
+ *    between the initial position and the additional starting points of a
+ *    multi-start optimization.\n
+ *    example: <tt>(StartingPointRadius 2.0 1.0 0.5)</tt> \n
+ *    Default is 1.0 for every resolution.\n
  *
  * \ingroup Optimizers
  * \ingroup ComponentBaseClasses
@@ -123,6 +137,32 @@ protected:
   /** Check whether the user asked to select new samples every iteration. */
   virtual bool GetNewSamplesEveryIteration( void ) const;
 
+  /** Get the number of starting points of a multi-start optimization. */
+  virtual unsigned int GetNumberOfStartingPoints( void ) const;
+
+  /** Compute the k-th starting point of a multi-start optimization.
+   * Starting point 0 is the initial position itself. The others are
+   * displaced from it along the parameter axes, alternately in positive
+   * and negative direction, by a multiple of the StartingPointRadius
+   * divided by the parameter scale.
+   */
+  virtual void ComputeStartingPoint( const ParametersType & initialPosition,
+    unsigned int k, ParametersType & startingPoint ) const;
+
+  /** Run a multi-start optimization: for each starting point in turn, set
+   * it as the initial position and call StartSingleOptimization(). The
+   * starts are serial, since they all run this optimizer object. Returns the
+   * final position with the lowest final metric value. The initial
+   * position is restored afterwards.
+   */
+  virtual ParametersType StartMultiStartOptimization( void );
+
+  /** Run the optimizer once from its initial position, and return its
+   * final metric value. Optimizers that support a multi-start optimization
+   * implement this; the default throws an exception.
+   */
+  virtual double StartSingleOptimization( void );
+
 private:
 
   /** The private constructor. */
@@ -135,6 +175,10 @@ private:
    */
   bool m_NewSamplesEveryIteration;
 
+  /** Member variables to store the multi-start settings. */
+  unsigned int m_NumberOfStartingPoints;
+  double       m_StartingPointRadius;
+
 };
 
 } // end namespace elastix
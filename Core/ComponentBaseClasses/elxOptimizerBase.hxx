@@ -35,6 +35,8 @@ OptimizerBase< TElastix >
 ::OptimizerBase()
 {
   this->m_NewSamplesEveryIteration = false;
+  this->m_NumberOfStartingPoints   = 1;
+  this->m_StartingPointRadius      = 1.0;
 
 } // end Constructor
 
@@ -79,6 +81,14 @@ OptimizerBase< TElastix >
   this->GetConfiguration()->ReadParameter( this->m_NewSamplesEveryIteration,
     "NewSamplesEveryIteration", this->GetComponentLabel(), level, 0 );
 
+  /** Read the multi-start settings. */
+  this->m_NumberOfStartingPoints = 1;
+  this->GetConfiguration()->ReadParameter( this->m_NumberOfStartingPoints,
+    "NumberOfStartingPoints", this->GetComponentLabel(), level, 0 );
+  this->m_StartingPointRadius = 1.0;
+  this->GetConfiguration()->ReadParameter( this->m_StartingPointRadius,
+    "StartingPointRadius", this->GetComponentLabel(), level, 0 );
+
 } // end BeforeEachResolutionBase()
 
 
@@ -151,6 +161,112 @@ OptimizerBase< TElastix >
 } // end GetNewSamplesEveryIteration()
 
 
+/**
+ * ****************** GetNumberOfStartingPoints ********************
+ */
+
+template< class TElastix >
+unsigned int
+OptimizerBase< TElastix >
+::GetNumberOfStartingPoints( void ) const
+{
+  return this->m_NumberOfStartingPoints;
+
+} // end GetNumberOfStartingPoints()
+
+
+/**
+ * ****************** ComputeStartingPoint ********************
+ */
+
+template< class TElastix >
+void
+OptimizerBase< TElastix >
+::ComputeStartingPoint( const ParametersType & initialPosition,
+  unsigned int k, ParametersType & startingPoint ) const
+{
+  typedef typename ITKBaseType::ScalesType ScalesType;
+
+  startingPoint = initialPosition;
+  const unsigned int numberOfParameters = initialPosition.GetSize();
+  if( k == 0 || numberOfParameters == 0 )
+  {
+    return;
+  }
+
+  /** Starting points 1 and 2 are displaced along the first axis,
+   * 3 and 4 along the second, etc. After all axes have been visited,
+   * the displacement grows by another radius.
+   */
+  const unsigned int j    = ( k - 1 ) / 2;
+  const unsigned int axis = j % numberOfParameters;
+  const double       sign = ( k % 2 == 1 ) ? 1.0 : -1.0;
+  double             step = sign * this->m_StartingPointRadius
+    * static_cast< double >( j / numberOfParameters + 1 );
+
+  const ScalesType & scales = this->GetAsITKBaseType()->GetScales();
+  if( scales.GetSize() == numberOfParameters && scales[ axis ] > 0.0 )
+  {
+    step /= scales[ axis ];
+  }
+  startingPoint[ axis ] += step;
+
+} // end ComputeStartingPoint()
+
+
+/**
+ * ****************** StartMultiStartOptimization ********************
+ */
+
+template< class TElastix >
+typename OptimizerBase< TElastix >::ParametersType
+OptimizerBase< TElastix >
+::StartMultiStartOptimization( void )
+{
+  ITKBaseType *        optimizer       = this->GetAsITKBaseType();
+  const ParametersType initialPosition = optimizer->GetInitialPosition();
+  ParametersType       startingPoint;
+  ParametersType       bestPosition;
+  double               bestValue = 0.0;
+
+  for( unsigned int k = 0; k < this->m_NumberOfStartingPoints; ++k )
+  {
+    this->ComputeStartingPoint( initialPosition, k, startingPoint );
+    optimizer->SetInitialPosition( startingPoint );
+    const double value = this->StartSingleOptimization();
+    elxout << "Starting point " << k << ": final metric value = " << value << std::endl;
+
+    if( k == 0 || value < bestValue )
+    {
+      bestValue    = value;
+      bestPosition = optimizer->GetCurrentPosition();
+    }
+  }
+
+  /** Restore the initial position. */
+  optimizer->SetInitialPosition( initialPosition );
+  return bestPosition;
+
+} // end StartMultiStartOptimization()
+
+
+/**
+ * ****************** StartSingleOptimization ********************
+ */
+
+template< class TElastix >
+double
+OptimizerBase< TElastix >
+::StartSingleOptimization( void )
+{
+  /** Throw an exception if this function is not overridden. */
+  itkExceptionMacro( << "ERROR: The NumberOfStartingPoints parameter is not "
+                     << "supported by your optimizer" );
+  return 0.0;
+
+} // end StartSingleOptimization()
+
+
 /**
  * ****************** SetSinusScales ********************
  */
@@ -99,6 +99,26 @@ namespace elastix
  * The number of entries is stored the NumberOfParameters entry.
  * \transformparameter NumberOfParameters: the length of the transform parameter vector.\n
  * example <tt>(NumberOfParameters 722)</tt>\n
+ * \transformparameter MaximumStreamingMemory: The maximum amount of memory, in megabytes,
+ * used for the dense outputs of transformix (the deformation field of "-def all" and the
+ * spatial Jacobian images of "-jac" and "-jacmat").
+ * If the full output image would need more memory, it is generated and written in consecutive
+ * chunks. This requires a file format that supports streamed writing, such as mhd or nrrd.\n
+ * example <tt>(MaximumStreamingMemory 512)</tt>\n
+ * Default: 0, which means that the full output image is generated in memory.
+ * \transformparameter InverseTransformTolerance: The tolerance, in physical units, on
+ * the distance between T(x) and the point y that is inverted by "-definv".\n
+ * example <tt>(InverseTransformTolerance 0.001)</tt>\n
+ * Default: 0.0001.
+ * \transformparameter InverseTransformMaximumNumberOfIterations: The maximum number of
+ * Newton iterations per point for "-definv".\n
+ * example <tt>(InverseTransformMaximumNumberOfIterations 100)</tt>\n
+ * Default: 50.
+ * \transformparameter InverseTransformSeedGridShrinkFactor: The inverse is first computed
+ * on a coarse grid, which is the fixed image domain shrunken by this factor. These results
+ * are the initial guesses for the points of "-definv".\n
+ * example <tt>(InverseTransformSeedGridShrinkFactor 8)</tt>\n
+ * Default: 4.
  * \transformparameter InitialTransformParametersFileName: The location/name of an initial
  * transform that will be loaded when loading the current transform parameter file. Note
  * that transform parameter file can also contain an initial transform. Recursively all
@@ -119,9 +139,21 @@ namespace elastix
  *    "point", depending if the user supplies voxel indices or real world coordinates.
  *    The second line should be the number of points that should be transformed. The
  *    third and following lines give the indices or points.\n
+ *    Large point sets may also be given as a binary file with extension ".bin", containing
+ *    the world coordinates of all points as consecutive doubles (x y z x y z ...) in the
+ *    native byte order. The transformed points are then written to outputpoints.bin in
+ *    the same format.\n
+ *    example: <tt>-def inputPoints.bin</tt> \n
  *    It is also possible to deform all points, thereby generating a deformation field
  *    image. This is done by:\n
  *    example: <tt>-def all</tt> \n
+ * \commandlinearg -definv: optional argument for transformix for specifying a set of
+ *    moving image points that have to be mapped to the fixed image, by inverting the transform
+ *    iteratively per point. The input point file has the same format as for "-def"; input
+ *    given as indices is converted with the geometry of the moving image ("-in"), which is then
+ *    required. The result is written to inverseoutputpoints.txt. With <tt>-definv all</tt> the inverse deformation
+ *    field is generated on the fixed image domain.\n
+ *    example: <tt>-definv inputPoints.txt</tt> \n
  *
  * \ingroup Transforms
  * \ingroup ComponentBaseClasses
@@ -298,6 +330,9 @@ public:
   /** Function to transform coordinates from fixed to moving image, given as VTK file. */
   virtual void TransformPointsSomePointsVTK( const std::string filename ) const;
 
+  /** Function to transform coordinates from fixed to moving image, given as binary file. */
+  virtual void TransformPointsSomePointsBinary( const std::string filename ) const;
+
   /** Deprecation note: The plan is to split all Compute* and TransformPoints* functions
    *  into Generate* and Write* functions, since that would facilitate a proper library
    *  interface. To keep everything functional during the transition period we need to
@@ -309,9 +344,19 @@ public:
 
   void WriteDeformationFieldImage( typename DeformationFieldImageType::Pointer ) const;
 
+  /** Generate the deformation field and write it to file in consecutive chunks,
+   * so that the full field is never held in memory.
+   */
+  void WriteDeformationFieldImageStreamed( const unsigned int numberOfStreamDivisions ) const;
+
   /** Legacy function that calls GenerateDeformationFieldImage and WriteDeformationFieldImage. */
   virtual void TransformPointsAllPoints(void) const;
 
+  /** Function to transform coordinates from moving to fixed image, by
+   * inverting the transform iteratively.
+   */
+  virtual void TransformPointsInverse( void ) const;
+
   /** Function to compute the determinant of the spatial Jacobian. */
   virtual void ComputeDeterminantOfSpatialJacobian( void ) const;
 
@@ -348,6 +393,12 @@ protected:
   void AutomaticScalesEstimationStackTransform(
     const unsigned int & numSubTransforms, ScalesType & scales ) const;
 
+  /** Determine the number of stream divisions needed to keep a dense output
+   * image with the given number of bytes per pixel within the memory budget
+   * set by the MaximumStreamingMemory parameter.
+   */
+  unsigned int GetNumberOfStreamDivisions( const std::size_t numberOfBytesPerPixel ) const;
+
   /** Member variables. */
   ParametersType * m_TransformParametersPointer;
   std::string      m_TransformParametersFileName;
@@ -29,6 +29,7 @@
 #include "itkTransformToDisplacementFieldFilter.h"
 #include "itkTransformToDeterminantOfSpatialJacobianSource.h"
 #include "itkTransformToSpatialJacobianSource.h"
+#include "itkAdvancedTransformInverter.h"
 #include "itkImageFileWriter.h"
 #include "itkImageGridSampler.h"
 #include "itkContinuousIndex.h"
@@ -1100,6 +1101,13 @@ TransformBase< TElastix >
              << "specified in a VTK input point file." << std::endl;
       this->TransformPointsSomePointsVTK( def );
     }
+    else if( itksys::SystemTools::StringEndsWith( def.c_str(), ".bin" )
+      || itksys::SystemTools::StringEndsWith( def.c_str(), ".BIN" ) )
+    {
+      elxout << "  The transform is evaluated on some points, "
+             << "specified in a binary input point file." << std::endl;
+      this->TransformPointsSomePointsBinary( def );
+    }
     else
     {
       elxout << "  The transform is evaluated on some points, "
@@ -1276,9 +1284,15 @@ TransformBase< TElastix >
     }
   }
 
-  /** Apply the transform. */
+  /** Apply the transform. TransformPoint() is thread-safe, and all
+   * other computations per point are independent.
+   */
   elxout << "  The input points are transformed." << std::endl;
-  for( unsigned int j = 0; j < nrofpoints; j++ )
+  const int numberOfPoints = static_cast< int >( nrofpoints );
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for private( fixedcindex, movingcindex )
+#endif
+  for( int j = 0; j < numberOfPoints; j++ )
   {
     /** Call TransformPoint. */
     outputpointvec[ j ] = this->GetAsITKBaseType()->TransformPoint( inputpointvec[ j ] );
@@ -1317,7 +1331,9 @@ TransformBase< TElastix >
   elxout << "  The transformed points are saved in: "
          <<  outputPointsFileName << std::endl;
 
-  /** Print the results. */
+  /** Print the results. Lines are ended with a newline instead of
+   * std::endl, so that the file stream is not flushed for every point.
+   */
   for( unsigned int j = 0; j < nrofpoints; j++ )
   {
     /** The input index. */
@@ -1365,7 +1381,7 @@ TransformBase< TElastix >
       }
     }
 
-    outputPointsFile << "]" << std::endl;
+    outputPointsFile << "]\n";
   } // end for nrofpoints
 
 } // end TransformPointsSomePoints()
@@ -1457,6 +1473,328 @@ TransformBase< TElastix >
 } // end TransformPointsSomePointsVTK()
 
 
+/**
+ * ************** TransformPointsSomePointsBinary *********************
+ *
+ * This function reads points from a binary file and transforms
+ * these fixed-image coordinates to moving-image coordinates.
+ *
+ * The file contains the world coordinates of all points as consecutive
+ * doubles, in the native byte order. The transformed points are saved
+ * in the same format as outputpoints.bin.
+ */
+
+template< class TElastix >
+void
+TransformBase< TElastix >
+::TransformPointsSomePointsBinary( const std::string filename ) const
+{
+  /** Open the input point file. */
+  elxout << "  Reading input point file: " << filename << std::endl;
+  std::ifstream inputPointsFile( filename.c_str(), std::ios::in | std::ios::binary );
+  if( !inputPointsFile.is_open() )
+  {
+    xl::xout[ "error" ] << "  Error while opening input point file." << std::endl;
+    return;
+  }
+
+  /** Determine the number of points from the file size. */
+  inputPointsFile.seekg( 0, std::ios::end );
+  const std::streamoff fileSize = inputPointsFile.tellg();
+  inputPointsFile.seekg( 0, std::ios::beg );
+  const std::size_t pointSize = FixedImageDimension * sizeof( double );
+  if( fileSize % pointSize != 0 )
+  {
+    xl::xout[ "error" ] << "  Error: the size of the binary input point file is not a "
+                        << "multiple of the size of a " << FixedImageDimension
+                        << "D point of doubles." << std::endl;
+    return;
+  }
+  const std::size_t nrofpoints = static_cast< std::size_t >( fileSize / pointSize );
+
+  /** Some user-feedback. */
+  elxout << "  Input points are specified in world coordinates." << std::endl;
+  elxout << "  Number of specified input points: " << nrofpoints << std::endl;
+
+  /** Read all coordinates at once. */
+  std::vector< double > coordinates( nrofpoints * FixedImageDimension );
+  if( nrofpoints > 0 )
+  {
+    inputPointsFile.read( reinterpret_cast< char * >( &coordinates[ 0 ] ), fileSize );
+  }
+  if( !inputPointsFile )
+  {
+    xl::xout[ "error" ] << "  Error while reading input point file." << std::endl;
+    return;
+  }
+
+  /** Apply the transform, in place. */
+  elxout << "  The input points are transformed." << std::endl;
+  const int numberOfPoints = static_cast< int >( nrofpoints );
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for
+#endif
+  for( int j = 0; j < numberOfPoints; j++ )
+  {
+    double *       coordinate = &coordinates[ j * FixedImageDimension ];
+    InputPointType inputPoint;
+    for( unsigned int i = 0; i < FixedImageDimension; i++ )
+    {
+      inputPoint[ i ] = coordinate[ i ];
+    }
+
+    const OutputPointType outputPoint = this->GetAsITKBaseType()->TransformPoint( inputPoint );
+    for( unsigned int i = 0; i < MovingImageDimension; i++ )
+    {
+      coordinate[ i ] = outputPoint[ i ];
+    }
+  }
+
+  /** Create filename and write the results. */
+  std::string outputPointsFileName = this->m_Configuration
+    ->GetCommandLineArgument( "-out" );
+  outputPointsFileName += "outputpoints.bin";
+  elxout << "  The transformed points are saved in: "
+         <<  outputPointsFileName << std::endl;
+  std::ofstream outputPointsFile( outputPointsFileName.c_str(),
+    std::ios::out | std::ios::binary );
+  if( nrofpoints > 0 )
+  {
+    outputPointsFile.write( reinterpret_cast< const char * >( &coordinates[ 0 ] ), fileSize );
+  }
+  if( !outputPointsFile )
+  {
+    xl::xout[ "error" ] << "  Error while saving points." << std::endl;
+  }
+
+} // end TransformPointsSomePointsBinary()
+
+
+/**
+ * ************** TransformPointsInverse *********************
+ *
+ * This function maps points from the moving image to the fixed image,
+ * by iteratively inverting the transform per point. Either a point file
+ * is given, or "all", which generates the inverse deformation field on
+ * the fixed image domain.
+ */
+
+template< class TElastix >
+void
+TransformBase< TElastix >
+::TransformPointsInverse( void ) const
+{
+  /** If the optional command "-definv" is given in the command
+   * line arguments, then and only then we continue.
+   */
+  const std::string definv = this->GetConfiguration()->GetCommandLineArgument( "-definv" );
+  if( definv == "" )
+  {
+    elxout << "  The command-line option \"-definv\" is not used, "
+           << "so no points are inversely transformed" << std::endl;
+    return;
+  }
+
+  /** Typedef's. */
+  typedef typename FixedImageType::RegionType    FixedImageRegionType;
+  typedef typename FixedImageType::DirectionType FixedImageDirectionType;
+  typedef typename MovingImageType::IndexType    MovingImageIndexType;
+  typedef itk::AdvancedTransformInverter<
+    CoordRepType, FixedImageDimension >                 InverterType;
+  typedef typename InverterType::SeedGridImageType InverseDeformationFieldImageType;
+
+  typedef bool DummyIPPPixelType;
+  typedef itk::DefaultStaticMeshTraits<
+    DummyIPPPixelType, FixedImageDimension,
+    FixedImageDimension, CoordRepType >                  MeshTraitsType;
+  typedef itk::PointSet< DummyIPPPixelType,
+    FixedImageDimension, MeshTraitsType >                PointSetType;
+  typedef itk::TransformixInputPointFileReader<
+    PointSetType >                                      IPPReaderType;
+
+  /** Make a temporary image with the fixed image domain. By taking the
+   * image from the resampler output, the UseDirectionCosines parameter is
+   * automatically taken into account.
+   */
+  FixedImageRegionType region;
+  region.SetIndex(
+    this->m_Elastix->GetElxResamplerBase()->GetAsITKBaseType()->GetOutputStartIndex() );
+  region.SetSize(
+    this->m_Elastix->GetElxResamplerBase()->GetAsITKBaseType()->GetSize() );
+  typename InverseDeformationFieldImageType::Pointer dummyImage
+    = InverseDeformationFieldImageType::New();
+  dummyImage->SetRegions( region );
+  dummyImage->SetOrigin(
+    this->m_Elastix->GetElxResamplerBase()->GetAsITKBaseType()->GetOutputOrigin() );
+  dummyImage->SetSpacing(
+    this->m_Elastix->GetElxResamplerBase()->GetAsITKBaseType()->GetOutputSpacing() );
+  dummyImage->SetDirection(
+    this->m_Elastix->GetElxResamplerBase()->GetAsITKBaseType()->GetOutputDirection() );
+
+  /** Read the settings of the inversion. */
+  double       tolerance               = 1e-4;
+  unsigned int maximumNumberOfIterations = 50;
+  unsigned int shrinkFactor              = 4;
+  this->m_Configuration->ReadParameter( tolerance,
+    "InverseTransformTolerance", 0, false );
+  this->m_Configuration->ReadParameter( maximumNumberOfIterations,
+    "InverseTransformMaximumNumberOfIterations", 0, false );
+  this->m_Configuration->ReadParameter( shrinkFactor,
+    "InverseTransformSeedGridShrinkFactor", 0, false );
+
+  /** Setup the inverter and precompute the coarse inverse. */
+  typename InverterType::Pointer inverter = InverterType::New();
+  inverter->SetTransform( this->GetAsITKBaseType() );
+  inverter->SetTolerance( tolerance );
+  inverter->SetMaximumNumberOfIterations( maximumNumberOfIterations );
+  elxout << "  Computing the inverse on a coarse seed grid ..." << std::endl;
+  inverter->ComputeSeedGrid( dummyImage, shrinkFactor );
+
+  /** Create the inverse deformation field. */
+  if( definv == "all" )
+  {
+    typedef itk::ChangeInformationImageFilter<
+      InverseDeformationFieldImageType >                ChangeInfoFilterType;
+    typedef itk::ImageFileWriter<
+      InverseDeformationFieldImageType >                WriterType;
+
+    elxout << "  Computing the inverse deformation field ..." << std::endl;
+    dummyImage->Allocate();
+    const itk::SizeValueType numberOfFailures
+      = inverter->GenerateInverseDisplacementField( dummyImage );
+    if( numberOfFailures > 0 )
+    {
+      elxout << "  WARNING: the inverse did not converge for "
+             << numberOfFailures << " voxels." << std::endl;
+    }
+
+    /** Possibly change direction cosines to their original value, as specified
+     * in the tp-file, or by the fixed image. This is only necessary when
+     * the UseDirectionCosines flag was set to false. */
+    typename ChangeInfoFilterType::Pointer infoChanger = ChangeInfoFilterType::New();
+    FixedImageDirectionType originalDirection;
+    bool                    retdc = this->GetElastix()->GetOriginalFixedImageDirection( originalDirection );
+    infoChanger->SetOutputDirection( originalDirection );
+    infoChanger->SetChangeDirection( retdc & !this->GetElastix()->GetUseDirectionCosines() );
+    infoChanger->SetInput( dummyImage );
+
+    /** Create a name for the inverse deformation field file. */
+    std::string resultImageFormat = "mhd";
+    this->m_Configuration->ReadParameter( resultImageFormat, "ResultImageFormat", 0, false );
+    std::ostringstream makeFileName( "" );
+    makeFileName << this->m_Configuration->GetCommandLineArgument( "-out" )
+                 << "inverseDeformationField." << resultImageFormat;
+
+    typename WriterType::Pointer writer = WriterType::New();
+    writer->SetInput( infoChanger->GetOutput() );
+    writer->SetFileName( makeFileName.str().c_str() );
+    try
+    {
+      writer->Update();
+    }
+    catch( itk::ExceptionObject & excp )
+    {
+      /** Add information to the exception. */
+      excp.SetLocation( "TransformBase - TransformPointsInverse()" );
+      std::string err_str = excp.GetDescription();
+      err_str += "\nError occurred while writing inverse deformation field image.\n";
+      excp.SetDescription( err_str );
+
+      /** Pass the exception to an higher level. */
+      throw excp;
+    }
+    return;
+  }
+
+  /** Read the input points. */
+  typename IPPReaderType::Pointer ippReader = IPPReaderType::New();
+  ippReader->SetFileName( definv.c_str() );
+  elxout << "  Reading input point file: " << definv << std::endl;
+  try
+  {
+    ippReader->Update();
+  }
+  catch( itk::ExceptionObject & err )
+  {
+    xl::xout[ "error" ] << "  Error while opening input point file." << std::endl;
+    xl::xout[ "error" ] << err << std::endl;
+    return;
+  }
+  const unsigned int nrofpoints = ippReader->GetNumberOfPoints();
+  elxout << "  Number of specified input points: " << nrofpoints << std::endl;
+  typename PointSetType::Pointer inputPointSet = ippReader->GetOutput();
+
+  /** The input points live in the moving image domain, so input given as
+   * indices can only be converted with the geometry of the moving image.
+   */
+  typename MovingImageType::Pointer movingImage = this->GetElastix()->GetMovingImage();
+  if( ippReader->GetPointsAreIndices() && movingImage.IsNull() )
+  {
+    xl::xout[ "error" ] << "  ERROR: \"-definv\" with input as indices requires "
+                        << "a moving image, supplied by \"-in\"." << std::endl;
+    return;
+  }
+
+  /** Get the points, converting indices to physical points if needed. */
+  std::vector< OutputPointType > inputpointvec( nrofpoints );
+  std::vector< InputPointType >  outputpointvec( nrofpoints );
+  std::vector< char >            convergedvec( nrofpoints );
+  for( unsigned int j = 0; j < nrofpoints; j++ )
+  {
+    OutputPointType point; point.Fill( 0.0f );
+    inputPointSet->GetPoint( j, &point );
+    if( ippReader->GetPointsAreIndices() )
+    {
+      MovingImageIndexType index;
+      for( unsigned int i = 0; i < MovingImageDimension; i++ )
+      {
+        index[ i ] = static_cast< typename MovingImageIndexType::IndexValueType >(
+          itk::Math::Round< double >( point[ i ] ) );
+      }
+      movingImage->TransformIndexToPhysicalPoint( index, point );
+    }
+    inputpointvec[ j ] = point;
+  }
+
+  /** Invert the transform for all points. */
+  elxout << "  The input points are inversely transformed." << std::endl;
+  const long numberOfPoints = static_cast< long >( nrofpoints );
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel for
+#endif
+  for( long j = 0; j < numberOfPoints; j++ )
+  {
+    convergedvec[ j ] = inverter->TransformPoint( inputpointvec[ j ], outputpointvec[ j ] );
+  }
+
+  /** Create filename and file stream. */
+  std::string outputPointsFileName = this->m_Configuration
+    ->GetCommandLineArgument( "-out" );
+  outputPointsFileName += "inverseoutputpoints.txt";
+  std::ofstream outputPointsFile( outputPointsFileName.c_str() );
+  outputPointsFile << std::showpoint << std::fixed;
+  elxout << "  The inversely transformed points are saved in: "
+         <<  outputPointsFileName << std::endl;
+
+  /** Print the results. */
+  for( unsigned int j = 0; j < nrofpoints; j++ )
+  {
+    outputPointsFile << "Point\t" << j << "\t; InputPoint = [ ";
+    for( unsigned int i = 0; i < MovingImageDimension; i++ )
+    {
+      outputPointsFile << inputpointvec[ j ][ i ] << " ";
+    }
+    outputPointsFile << "]\t; OutputPoint = [ ";
+    for( unsigned int i = 0; i < FixedImageDimension; i++ )
+    {
+      outputPointsFile << outputpointvec[ j ][ i ] << " ";
+    }
+    outputPointsFile << "]\t; Converged = " << ( convergedvec[ j ] ? 1 : 0 ) << "\n";
+  }
+
+} // end TransformPointsInverse()
+
+
 /**
  * ************** TransformPointsAllPoints **********************
  *
@@ -1470,6 +1808,17 @@ void
 TransformBase< TElastix >
 ::TransformPointsAllPoints( void ) const
 {
+#ifndef _ELASTIX_BUILD_LIBRARY
+  /** Stream the deformation field to file if it exceeds the memory budget. */
+  const unsigned int numberOfStreamDivisions = this->GetNumberOfStreamDivisions(
+    sizeof( typename DeformationFieldImageType::PixelType ) );
+  if( numberOfStreamDivisions > 1 )
+  {
+    this->WriteDeformationFieldImageStreamed( numberOfStreamDivisions );
+    return;
+  }
+#endif
+
   typename DeformationFieldImageType::Pointer deformationfield = this->GenerateDeformationFieldImage();
   //put deformation field in container
   this->m_Elastix->SetResultDeformationField( deformationfield.GetPointer() );
@@ -1600,6 +1949,95 @@ WriteDeformationFieldImage(
 } // end WriteDeformationFieldImage()
 
 
+/**
+ * ************** WriteDeformationFieldImageStreamed **********************
+ */
+
+template< class TElastix >
+void
+TransformBase< TElastix >
+::WriteDeformationFieldImageStreamed( const unsigned int numberOfStreamDivisions ) const
+{
+  /** Typedef's. */
+  typedef typename FixedImageType::DirectionType FixedImageDirectionType;
+  typedef itk::TransformToDisplacementFieldFilter<
+    DeformationFieldImageType, CoordRepType >         DeformationFieldGeneratorType;
+  typedef itk::ChangeInformationImageFilter<
+    DeformationFieldImageType >                       ChangeInfoFilterType;
+  typedef itk::ImageFileWriter<
+    DeformationFieldImageType >                       DeformationFieldWriterType;
+
+  /** Create an setup deformation field generator. */
+  typename DeformationFieldGeneratorType::Pointer defGenerator
+    = DeformationFieldGeneratorType::New();
+  defGenerator->SetSize(
+    this->m_Elastix->GetElxResamplerBase()->GetAsITKBaseType()->GetSize() );
+  defGenerator->SetOutputSpacing(
+    this->m_Elastix->GetElxResamplerBase()->GetAsITKBaseType()->GetOutputSpacing() );
+  defGenerator->SetOutputOrigin(
+    this->m_Elastix->GetElxResamplerBase()->GetAsITKBaseType()->GetOutputOrigin() );
+  defGenerator->SetOutputStartIndex(
+    this->m_Elastix->GetElxResamplerBase()->GetAsITKBaseType()->GetOutputStartIndex() );
+  defGenerator->SetOutputDirection(
+    this->m_Elastix->GetElxResamplerBase()->GetAsITKBaseType()->GetOutputDirection() );
+  defGenerator->SetTransform( const_cast< const ITKBaseType * >( this->GetAsITKBaseType() ) );
+
+  /** Possibly change direction cosines to their original value, as specified
+   * in the tp-file, or by the fixed image. This is only necessary when
+   * the UseDirectionCosines flag was set to false. */
+  typename ChangeInfoFilterType::Pointer infoChanger = ChangeInfoFilterType::New();
+  FixedImageDirectionType originalDirection;
+  bool                    retdc = this->GetElastix()->GetOriginalFixedImageDirection( originalDirection );
+  infoChanger->SetOutputDirection( originalDirection );
+  infoChanger->SetChangeDirection( retdc & !this->GetElastix()->GetUseDirectionCosines() );
+  infoChanger->SetInput( defGenerator->GetOutput() );
+
+  /** Create a name for the deformation field file. */
+  std::string resultImageFormat = "mhd";
+  this->m_Configuration->ReadParameter( resultImageFormat, "ResultImageFormat", 0, false );
+  std::ostringstream makeFileName( "" );
+  makeFileName << this->m_Configuration->GetCommandLineArgument( "-out" )
+               << "deformationField." << resultImageFormat;
+
+  /** Setup the writer. Each chunk is generated, multi-threaded, and written
+   * before the next chunk is requested.
+   */
+  typename DeformationFieldWriterType::Pointer defWriter
+    = DeformationFieldWriterType::New();
+  defWriter->SetInput( infoChanger->GetOutput() );
+  defWriter->SetFileName( makeFileName.str().c_str() );
+  defWriter->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+
+  /** Track the progress of writing the deformation field. */
+#ifndef _ELASTIX_BUILD_LIBRARY
+  typename ProgressCommandType::Pointer progressObserver = ProgressCommandType::New();
+  progressObserver->ConnectObserver( defWriter );
+  progressObserver->SetStartString( "  Progress: " );
+  progressObserver->SetEndString( "%" );
+#endif
+
+  /** Do the writing. */
+  elxout << "  Computing and writing the deformation field in "
+         << numberOfStreamDivisions << " chunks ..." << std::endl;
+  try
+  {
+    defWriter->Update();
+  }
+  catch( itk::ExceptionObject & excp )
+  {
+    /** Add information to the exception. */
+    excp.SetLocation( "TransformBase - WriteDeformationFieldImageStreamed()" );
+    std::string err_str = excp.GetDescription();
+    err_str += "\nError occurred while writing deformation field image.\n";
+    excp.SetDescription( err_str );
+
+    /** Pass the exception to an higher level. */
+    throw excp;
+  }
+
+} // end WriteDeformationFieldImageStreamed()
+
+
 /**
  * ************** ComputeDeterminantOfSpatialJacobian **********************
  */
@@ -1681,6 +2119,8 @@ TransformBase< TElastix >
   typename JacobianWriterType::Pointer jacWriter = JacobianWriterType::New();
   jacWriter->SetInput( infoChanger->GetOutput() );
   jacWriter->SetFileName( makeFileName.str().c_str() );
+  jacWriter->SetNumberOfStreamDivisions(
+    this->GetNumberOfStreamDivisions( sizeof( typename JacobianImageType::PixelType ) ) );
 
   /** Do the writing. */
   elxout << "  Computing and writing the spatial Jacobian determinant..." << std::endl;
@@ -1784,6 +2224,8 @@ TransformBase< TElastix >
   typename JacobianWriterType::Pointer jacWriter = JacobianWriterType::New();
   jacWriter->SetInput( infoChanger->GetOutput() );
   jacWriter->SetFileName( makeFileName.str().c_str() );
+  jacWriter->SetNumberOfStreamDivisions(
+    this->GetNumberOfStreamDivisions( sizeof( OutputSpatialJacobianType ) ) );
   /** Hack to change the pixel type to vector. Not necessary for mhd. */
   typename PixelTypeChangeCommandType::Pointer jacStartWriteCommand
     = PixelTypeChangeCommandType::New();
@@ -1813,6 +2255,43 @@ TransformBase< TElastix >
 } // end ComputeSpatialJacobian()
 
 
+/**
+ * ************** GetNumberOfStreamDivisions **********************
+ */
+
+template< class TElastix >
+unsigned int
+TransformBase< TElastix >
+::GetNumberOfStreamDivisions( const std::size_t numberOfBytesPerPixel ) const
+{
+  /** Read the memory budget in megabytes. Zero means no streaming. */
+  double maximumStreamingMemory = 0.0;
+  this->m_Configuration->ReadParameter( maximumStreamingMemory,
+    "MaximumStreamingMemory", 0, false );
+  if( maximumStreamingMemory <= 0.0 )
+  {
+    return 1;
+  }
+
+  /** Compute the memory needed for the full output image. */
+  const typename FixedImageType::SizeType size
+    = this->m_Elastix->GetElxResamplerBase()->GetAsITKBaseType()->GetSize();
+  double numberOfMegaBytes = static_cast< double >( numberOfBytesPerPixel ) / 1048576.0;
+  for( unsigned int i = 0; i < FixedImageDimension; ++i )
+  {
+    numberOfMegaBytes *= static_cast< double >( size[ i ] );
+  }
+
+  /** The writer splits along the last dimension, so more divisions than
+   * slices are not useful.
+   */
+  const double numberOfDivisions = vcl_ceil( numberOfMegaBytes / maximumStreamingMemory );
+  return static_cast< unsigned int >( vnl_math_max( 1.0, vnl_math_min(
+    numberOfDivisions, static_cast< double >( size[ FixedImageDimension - 1 ] ) ) ) );
+
+} // end GetNumberOfStreamDivisions()
+
+
 /**
  * ************** SetTransformParametersFileName ****************
  */
@@ -38,6 +38,7 @@
 #include "itkVectorContainer.h"
 #include "itkImageFileReader.h"
 #include "itkChangeInformationImageFilter.h"
+#include "itkMemoryMappedImageReader.h"
 
 #include <fstream>
 #include <iomanip>
@@ -386,6 +387,10 @@ protected:
    * The useDirection option is built in as a means to ignore the direction
    * cosines. Set it to false to force the direction cosines to identity.
    * The original direction cosines are returned separately.
+   *
+   * With the useMemoryMapping option, files that allow it are mapped into
+   * memory instead of read, see itk::MemoryMappedImageReader. Other files
+   * are read as usual.
    */
   template< class TImage >
   class MultipleImageLoader
@@ -399,16 +404,71 @@ public:
     typedef typename ImageType::DirectionType              DirectionType;
     typedef itk::ChangeInformationImageFilter< ImageType > ChangeInfoFilterType;
     typedef typename ChangeInfoFilterType::Pointer         ChangeInfoFilterPointer;
+    typedef itk::MemoryMappedImageReader< ImageType >      MemoryMappedImageReaderType;
 
     static DataObjectContainerPointer GenerateImageContainer(
       FileNameContainerType * fileNameContainer, const std::string & imageDescription,
-      bool useDirectionCosines, DirectionType * originalDirectionCosines = NULL )
+      bool useDirectionCosines, DirectionType * originalDirectionCosines = NULL,
+      bool useMemoryMapping = false )
     {
       DataObjectContainerPointer imageContainer = DataObjectContainerType::New();
 
       /** Loop over all image filenames. */
       for( unsigned int i = 0; i < fileNameContainer->Size(); ++i )
       {
+        /** Try to map the file, which avoids reading and copying the pixels. */
+        ImagePointer mappedImage;
+        if( useMemoryMapping )
+        {
+          bool dataIsCopied = false;
+          try
+          {
+            mappedImage = MemoryMappedImageReaderType::Read(
+              fileNameContainer->ElementAt( i ), &dataIsCopied );
+          }
+          catch( itk::ExceptionObject & )
+          {
+            /** Leave the error reporting to the normal reader. */
+            mappedImage = 0;
+          }
+
+          /** The loaders may run in parallel, see ElastixTemplate::Run(). */
+#ifdef ELASTIX_USE_OPENMP
+          #pragma omp critical
+#endif
+          {
+            elxout << "  " << imageDescription << " " << fileNameContainer->ElementAt( i );
+            if( mappedImage.IsNull() )
+            {
+              elxout << " cannot be memory mapped, reading it instead." << std::endl;
+            }
+            else if( dataIsCopied )
+            {
+              elxout << " is memory mapped and copied, because its pixel data are not aligned."
+                     << std::endl;
+            }
+            else
+            {
+              elxout << " is memory mapped." << std::endl;
+            }
+          }
+        }
+        if( mappedImage.IsNotNull() )
+        {
+          if( originalDirectionCosines )
+          {
+            *originalDirectionCosines = mappedImage->GetDirection();
+          }
+          if( !useDirectionCosines )
+          {
+            DirectionType direction;
+            direction.SetIdentity();
+            mappedImage->SetDirection( direction );
+          }
+          imageContainer->CreateElementAt( i ) = mappedImage.GetPointer();
+          continue;
+        }
+
         /** Setup reader. */
         ImageReaderPointer imageReader = ImageReaderType::New();
         imageReader->SetFileName( fileNameContainer->ElementAt( i ).c_str() );
@@ -106,6 +106,16 @@ namespace elastix
  *  image, which relates voxel coordinates to world coordinates. Ignoring it
  *  may easily lead to left/right swaps for example, which could skrew up a
  *  (medical) analysis.
+ * \parameter UseMemoryMappedImages: Controls whether the input images and masks
+ *    are mapped into memory instead of read, when they are uncompressed MetaImage
+ *    files of the internal pixel type. The pixels are then loaded on demand, and
+ *    shared between processes that use the same file. The pixel data of a .mha
+ *    file start right after its text header, which is usually not a multiple of
+ *    the pixel size, and then the pixels are copied once. So in practice only
+ *    .mhd/.raw pairs, without a HeaderSize or with one that is a multiple of the
+ *    pixel size, avoid the copy. The log reports which images were mapped.\n
+ *    example: <tt>(UseMemoryMappedImages "true")</tt>\n
+ *    Default value: "false".
  *
  * \ingroup Kernel
  */
@@ -346,6 +356,17 @@ protected:
   typedef typename Superclass2::MultipleImageLoader< FixedMaskType >   FixedMaskLoaderType;
   typedef typename Superclass2::MultipleImageLoader< MovingMaskType >  MovingMaskLoaderType;
 
+  /** Load the images of a file name container with TLoader. Exceptions may
+   * not leave an omp section, so instead of throwing, this function stores
+   * the error in excp and returns false.
+   */
+  template< class TLoader >
+  static bool LoadImageContainer( FileNameContainerType * fileNames,
+    const std::string & imageDescription, bool useDirectionCosines,
+    typename TLoader::DirectionType * originalDirectionCosines,
+    bool useMemoryMapping, DataObjectContainerPointer & container,
+    itk::ExceptionObject & excp );
+
   /** CallBack commands. */
   BeforeEachResolutionCommandPointer m_BeforeEachResolutionCommand;
   AfterEachIterationCommandPointer   m_AfterEachIterationCommand;
@@ -254,14 +254,94 @@ ElastixTemplate< TFixedImage, TMovingImage >
   this->m_Timer0.Start();
   elxout << "\nReading images..." << std::endl;
 
-  /** Read images and masks, if not set already. */
+  /** Read images and masks, if not set already. The four loaders are
+   * independent, so with OpenMP they run concurrently, which pays off
+   * for compressed images. Exceptions cannot leave an OpenMP section;
+   * they are caught and rethrown afterwards, in the usual order.
+   */
   const bool              useDirCos = this->GetUseDirectionCosines();
   FixedImageDirectionType fixDirCos;
-  if( this->GetFixedImage() == 0 )
+  const bool              loadFixedImage  = ( this->GetFixedImage() == 0 );
+  const bool              loadMovingImage = ( this->GetMovingImage() == 0 );
+  const bool              loadFixedMask   = ( this->GetFixedMask() == 0 );
+  const bool              loadMovingMask  = ( this->GetMovingMask() == 0 );
+
+  /** Map uncompressed images into memory instead of reading them, if requested. */
+  bool useMemoryMapping = false;
+  this->GetConfiguration()->ReadParameter( useMemoryMapping,
+    "UseMemoryMappedImages", 0, false );
+
+  /** Exceptions may not leave an omp section, so each loader records its
+   * error, which is rethrown after the parallel region. */
+  DataObjectContainerPointer loadedContainers[ 4 ];
+  itk::ExceptionObject       loadExceptions[ 4 ];
+  bool                       loadFailed[ 4 ] = { false, false, false, false };
+
+  /** Make sure the object factories, that create the ImageIO's, are
+   * initialized before the loaders run in parallel. */
+  itk::ObjectFactoryBase::GetRegisteredFactories();
+
+#ifdef ELASTIX_USE_OPENMP
+  #pragma omp parallel sections
+#endif
+  {
+#ifdef ELASTIX_USE_OPENMP
+    #pragma omp section
+#endif
+    {
+      if( loadFixedImage )
+      {
+        loadFailed[ 0 ] = !LoadImageContainer< FixedImageLoaderType >(
+          this->GetFixedImageFileNameContainer(), "Fixed Image", useDirCos, &fixDirCos,
+          useMemoryMapping, loadedContainers[ 0 ], loadExceptions[ 0 ] );
+      }
+    }
+#ifdef ELASTIX_USE_OPENMP
+    #pragma omp section
+#endif
+    {
+      if( loadMovingImage )
+      {
+        loadFailed[ 1 ] = !LoadImageContainer< MovingImageLoaderType >(
+          this->GetMovingImageFileNameContainer(), "Moving Image", useDirCos, NULL,
+          useMemoryMapping, loadedContainers[ 1 ], loadExceptions[ 1 ] );
+      }
+    }
+#ifdef ELASTIX_USE_OPENMP
+    #pragma omp section
+#endif
+    {
+      if( loadFixedMask )
+      {
+        loadFailed[ 2 ] = !LoadImageContainer< FixedMaskLoaderType >(
+          this->GetFixedMaskFileNameContainer(), "Fixed Mask", useDirCos, NULL,
+          useMemoryMapping, loadedContainers[ 2 ], loadExceptions[ 2 ] );
+      }
+    }
+#ifdef ELASTIX_USE_OPENMP
+    #pragma omp section
+#endif
+    {
+      if( loadMovingMask )
+      {
+        loadFailed[ 3 ] = !LoadImageContainer< MovingMaskLoaderType >(
+          this->GetMovingMaskFileNameContainer(), "Moving Mask", useDirCos, NULL,
+          useMemoryMapping, loadedContainers[ 3 ], loadExceptions[ 3 ] );
+      }
+    }
+  } // end parallel sections
+
+  for( unsigned int i = 0; i < 4; ++i )
   {
-    this->SetFixedImageContainer(
-      FixedImageLoaderType::GenerateImageContainer(
-      this->GetFixedImageFileNameContainer(), "Fixed Image", useDirCos, &fixDirCos ) );
+    if( loadFailed[ i ] )
+    {
+      throw loadExceptions[ i ];
+    }
+  }
+
+  if( loadFixedImage )
+  {
+    this->SetFixedImageContainer( loadedContainers[ 0 ] );
     this->SetOriginalFixedImageDirection( fixDirCos );
   }
   else
@@ -276,24 +356,17 @@ ElastixTemplate< TFixedImage, TMovingImage >
     fixDirCos = fixedIm->GetDirection();
     this->SetOriginalFixedImageDirection( fixDirCos );
   }
-
-  if( this->GetMovingImage() == 0 )
+  if( loadMovingImage )
   {
-    this->SetMovingImageContainer(
-      MovingImageLoaderType::GenerateImageContainer(
-      this->GetMovingImageFileNameContainer(), "Moving Image", useDirCos ) );
+    this->SetMovingImageContainer( loadedContainers[ 1 ] );
   }
-  if( this->GetFixedMask() == 0 )
+  if( loadFixedMask )
   {
-    this->SetFixedMaskContainer(
-      FixedMaskLoaderType::GenerateImageContainer(
-      this->GetFixedMaskFileNameContainer(), "Fixed Mask", useDirCos ) );
+    this->SetFixedMaskContainer( loadedContainers[ 2 ] );
   }
-  if( this->GetMovingMask() == 0 )
+  if( loadMovingMask )
   {
-    this->SetMovingMaskContainer(
-      MovingMaskLoaderType::GenerateImageContainer(
-      this->GetMovingMaskFileNameContainer(), "Moving Mask", useDirCos ) );
+    this->SetMovingMaskContainer( loadedContainers[ 3 ] );
   }
 
   /** Print the time spent on reading images. */
@@ -361,6 +434,48 @@ ElastixTemplate< TFixedImage, TMovingImage >
 } // end Run()
 
 
+/**
+ * ********************** LoadImageContainer *************************
+ */
+
+template< class TFixedImage, class TMovingImage >
+template< class TLoader >
+bool
+ElastixTemplate< TFixedImage, TMovingImage >
+::LoadImageContainer( FileNameContainerType * fileNames,
+  const std::string & imageDescription, bool useDirectionCosines,
+  typename TLoader::DirectionType * originalDirectionCosines,
+  bool useMemoryMapping, DataObjectContainerPointer & container,
+  itk::ExceptionObject & excp )
+{
+  try
+  {
+    container = TLoader::GenerateImageContainer( fileNames, imageDescription,
+      useDirectionCosines, originalDirectionCosines, useMemoryMapping );
+  }
+  catch( itk::ExceptionObject & err )
+  {
+    excp = err;
+    return false;
+  }
+  catch( std::exception & err )
+  {
+    excp = itk::ExceptionObject( __FILE__, __LINE__,
+      "Error while reading the " + imageDescription + ": " + err.what(), ITK_LOCATION );
+    return false;
+  }
+  catch( ... )
+  {
+    excp = itk::ExceptionObject( __FILE__, __LINE__,
+      "Unknown error while reading the " + imageDescription, ITK_LOCATION );
+    return false;
+  }
+
+  return true;
+
+} // end LoadImageContainer()
+
+
 /**
  * ************************ ApplyTransform **********************
  */
@@ -444,6 +559,23 @@ ElastixTemplate< TFixedImage, TMovingImage >
   elxout << "  Transforming points done, it took "
          << this->ConvertSecondsToDHMS( timer.GetMean(), 2 ) << std::endl;
 
+  /** Call TransformPointsInverse. */
+  timer.Reset();
+  timer.Start();
+  elxout << "Inversely transforming points ..." << std::endl;
+  try
+  {
+    this->GetElxTransformBase()->TransformPointsInverse();
+  }
+  catch( itk::ExceptionObject & excp )
+  {
+    xout[ "error" ] << excp << std::endl;
+    xout[ "error" ] << "However, transformix continues anyway." << std::endl;
+  }
+  timer.Stop();
+  elxout << "  Inversely transforming points done, it took "
+         << this->ConvertSecondsToDHMS( timer.GetMean(), 2 ) << std::endl;
+
   /** Call ComputeDeterminantOfSpatialJacobian.
    * Actually we could loop over all transforms.
    * But for now, there seems to be no use yet for that.
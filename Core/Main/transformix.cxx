@@ -128,11 +128,12 @@ main( int argc, char ** argv )
   if( argMap.count( "-in" ) == 0
     && argMap.count( "-ipp" ) == 0
     && argMap.count( "-def" ) == 0
+    && argMap.count( "-definv" ) == 0
     && argMap.count( "-jac" ) == 0
     && argMap.count( "-jacmat" ) == 0 )
   {
     std::cerr << "ERROR: At least one of the CommandLine options \"-in\", "
-              << "\"-def\", \"-jac\", or \"-jacmat\" should be given!" << std::endl;
+              << "\"-def\", \"-definv\", \"-jac\", or \"-jacmat\" should be given!" << std::endl;
     returndummy |= -1;
   }
 
@@ -262,6 +263,9 @@ PrintHelp( void )
             << "            according to the specified transform-parameter file\n";
   std::cout << "            use \"-def all\" to transform all points from the input-image, which\n"
             << "            effectively generates a deformation field.\n";
+  std::cout << "  -definv   file containing moving-image points; the points are mapped to the\n"
+            << "            fixed image by inverting the transform iteratively\n";
+  std::cout << "            use \"-definv all\" to generate the inverse deformation field.\n";
   std::cout << "  -jac      use \"-jac all\" to generate an image with the determinant of the\n"
             << "            spatial Jacobian\n";
   std::cout << "  -jacmat   use \"-jacmat all\" to generate an image with the spatial Jacobian\n"
@@ -269,7 +273,8 @@ PrintHelp( void )
   std::cout << "  -priority set the process priority to high, abovenormal, normal (default),\n"
             << "            belownormal, or idle (Windows only option)\n";
   std::cout << "  -threads  set the maximum number of threads of transformix\n";
-  std::cout << "\nAt least one of the options \"-in\", \"-def\", \"-jac\", or \"-jacmat\" should be given.\n"
+  std::cout << "\nAt least one of the options \"-in\", \"-def\", \"-definv\", \"-jac\", or \"-jacmat\"\n"
+            << "should be given.\n"
             << std::endl;
 
   /** The parameter file. */
@@ -23,6 +23,7 @@
 #include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <vector>
 
 //-------------------------------------------------------------------------------------
 
@@ -427,6 +428,122 @@ main( int argc, char * argv[] )
     return 1;
   }
 
+  /** The weights cache should not change the results of TransformPoint()
+   * and GetJacobian(), neither on nor off the sample grid. Check this for
+   * a sample grid aligned with the B-spline grid (separable cache), and
+   * for a rotated one (per-sample cache). A double precision transform is
+   * used, so that the sample grid points are recognized exactly.
+   */
+  typedef itk::AdvancedBSplineDeformableTransform<
+    double, Dimension, SplineOrder >                         DoubleTransformType;
+  typedef DoubleTransformType::InputPointType  DoubleInputPointType;
+  typedef DoubleTransformType::OutputPointType DoubleOutputPointType;
+  typedef DoubleTransformType::JacobianType    DoubleJacobianType;
+
+  DoubleTransformType::Pointer cacheTransform = DoubleTransformType::New();
+  cacheTransform->SetGridOrigin( gridOrigin );
+  cacheTransform->SetGridSpacing( gridSpacing );
+  cacheTransform->SetGridRegion( gridRegion );
+  cacheTransform->SetGridDirection( gridDirection );
+  DoubleTransformType::ParametersType cacheParameters( parameters.GetSize() );
+  for( unsigned int i = 0; i < parameters.GetSize(); ++i )
+  {
+    cacheParameters[ i ] = parameters[ i ];
+  }
+  cacheTransform->SetParameters( cacheParameters );
+
+  for( unsigned int rotated = 0; rotated < 2; ++rotated )
+  {
+    InputImageType::Pointer sampleImage = InputImageType::New();
+    SizeType                sampleImageSize;
+    sampleImageSize.Fill( 24 );
+    SpacingType sampleImageSpacing;
+    sampleImageSpacing[ 0 ] = 1.3; sampleImageSpacing[ 1 ] = 1.7; sampleImageSpacing[ 2 ] = 2.1;
+    OriginType sampleImageOrigin;
+    sampleImageOrigin[ 0 ] = -20.0; sampleImageOrigin[ 1 ] = -15.0; sampleImageOrigin[ 2 ] = -30.0;
+    DirectionType sampleImageDirection;
+    sampleImageDirection.SetIdentity();
+    if( rotated )
+    {
+      const double angle = 0.3;
+      sampleImageDirection[ 0 ][ 0 ] = vcl_cos( angle ); sampleImageDirection[ 0 ][ 1 ] = -vcl_sin( angle );
+      sampleImageDirection[ 1 ][ 0 ] = vcl_sin( angle ); sampleImageDirection[ 1 ][ 1 ] = vcl_cos( angle );
+    }
+    sampleImage->SetRegions( RegionType( gridIndex, sampleImageSize ) );
+    sampleImage->SetSpacing( sampleImageSpacing );
+    sampleImage->SetOrigin( sampleImageOrigin );
+    sampleImage->SetDirection( sampleImageDirection );
+
+    /** Sample every third voxel, starting at index 1. */
+    IndexType sampleGridIndex;
+    sampleGridIndex.Fill( 1 );
+    SizeType sampleGridSize;
+    sampleGridSize.Fill( 7 );
+    SizeType sampleGridSpacing;
+    sampleGridSpacing.Fill( 3 );
+    const RegionType sampleGridRegion( sampleGridIndex, sampleGridSize );
+
+    /** Collect points on the sample grid, and points halfway in between. */
+    std::vector< DoubleInputPointType > testPoints;
+    for( unsigned int n = 0; n < sampleGridSize[ 0 ]; n += 2 )
+    {
+      itk::ContinuousIndex< double, Dimension > cindex;
+      for( unsigned int d = 0; d < Dimension; ++d )
+      {
+        cindex[ d ] = sampleGridIndex[ d ] + ( n + d ) % sampleGridSize[ d ] * sampleGridSpacing[ d ];
+      }
+      DoubleInputPointType point;
+      sampleImage->TransformContinuousIndexToPhysicalPoint( cindex, point );
+      testPoints.push_back( point );
+      cindex[ 0 ] += 0.5 * sampleGridSpacing[ 0 ];
+      sampleImage->TransformContinuousIndexToPhysicalPoint( cindex, point );
+      testPoints.push_back( point );
+    }
+
+    /** Results without cache. */
+    cacheTransform->ClearWeightsCache();
+    std::vector< DoubleOutputPointType >      uncachedPoints( testPoints.size() );
+    std::vector< DoubleJacobianType >         uncachedJacobians( testPoints.size() );
+    std::vector< NonZeroJacobianIndicesType > uncachedNzji( testPoints.size() );
+    for( unsigned int i = 0; i < testPoints.size(); ++i )
+    {
+      uncachedPoints[ i ] = cacheTransform->TransformPoint( testPoints[ i ] );
+      cacheTransform->GetJacobian( testPoints[ i ], uncachedJacobians[ i ], uncachedNzji[ i ] );
+    }
+
+    /** Results with cache. */
+    cacheTransform->PrecomputeWeightsOnSampleGrid( sampleImage, sampleGridRegion, sampleGridSpacing );
+    if( !cacheTransform->GetHasWeightsCache()
+      || cacheTransform->GetWeightsCacheIsSeparable() == ( rotated != 0 ) )
+    {
+      std::cerr << "ERROR: PrecomputeWeightsOnSampleGrid() did not build the expected "
+                << ( rotated ? "per-sample" : "separable" ) << " weights cache." << std::endl;
+      return 1;
+    }
+    for( unsigned int i = 0; i < testPoints.size(); ++i )
+    {
+      const DoubleOutputPointType cachedPoint = cacheTransform->TransformPoint( testPoints[ i ] );
+      DoubleJacobianType          cachedJacobian;
+      NonZeroJacobianIndicesType  cachedNzji;
+      cacheTransform->GetJacobian( testPoints[ i ], cachedJacobian, cachedNzji );
+
+      if( cachedPoint.EuclideanDistanceTo( uncachedPoints[ i ] ) > 1e-8 )
+      {
+        std::cerr << "ERROR: TransformPoint() with weights cache differs from the "
+                  << "uncached result at point " << testPoints[ i ] << std::endl;
+        return 1;
+      }
+      if( cachedNzji != uncachedNzji[ i ]
+        || ( cachedJacobian - uncachedJacobians[ i ] ).frobenius_norm() > 1e-8 )
+      {
+        std::cerr << "ERROR: GetJacobian() with weights cache differs from the "
+                  << "uncached result at point " << testPoints[ i ] << std::endl;
+        return 1;
+      }
+    }
+    cacheTransform->ClearWeightsCache();
+  }
+
   /** Exercise PrintSelf(). */
   transform->Print( std::cerr );
 
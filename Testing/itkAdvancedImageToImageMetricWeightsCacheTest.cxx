@@ -0,0 +1,213 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkAdvancedMeanSquaresImageToImageMetric.h"
+#include "itkAdvancedBSplineDeformableTransform.h"
+#include "itkBSplineInterpolateImageFunction.h"
+#include "itkImageGridSampler.h"
+#include "itkImageRandomSampler.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include <iostream>
+
+/** This test checks that the metric keys the B-spline weights cache on
+ * the grid sampler: alternating a grid sampler with a random sampler, as
+ * the ASGD parameter estimation does, precomputes the weights once, and
+ * deleting the grid sampler releases them.
+ */
+
+namespace itk
+{
+
+/** A B-spline transform that counts the weights precomputations. */
+template< unsigned int NDimensions >
+class CountingBSplineTransform :
+  public AdvancedBSplineDeformableTransform< double, NDimensions, 3 >
+{
+public:
+
+  typedef CountingBSplineTransform Self;
+  typedef AdvancedBSplineDeformableTransform<
+    double, NDimensions, 3 >               Superclass;
+  typedef SmartPointer< Self >             Pointer;
+  typedef SmartPointer< const Self >       ConstPointer;
+  itkNewMacro( Self );
+
+  typedef typename Superclass::ImageBaseType ImageBaseType;
+  typedef typename Superclass::RegionType    RegionType;
+  typedef typename Superclass::SizeType      SizeType;
+
+  virtual void PrecomputeWeightsOnSampleGrid(
+    const ImageBaseType * image,
+    const RegionType & sampleGridRegion,
+    const SizeType & sampleGridSpacing )
+  {
+    ++this->m_NumberOfPrecomputations;
+    this->Superclass::PrecomputeWeightsOnSampleGrid(
+      image, sampleGridRegion, sampleGridSpacing );
+  }
+
+  unsigned int m_NumberOfPrecomputations;
+
+protected:
+
+  CountingBSplineTransform() : m_NumberOfPrecomputations( 0 ) {}
+  virtual ~CountingBSplineTransform() {}
+
+private:
+
+  CountingBSplineTransform( const Self & ); // purposely not implemented
+  void operator=( const Self & );           // purposely not implemented
+
+};
+
+} // end namespace itk
+
+//-------------------------------------------------------------------------------------
+
+int
+main( void )
+{
+  /** Typedefs. */
+  const unsigned int Dimension = 2;
+  typedef itk::Image< float, Dimension >                    ImageType;
+  typedef itk::CountingBSplineTransform< Dimension >        TransformType;
+  typedef itk::AdvancedMeanSquaresImageToImageMetric<
+    ImageType, ImageType >                                  MetricType;
+  typedef itk::BSplineInterpolateImageFunction<
+    ImageType, double, double >                             InterpolatorType;
+  typedef itk::ImageGridSampler< ImageType >                GridSamplerType;
+  typedef itk::ImageRandomSampler< ImageType >              RandomSamplerType;
+  typedef MetricType::TransformParametersType               ParametersType;
+  typedef MetricType::DerivativeType                        DerivativeType;
+
+  /** Create a smooth test image. */
+  ImageType::SizeType size;
+  size.Fill( 40 );
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetLargestPossibleRegion() );
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set( static_cast< float >( ( index[ 0 ] - 20.0 ) * ( index[ 0 ] - 20.0 )
+      + 0.5 * ( index[ 1 ] - 18.0 ) * ( index[ 1 ] - 18.0 ) ) );
+  }
+
+  /** Set up a B-spline transform covering the image. */
+  TransformType::Pointer transform = TransformType::New();
+  TransformType::RegionType gridRegion;
+  TransformType::SizeType   gridSize;
+  gridSize.Fill( 8 );
+  gridRegion.SetSize( gridSize );
+  TransformType::SpacingType gridSpacing;
+  gridSpacing.Fill( 8.0 );
+  TransformType::OriginType gridOrigin;
+  gridOrigin.Fill( -12.0 );
+  transform->SetGridRegion( gridRegion );
+  transform->SetGridSpacing( gridSpacing );
+  transform->SetGridOrigin( gridOrigin );
+  ParametersType parameters( transform->GetNumberOfParameters() );
+  parameters.Fill( 0.1 );
+  transform->SetParameters( parameters );
+
+  /** Set up the metric with a random sampler, as elastix does. */
+  InterpolatorType::Pointer  interpolator  = InterpolatorType::New();
+  RandomSamplerType::Pointer randomSampler = RandomSamplerType::New();
+  randomSampler->SetNumberOfSamples( 200 );
+
+  MetricType::Pointer metric = MetricType::New();
+  metric->SetFixedImage( image );
+  metric->SetMovingImage( image );
+  metric->SetFixedImageRegion( image->GetBufferedRegion() );
+  metric->SetTransform( transform );
+  metric->SetInterpolator( interpolator );
+  metric->SetImageSampler( randomSampler );
+  metric->SetUseMultiThread( false );
+  metric->Initialize();
+
+  /** Alternate a grid sampler and the random sampler, like
+   * AdaptiveStochasticGradientDescent::SampleGradients().
+   */
+  GridSamplerType::Pointer gridSampler = GridSamplerType::New();
+  gridSampler->SetInput( image );
+  gridSampler->SetInputImageRegion( image->GetBufferedRegion() );
+  GridSamplerType::SampleGridSpacingType sampleGridSpacing;
+  sampleGridSpacing.Fill( 2 );
+  gridSampler->SetSampleGridSpacing( sampleGridSpacing );
+  gridSampler->Update();
+
+  const unsigned int numberOfMeasurements = 5;
+  MetricType::MeasureType value = 0.0;
+  DerivativeType          derivative;
+  for( unsigned int i = 0; i < numberOfMeasurements; ++i )
+  {
+    parameters[ i ] += 0.05;
+
+    metric->SetImageSampler( gridSampler );
+    metric->GetValueAndDerivative( parameters, value, derivative );
+    if( !transform->GetHasWeightsCache() || !transform->GetUseWeightsCache() )
+    {
+      std::cerr << "ERROR: the grid sampler does not use the weights cache." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    metric->SetImageSampler( randomSampler );
+    randomSampler->SelectNewSamplesOnUpdate();
+    metric->GetValueAndDerivative( parameters, value, derivative );
+    if( !transform->GetHasWeightsCache() || transform->GetUseWeightsCache() )
+    {
+      std::cerr << "ERROR: the random sampler released or used the weights cache."
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cerr << "Precomputations for " << numberOfMeasurements
+            << " grid measurements: " << transform->m_NumberOfPrecomputations << std::endl;
+  if( transform->m_NumberOfPrecomputations != 1 )
+  {
+    std::cerr << "ERROR: expected 1 precomputation." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  /** New samples on the grid invalidate the cached weights. */
+  sampleGridSpacing.Fill( 3 );
+  gridSampler->SetSampleGridSpacing( sampleGridSpacing );
+  metric->SetImageSampler( gridSampler );
+  metric->GetValueAndDerivative( parameters, value, derivative );
+  if( transform->m_NumberOfPrecomputations != 2 )
+  {
+    std::cerr << "ERROR: changing the sample grid did not recompute the weights." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  /** After the grid sampler is deleted, the random sampler releases the cache. */
+  metric->SetImageSampler( randomSampler );
+  gridSampler = 0;
+  metric->GetValueAndDerivative( parameters, value, derivative );
+  if( transform->GetHasWeightsCache() )
+  {
+    std::cerr << "ERROR: the weights cache was not released after the grid "
+              << "sampler was deleted." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+
+} // end main
@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+/** \file
+ \brief Test the hits, misses, eviction and bound of the B-spline
+ coefficient image cache.
+ */
+
+#include "itkBSplineCoefficientImageCache.h"
+
+#include "itkImage.h"
+#include <iostream>
+
+//-------------------------------------------------------------------------------------
+
+// Report an error if the condition does not hold
+#define CHECK( condition, message ) \
+  if( !( condition ) ) \
+  { \
+    std::cerr << "ERROR: " << message << std::endl; \
+    return 1; \
+  }
+
+//-------------------------------------------------------------------------------------
+
+int
+main( void )
+{
+  /** Typedefs. */
+  const unsigned int Dimension = 2;
+  typedef itk::Image< float, Dimension >                            ImageType;
+  typedef itk::Image< double, Dimension >                           CoefficientImageType;
+  typedef itk::BSplineCoefficientImageCache< CoefficientImageType > CacheType;
+  typedef CacheType::SplineOrderArrayType                           SplineOrderArrayType;
+
+  /** Create some input images with data, and coefficient images. */
+  ImageType::SizeType size; size.Fill( 8 );
+  ImageType::Pointer            images[ 3 ];
+  CoefficientImageType::Pointer coefficients[ 3 ];
+  for( unsigned int i = 0; i < 3; ++i )
+  {
+    images[ i ] = ImageType::New();
+    images[ i ]->SetRegions( size );
+    images[ i ]->Allocate();
+    coefficients[ i ] = CoefficientImageType::New();
+    coefficients[ i ]->SetRegions( size );
+    coefficients[ i ]->Allocate();
+  }
+  const SplineOrderArrayType cubic( Dimension, 3 );
+  const SplineOrderArrayType linear( Dimension, 1 );
+
+  /** There is one instance. */
+  CacheType::Pointer cache = CacheType::GetInstance();
+  CHECK( cache.GetPointer() == CacheType::GetInstance().GetPointer(),
+    "GetInstance() returned different instances." );
+  cache->Clear();
+  cache->SetMaximumNumberOfEntries( 2 );
+
+  /** A hit, and misses for other spline orders and other images. */
+  cache->Insert( images[ 0 ], cubic, coefficients[ 0 ] );
+  CHECK( cache->Find( images[ 0 ], cubic ).GetPointer() == coefficients[ 0 ].GetPointer(),
+    "the inserted coefficients were not found." );
+  CHECK( cache->Find( images[ 0 ], linear ).IsNull(),
+    "coefficients were found for another spline order." );
+  CHECK( cache->Find( images[ 1 ], cubic ).IsNull(),
+    "coefficients were found for another image." );
+
+  /** A miss after the image is modified. Inserting another entry then
+   * removes the stale one.
+   */
+  cache->Insert( images[ 0 ], linear, coefficients[ 1 ] );
+  CHECK( cache->GetNumberOfEntries() == 2, "expected 2 entries." );
+  images[ 0 ]->Modified();
+  CHECK( cache->Find( images[ 0 ], cubic ).IsNull(),
+    "coefficients were found after the image was modified." );
+  cache->Insert( images[ 0 ], cubic, coefficients[ 2 ] );
+  CHECK( cache->GetNumberOfEntries() == 1,
+    "the stale entry was not removed on insert." );
+  CHECK( cache->Find( images[ 0 ], cubic ).GetPointer() == coefficients[ 2 ].GetPointer(),
+    "the new coefficients were not found." );
+
+  /** Releasing the data of an image makes its entry stale too. */
+  cache->Insert( images[ 1 ], cubic, coefficients[ 1 ] );
+  images[ 1 ]->Initialize();
+  cache->Insert( images[ 2 ], cubic, coefficients[ 2 ] );
+  CHECK( cache->Find( images[ 1 ], cubic ).IsNull(),
+    "coefficients were found after the data of the image was released." );
+  CHECK( cache->GetNumberOfEntries() == 2,
+    "the entry of the released image was not removed on insert." );
+
+  /** Deleting an image removes its entry. */
+  images[ 2 ] = 0;
+  CHECK( cache->GetNumberOfEntries() == 1,
+    "the entry was not removed when its image was deleted." );
+
+  /** The bound removes the least recently used entry. */
+  images[ 1 ]->SetRegions( size );
+  images[ 1 ]->Allocate();
+  images[ 2 ] = ImageType::New();
+  images[ 2 ]->SetRegions( size );
+  images[ 2 ]->Allocate();
+  cache->Insert( images[ 1 ], cubic, coefficients[ 1 ] );
+  cache->Find( images[ 0 ], cubic );
+  cache->Insert( images[ 2 ], cubic, coefficients[ 2 ] );
+  CHECK( cache->GetNumberOfEntries() == 2, "the bound of 2 entries was exceeded." );
+  CHECK( cache->Find( images[ 1 ], cubic ).IsNull(),
+    "the least recently used entry was not removed." );
+  CHECK( cache->Find( images[ 0 ], cubic ).IsNotNull()
+    && cache->Find( images[ 2 ], cubic ).IsNotNull(),
+    "a recently used entry was removed." );
+
+  /** Lowering the bound removes entries as well. */
+  cache->SetMaximumNumberOfEntries( 1 );
+  CHECK( cache->GetNumberOfEntries() == 1, "lowering the bound did not remove entries." );
+
+  cache->Clear();
+  CHECK( cache->GetNumberOfEntries() == 0, "Clear() did not remove all entries." );
+
+  return 0;
+
+} // end main
@@ -18,12 +18,15 @@
 #include "itkAdvancedBSplineDeformableTransform.h"
 
 #include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
 
 // Report timings
 #include "itkTimeProbe.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
+#include <vector>
 
 //-------------------------------------------------------------------------------------
 // Create a class that inherits from the B-spline transform,
@@ -286,6 +289,65 @@ main( int argc, char * argv[] )
   timeProbeNEW.Stop();
   const double newTime = timeProbeNEW.GetMean();
 
+  /** Time an optimizer iteration with double and with float coefficients:
+   * SetParameters() followed by TransformPoint() at random points spread
+   * over the grid, as with a random image sampler. With float coefficients,
+   * SetParameters() also copies all coefficients to single precision, which
+   * is timed separately, since it is paid in every iteration.
+   */
+  const unsigned int numberOfIterations = 50;
+  const unsigned int numberOfSamples    = 2048;
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator RandomGeneratorType;
+  RandomGeneratorType::Pointer randomGenerator = RandomGeneratorType::GetInstance();
+  randomGenerator->Initialize( 140377 );
+  std::vector< InputPointType > samples( numberOfSamples );
+  for( unsigned int i = 0; i < numberOfSamples; ++i )
+  {
+    for( unsigned int d = 0; d < Dimension; ++d )
+    {
+      samples[ i ][ d ] = gridOrigin[ d ] + gridSpacing[ d ]
+        * randomGenerator->GetUniformVariate( 2.0, gridSize[ d ] - 3.0 );
+    }
+  }
+
+  std::vector< OutputPointType > doubleOutput( numberOfSamples );
+  itk::TimeProbe timeProbeDouble, timeProbeFloat, timeProbeCopy;
+  double         maxDifference = 0.0;
+  for( unsigned int useFloat = 0; useFloat < 2; ++useFloat )
+  {
+    transform->SetUseFloatCoefficients( useFloat == 1 );
+    itk::TimeProbe & timeProbe = useFloat == 1 ? timeProbeFloat : timeProbeDouble;
+    for( unsigned int k = 0; k < numberOfIterations; ++k )
+    {
+      timeProbe.Start();
+      transform->SetParameters( parameters );
+      for( unsigned int i = 0; i < numberOfSamples; ++i )
+      {
+        outputPoint = transform->TransformPoint( samples[ i ] );
+        sum        += outputPoint[ 0 ]; sum += outputPoint[ 1 ]; sum += outputPoint[ 2 ];
+        if( useFloat == 0 )
+        {
+          doubleOutput[ i ] = outputPoint;
+        }
+        else
+        {
+          maxDifference = std::max( maxDifference,
+            outputPoint.EuclideanDistanceTo( doubleOutput[ i ] ) );
+        }
+      }
+      timeProbe.Stop();
+    }
+  }
+  for( unsigned int k = 0; k < numberOfIterations; ++k )
+  {
+    timeProbeCopy.Start();
+    transform->SetParameters( parameters );
+    timeProbeCopy.Stop();
+  }
+  transform->SetUseFloatCoefficients( false );
+  const double doubleTime = timeProbeDouble.GetMean();
+  const double floatTime  = timeProbeFloat.GetMean();
+
   // Avoid compiler optimizations, so use sum
   std::cerr << sum << std::endl; // works but ugly on screen
   //  volatile double a = sum; // works but gives unused variable warning
@@ -297,6 +359,21 @@ main( int argc, char * argv[] )
   std::cerr << "Time OLD = " << oldTime << " " << timeProbeOLD.GetUnit() << std::endl;
   std::cerr << "Time NEW = " << newTime << " " << timeProbeNEW.GetUnit() << std::endl;
   std::cerr << "Speedup factor = " << oldTime / newTime << std::endl;
+  std::cerr << "Time per iteration, double coefficients = " << doubleTime
+            << " " << timeProbeDouble.GetUnit() << std::endl;
+  std::cerr << "Time per iteration, float coefficients = " << floatTime
+            << " " << timeProbeFloat.GetUnit() << std::endl;
+  std::cerr << "  of which SetParameters() = " << timeProbeCopy.GetMean()
+            << " " << timeProbeCopy.GetUnit() << std::endl;
+  std::cerr << "Speedup factor float = " << doubleTime / floatTime << std::endl;
+  std::cerr << "Maximum displacement difference float = " << maxDifference << std::endl;
+
+  /** Single precision coefficients should only cause a tiny error. */
+  if( maxDifference > 1e-3 )
+  {
+    std::cerr << "ERROR: float coefficients differ too much from double." << std::endl;
+    return 1;
+  }
 
   /** Return a value. */
   return 0;
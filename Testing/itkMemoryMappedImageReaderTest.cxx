@@ -0,0 +1,224 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+/** \file
+ \brief Compare the images of the memory-mapped reader with those of the
+ ImageFileReader, for .mha files with aligned and unaligned pixel data,
+ and for .mhd/.raw pairs with and without a HeaderSize.
+ */
+
+#include "itkMemoryMappedImageReader.h"
+#include "itkImageFileReader.h"
+
+#include "itkImage.h"
+#include "itkByteSwapper.h"
+#include "itkImageRegionConstIterator.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+//-------------------------------------------------------------------------------------
+
+const unsigned int Dimension = 2;
+const unsigned int SizeX     = 7;
+const unsigned int SizeY     = 5;
+typedef float                              PixelType;
+typedef itk::Image< PixelType, Dimension > ImageType;
+
+// Create the MetaImage header. The number of decimals of the spacing is a
+// means to shift the start of the pixel data in a .mha file.
+std::string
+CreateHeader( unsigned int spacingDecimals, const std::string & elementDataFile,
+  const std::string & headerSize )
+{
+  std::ostringstream header;
+  header << "ObjectType = Image\n"
+         << "NDims = 2\n"
+         << "BinaryData = True\n"
+         << "BinaryDataByteOrderMSB = "
+         << ( itk::ByteSwapper< int >::SystemIsBigEndian() ? "True" : "False" ) << "\n"
+         << "CompressedData = False\n"
+         << "Offset = -3 2.5\n"
+         << "ElementSpacing = 1." << std::string( spacingDecimals, '5' ) << " 2\n"
+         << "DimSize = " << SizeX << " " << SizeY << "\n"
+         << "ElementType = MET_FLOAT\n";
+  if( !headerSize.empty() )
+  {
+    header << "HeaderSize = " << headerSize << "\n";
+  }
+  header << "ElementDataFile = " << elementDataFile << "\n";
+  return header.str();
+
+} // end CreateHeader()
+
+
+// Write the pixel values, preceded by numberOfPaddingBytes bytes
+void
+WritePixels( std::ofstream & file, unsigned int numberOfPaddingBytes )
+{
+  file << std::string( numberOfPaddingBytes, 'x' );
+  for( unsigned int i = 0; i < SizeX * SizeY; ++i )
+  {
+    const PixelType value = static_cast< PixelType >( 0.25 * i - 3.0 );
+    file.write( reinterpret_cast< const char * >( &value ), sizeof( PixelType ) );
+  }
+
+} // end WritePixels()
+
+
+// Write a .mha file whose pixel data start at an aligned or unaligned offset
+std::string
+WriteMHA( const std::string & directory, bool aligned )
+{
+  for( unsigned int decimals = 1; decimals <= sizeof( PixelType ); ++decimals )
+  {
+    const std::string header = CreateHeader( decimals, "LOCAL", "" );
+    if( ( header.size() % sizeof( PixelType ) == 0 ) == aligned )
+    {
+      const std::string fileName = directory + "/MemoryMappedImageReaderTest_"
+        + ( aligned ? "aligned" : "unaligned" ) + ".mha";
+      std::ofstream file( fileName.c_str(), std::ios::out | std::ios::binary );
+      file << header;
+      WritePixels( file, 0 );
+      return fileName;
+    }
+  }
+  return "";
+
+} // end WriteMHA()
+
+
+// Write a .mhd/.raw pair, of which the .raw file starts with numberOfPaddingBytes
+std::string
+WriteMHD( const std::string & directory, const std::string & name,
+  const std::string & headerSize, unsigned int numberOfPaddingBytes )
+{
+  const std::string baseName = "MemoryMappedImageReaderTest_" + name;
+  const std::string fileName = directory + "/" + baseName + ".mhd";
+  std::ofstream     headerFile( fileName.c_str(), std::ios::out | std::ios::binary );
+  headerFile << CreateHeader( 1, baseName + ".raw", headerSize );
+
+  const std::string dataFileName = directory + "/" + baseName + ".raw";
+  std::ofstream     dataFile( dataFileName.c_str(), std::ios::out | std::ios::binary );
+  WritePixels( dataFile, numberOfPaddingBytes );
+  return fileName;
+
+} // end WriteMHD()
+
+
+// Read a file with both readers and compare the results
+bool
+TestFile( const std::string & fileName, bool expectedDataIsCopied )
+{
+  typedef itk::ImageFileReader< ImageType >          ReaderType;
+  typedef itk::MemoryMappedImageReader< ImageType >  MappedReaderType;
+  typedef itk::ImageRegionConstIterator< ImageType > IteratorType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  try
+  {
+    reader->Update();
+  }
+  catch( itk::ExceptionObject & excp )
+  {
+    std::cerr << excp << std::endl;
+    return false;
+  }
+  const ImageType * referenceImage = reader->GetOutput();
+
+  bool                dataIsCopied = !expectedDataIsCopied;
+  ImageType::Pointer  mappedImage  = MappedReaderType::Read( fileName, &dataIsCopied );
+  if( mappedImage.IsNull() )
+  {
+    std::cerr << "ERROR: " << fileName << " could not be mapped." << std::endl;
+    return false;
+  }
+  std::cout << fileName << ": " << ( dataIsCopied ? "copied" : "mapped" ) << std::endl;
+  if( dataIsCopied != expectedDataIsCopied )
+  {
+    std::cerr << "ERROR: the pixels were " << ( dataIsCopied ? "" : "not " )
+              << "copied." << std::endl;
+    return false;
+  }
+
+  if( mappedImage->GetBufferedRegion() != referenceImage->GetBufferedRegion()
+    || mappedImage->GetSpacing() != referenceImage->GetSpacing()
+    || mappedImage->GetOrigin() != referenceImage->GetOrigin()
+    || mappedImage->GetDirection() != referenceImage->GetDirection() )
+  {
+    std::cerr << "ERROR: the geometry differs from that of the ImageFileReader." << std::endl;
+    return false;
+  }
+
+  IteratorType mit( mappedImage, mappedImage->GetBufferedRegion() );
+  IteratorType rit( referenceImage, referenceImage->GetBufferedRegion() );
+  for( mit.GoToBegin(), rit.GoToBegin(); !mit.IsAtEnd(); ++mit, ++rit )
+  {
+    if( mit.Get() != rit.Get() )
+    {
+      std::cerr << "ERROR: the pixels differ from those of the ImageFileReader." << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+
+} // end TestFile()
+
+
+//-------------------------------------------------------------------------------------
+
+int
+main( int argc, char * argv[] )
+{
+  /** Check. */
+  if( argc != 2 )
+  {
+    std::cerr << "ERROR: You should specify an output directory." << std::endl;
+    return 1;
+  }
+  const std::string directory = argv[ 1 ];
+
+  /** The pixel data of a .mha file follow the text header, so they are only
+   * mapped without a copy if the header length is a multiple of the pixel
+   * size. The data of a .raw file start at HeaderSize, or at the end of the
+   * file minus the data length if HeaderSize is -1.
+   */
+  if( !TestFile( WriteMHA( directory, true ), false )
+    || !TestFile( WriteMHA( directory, false ), true )
+    || !TestFile( WriteMHD( directory, "noheader", "", 0 ), false )
+    || !TestFile( WriteMHD( directory, "header8", "8", 8 ), false )
+    || !TestFile( WriteMHD( directory, "header6", "6", 6 ), true )
+    || !TestFile( WriteMHD( directory, "headerauto", "-1", 12 ), false ) )
+  {
+    return 1;
+  }
+
+  /** A file of another pixel type cannot be mapped. */
+  typedef itk::Image< short, Dimension > ShortImageType;
+  if( itk::MemoryMappedImageReader< ShortImageType >::Read(
+    WriteMHD( directory, "noheader", "", 0 ) ).IsNotNull() )
+  {
+    std::cerr << "ERROR: a float image was mapped as a short image." << std::endl;
+    return 1;
+  }
+
+  return 0;
+
+} // end main
@@ -0,0 +1,231 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+/** \file
+ \brief Compare the multi-order B-spline decomposition with the ITK
+ B-spline decomposition, for spline orders 2 to 5, in 2D and 3D, for
+ float and double images.
+ */
+
+#include "itkMultiOrderBSplineDecompositionImageFilter.h"
+#include "itkBSplineDecompositionImageFilter.h"
+
+#include "itkImage.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "vnl/vnl_math.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+//-------------------------------------------------------------------------------------
+
+// Decompose a buffer of the given size with the ITK filter.
+template< unsigned int Dimension, class TPixel >
+bool
+DecomposeWithITK( const TPixel * input, const unsigned long * size,
+  unsigned int splineOrder, TPixel * output )
+{
+  typedef itk::Image< TPixel, Dimension >                     ImageType;
+  typedef itk::BSplineDecompositionImageFilter<
+    ImageType, ImageType >                                    DecompositionFilterType;
+
+  typename ImageType::SizeType imageSize;
+  for( unsigned int i = 0; i < Dimension; ++i )
+  {
+    imageSize[ i ] = size[ i ];
+  }
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions( imageSize );
+  image->Allocate();
+  const unsigned long numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  std::copy( input, input + numberOfPixels, image->GetBufferPointer() );
+
+  typename DecompositionFilterType::Pointer filter = DecompositionFilterType::New();
+  filter->SetSplineOrder( splineOrder );
+  filter->SetInput( image );
+  try
+  {
+    filter->Update();
+  }
+  catch( itk::ExceptionObject & excp )
+  {
+    std::cerr << excp << std::endl;
+    return false;
+  }
+
+  const TPixel * result = filter->GetOutput()->GetBufferPointer();
+  std::copy( result, result + numberOfPixels, output );
+  return true;
+
+} // end DecomposeWithITK()
+
+
+//-------------------------------------------------------------------------------------
+
+// Test function templated over the dimension and the pixel type
+template< unsigned int Dimension, class TPixel >
+bool
+TestMultiOrderBSplineDecomposition( const unsigned long * size,
+  unsigned int splineOrder, bool zeroOrderLastDimension, double tolerance )
+{
+  typedef itk::Image< TPixel, Dimension >                       ImageType;
+  typedef itk::MultiOrderBSplineDecompositionImageFilter<
+    ImageType, ImageType >                                      DecompositionFilterType;
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator RandomGeneratorType;
+
+  /** Create an image of random values, which do not hide errors at the
+   * borders or between blocks of lines the way a smooth image would.
+   */
+  typename ImageType::SizeType imageSize;
+  for( unsigned int i = 0; i < Dimension; ++i )
+  {
+    imageSize[ i ] = size[ i ];
+  }
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions( imageSize );
+  image->Allocate();
+  const unsigned long numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+
+  RandomGeneratorType::Pointer randomGenerator = RandomGeneratorType::GetInstance();
+  randomGenerator->Initialize( 5489 );
+  TPixel * buffer = image->GetBufferPointer();
+  for( unsigned long i = 0; i < numberOfPixels; ++i )
+  {
+    buffer[ i ] = static_cast< TPixel >( randomGenerator->GetUniformVariate( -100.0, 100.0 ) );
+  }
+
+  /** Decompose with the multi-order filter. The order is set before the input. */
+  typename DecompositionFilterType::Pointer filter = DecompositionFilterType::New();
+  filter->SetSplineOrder( splineOrder );
+  if( zeroOrderLastDimension )
+  {
+    filter->SetSplineOrder( Dimension - 1, 0 );
+  }
+  filter->SetInput( image );
+  try
+  {
+    filter->Update();
+  }
+  catch( itk::ExceptionObject & excp )
+  {
+    std::cerr << excp << std::endl;
+    return false;
+  }
+  const TPixel * result = filter->GetOutput()->GetBufferPointer();
+
+  /** Decompose with ITK. With a zero order in the last dimension, each
+   * slice is decomposed separately in the remaining dimensions.
+   */
+  std::vector< TPixel > reference( numberOfPixels );
+  if( zeroOrderLastDimension )
+  {
+    const unsigned long numberOfSlices = size[ Dimension - 1 ];
+    const unsigned long sliceSize      = numberOfPixels / numberOfSlices;
+    for( unsigned long s = 0; s < numberOfSlices; ++s )
+    {
+      if( !DecomposeWithITK< Dimension - 1, TPixel >( buffer + s * sliceSize,
+        size, splineOrder, &reference[ s * sliceSize ] ) )
+      {
+        return false;
+      }
+    }
+  }
+  else if( !DecomposeWithITK< Dimension, TPixel >( buffer, size, splineOrder, &reference[ 0 ] ) )
+  {
+    return false;
+  }
+
+  /** Compare, relative to the size of the coefficients. */
+  double maximumDifference = 0.0;
+  for( unsigned long i = 0; i < numberOfPixels; ++i )
+  {
+    const double difference = vcl_abs( static_cast< double >( result[ i ] )
+      - static_cast< double >( reference[ i ] ) );
+    maximumDifference = vnl_math_max( maximumDifference,
+      difference / vnl_math_max( 1.0, static_cast< double >( vcl_abs( reference[ i ] ) ) ) );
+  }
+
+  std::cout << Dimension << "D, size " << size[ 0 ];
+  for( unsigned int i = 1; i < Dimension; ++i )
+  {
+    std::cout << "x" << size[ i ];
+  }
+  std::cout << ", " << ( sizeof( TPixel ) == sizeof( float ) ? "float" : "double" )
+            << ", order " << splineOrder << ( zeroOrderLastDimension ? " (0 in last dimension)" : "" )
+            << ": maximum relative difference = " << maximumDifference << std::endl;
+  if( maximumDifference > tolerance )
+  {
+    std::cerr << "ERROR: the multi-order decomposition differs from the ITK "
+              << "decomposition by more than " << tolerance << std::endl;
+    return false;
+  }
+
+  return true;
+
+} // end TestMultiOrderBSplineDecomposition()
+
+
+//-------------------------------------------------------------------------------------
+
+// Run all spline orders, with and without a zero order in the last dimension
+template< unsigned int Dimension, class TPixel >
+bool
+TestAllOrders( const unsigned long * size, double tolerance )
+{
+  for( unsigned int splineOrder = 2; splineOrder <= 5; ++splineOrder )
+  {
+    if( !TestMultiOrderBSplineDecomposition< Dimension, TPixel >( size, splineOrder, false, tolerance )
+      || !TestMultiOrderBSplineDecomposition< Dimension, TPixel >( size, splineOrder, true, tolerance ) )
+    {
+      return false;
+    }
+  }
+  return true;
+
+} // end TestAllOrders()
+
+
+//-------------------------------------------------------------------------------------
+
+int
+main( void )
+{
+  /** Odd sizes, so that the strides are not a multiple of the block of
+   * 16 lines that the filter processes together, and the last block of
+   * each dimension is incomplete.
+   */
+  const unsigned long size2D[ 2 ] = { 17, 13 };
+  const unsigned long size3D[ 3 ] = { 19, 13, 11 };
+
+  /** The multi-order filter works in place in the output pixel type, while
+   * ITK filters each line in double precision, so float results differ by
+   * rounding only.
+   */
+  const double floatTolerance  = 1e-4;
+  const double doubleTolerance = 1e-10;
+
+  if( !TestAllOrders< 2, float >( size2D, floatTolerance )
+    || !TestAllOrders< 2, double >( size2D, doubleTolerance )
+    || !TestAllOrders< 3, float >( size3D, floatTolerance )
+    || !TestAllOrders< 3, double >( size3D, doubleTolerance ) )
+  {
+    return 1;
+  }
+
+  return 0;
+
+} // end main
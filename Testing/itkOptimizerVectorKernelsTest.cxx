@@ -0,0 +1,216 @@
+/*=========================================================================
+ *
+ *  Copyright UMC Utrecht and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkOptimizerVectorKernels.h"
+
+#include "vnl/vnl_math.h"
+#include <iostream>
+
+//-------------------------------------------------------------------------------------
+
+/** Compare a computed value with the expected value, relative to the
+ * magnitude of the expected value.
+ */
+bool
+IsClose( const double computed, const double expected, const double tolerance )
+{
+  const double scale = vnl_math_max( 1.0, vcl_abs( expected ) );
+  return vcl_abs( computed - expected ) <= tolerance * scale;
+}
+
+
+/** Compare two vectors element-wise. */
+bool
+AreClose( const itk::Array< double > & computed,
+  const itk::Array< double > & expected, const double tolerance )
+{
+  for( unsigned int i = 0; i < expected.GetSize(); ++i )
+  {
+    if( !IsClose( computed[ i ], expected[ i ], tolerance ) )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/** Test all kernels for vectors of length n against plain loops. */
+bool
+TestKernels( const unsigned int n )
+{
+  typedef itk::OptimizerVectorKernels Kernels;
+  typedef Kernels::VectorType         VectorType;
+
+  /** Deterministic test vectors. */
+  VectorType x( n ), y( n ), z( n ), f( n );
+  for( unsigned int i = 0; i < n; ++i )
+  {
+    x[ i ] = vcl_sin( 0.01 * i );
+    y[ i ] = vcl_cos( 0.02 * i ) - 0.5;
+    z[ i ] = 1.0 / ( 1.0 + i % 17 );
+    f[ i ] = 0.5 + ( i % 5 ) * 0.25;
+  }
+  const double a = 0.75;
+  const double b = -1.25;
+
+  /** Reductions: the summation order may differ when threaded. */
+  const double reductionTolerance = 1e-10;
+  const double elementTolerance   = 1e-14;
+
+  double expectedInnerProduct     = 0.0;
+  double expectedSquaredMagnitude = 0.0;
+  for( unsigned int i = 0; i < n; ++i )
+  {
+    expectedInnerProduct     += x[ i ] * y[ i ];
+    expectedSquaredMagnitude += x[ i ] * x[ i ];
+  }
+  if( !IsClose( Kernels::InnerProduct( x, y ), expectedInnerProduct, reductionTolerance )
+    || !IsClose( Kernels::SquaredMagnitude( x ), expectedSquaredMagnitude, reductionTolerance )
+    || !IsClose( Kernels::Magnitude( x ), vcl_sqrt( expectedSquaredMagnitude ), reductionTolerance ) )
+  {
+    std::cerr << "ERROR: InnerProduct(), SquaredMagnitude() or Magnitude() "
+              << "returns an incorrect result for n = " << n << std::endl;
+    return false;
+  }
+
+  /** y = a x + y. */
+  VectorType expected( n ), computed( y );
+  for( unsigned int i = 0; i < n; ++i )
+  {
+    expected[ i ] = a * x[ i ] + y[ i ];
+  }
+  Kernels::Axpy( a, x, computed );
+  if( !AreClose( computed, expected, elementTolerance ) )
+  {
+    std::cerr << "ERROR: Axpy() returns an incorrect result for n = " << n << std::endl;
+    return false;
+  }
+
+  /** y = a x + y and z^T y, in a single pass. */
+  computed = y;
+  double expectedAxpyInnerProduct = 0.0;
+  for( unsigned int i = 0; i < n; ++i )
+  {
+    expectedAxpyInnerProduct += z[ i ] * expected[ i ];
+  }
+  const double axpyInnerProduct = Kernels::AxpyAndInnerProduct(
+    a, x.data_block(), computed.data_block(), z.data_block(), n );
+  if( !AreClose( computed, expected, elementTolerance )
+    || !IsClose( axpyInnerProduct, expectedAxpyInnerProduct, reductionTolerance ) )
+  {
+    std::cerr << "ERROR: AxpyAndInnerProduct() returns an incorrect result for n = "
+              << n << std::endl;
+    return false;
+  }
+
+  /** y = a x + b y. */
+  computed = y;
+  for( unsigned int i = 0; i < n; ++i )
+  {
+    expected[ i ] = a * x[ i ] + b * y[ i ];
+  }
+  Kernels::Axpby( a, x, b, computed );
+  if( !AreClose( computed, expected, elementTolerance ) )
+  {
+    std::cerr << "ERROR: Axpby() returns an incorrect result for n = " << n << std::endl;
+    return false;
+  }
+
+  /** z = x + a d, also with the output aliasing the input. */
+  for( unsigned int i = 0; i < n; ++i )
+  {
+    expected[ i ] = x[ i ] + a * y[ i ];
+  }
+  Kernels::ScaledUpdate( x, a, y, computed );
+  VectorType aliased( x );
+  Kernels::ScaledUpdate( aliased, a, y, aliased );
+  if( !AreClose( computed, expected, elementTolerance )
+    || !AreClose( aliased, expected, elementTolerance ) )
+  {
+    std::cerr << "ERROR: ScaledUpdate() returns an incorrect result for n = " << n << std::endl;
+    return false;
+  }
+
+  /** z = x + d .* f. */
+  for( unsigned int i = 0; i < n; ++i )
+  {
+    expected[ i ] = x[ i ] + y[ i ] * f[ i ];
+  }
+  Kernels::ElementWiseUpdate( x, y, f, computed );
+  if( !AreClose( computed, expected, elementTolerance ) )
+  {
+    std::cerr << "ERROR: ElementWiseUpdate() returns an incorrect result for n = " << n << std::endl;
+    return false;
+  }
+
+  /** y = x .* y. */
+  computed = y;
+  for( unsigned int i = 0; i < n; ++i )
+  {
+    expected[ i ] = x[ i ] * y[ i ];
+  }
+  Kernels::ElementWiseMultiply( x, computed );
+  if( !AreClose( computed, expected, elementTolerance ) )
+  {
+    std::cerr << "ERROR: ElementWiseMultiply() returns an incorrect result for n = " << n << std::endl;
+    return false;
+  }
+
+  /** x = a x, and z = a x. */
+  computed = x;
+  for( unsigned int i = 0; i < n; ++i )
+  {
+    expected[ i ] = a * x[ i ];
+  }
+  Kernels::Scale( a, computed );
+  VectorType scaled( n );
+  Kernels::Scale( a, x.data_block(), scaled.data_block(), n );
+  if( !AreClose( computed, expected, elementTolerance )
+    || !AreClose( scaled, expected, elementTolerance ) )
+  {
+    std::cerr << "ERROR: Scale() returns an incorrect result for n = " << n << std::endl;
+    return false;
+  }
+
+  return true;
+
+} // end TestKernels()
+
+
+//-------------------------------------------------------------------------------------
+
+int
+main( void )
+{
+  /** Test sizes below and above the size at which OpenMP is used, and an
+   * odd size that does not split evenly over the threads.
+   */
+  const unsigned int threshold = 2 * itk::OptimizerVectorKernels::MinimumNumberOfElementsPerThread;
+  const unsigned int sizes[]   = { 0, 1, 1000, threshold - 1, threshold, 4 * threshold + 13 };
+  for( unsigned int i = 0; i < sizeof( sizes ) / sizeof( sizes[ 0 ] ); ++i )
+  {
+    if( !TestKernels( sizes[ i ] ) )
+    {
+      return 1;
+    }
+  }
+
+  /** Return a value. */
+  return 0;
+
+} // end main